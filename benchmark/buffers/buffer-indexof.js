@@ -15,16 +15,18 @@ const searchStrings = [
   'aaaaaaaaaaaaaaaaa',
   'venture to go near the house till she had brought herself down to',
   '</i> to the Caterpillar',
+  '\r\n------WebKitFormBoundary7MA4YWxkTrZu0gW',
 ];
 
 const bench = common.createBenchmark(main, {
   search: searchStrings,
   encoding: ['utf8', 'ucs2'],
   type: ['buffer', 'string'],
+  method: ['indexOf', 'lastIndexOf', 'includes'],
   n: [5e4]
 });
 
-function main({ n, search, encoding, type }) {
+function main({ n, search, encoding, type, method }) {
   let aliceBuffer = fs.readFileSync(
     path.resolve(__dirname, '../fixtures/alice.html')
   );
@@ -41,9 +43,12 @@ function main({ n, search, encoding, type }) {
     search = Buffer.from(Buffer.from(search).toString(), encoding);
   }
 
+  const fn = aliceBuffer[method];
+  const offset = method === 'lastIndexOf' ? aliceBuffer.length : 0;
+
   bench.start();
   for (let i = 0; i < n; i++) {
-    aliceBuffer.indexOf(search, 0, encoding);
+    fn.call(aliceBuffer, search, offset, encoding);
   }
   bench.end(n);
 }
@@ -0,0 +1,58 @@
+'use strict';
+
+const common = require('../common.js');
+const {
+  aeadEncryptBatch,
+  createCipheriv,
+  randomBytes,
+} = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  api: ['createCipheriv', 'aeadEncryptBatch'],
+  algo: ['aes-256-gcm', 'chacha20-poly1305'],
+  len: [64, 1024],
+  batch: [1000],
+  n: [100],
+});
+
+function main({ api, algo, len, batch, n }) {
+  const key = randomBytes(32);
+  const messages = [];
+  for (let i = 0; i < batch; i++) {
+    messages.push({
+      iv: randomBytes(12),
+      aad: Buffer.alloc(16, i),
+      plaintext: Buffer.alloc(len, i),
+    });
+  }
+
+  switch (api) {
+    case 'createCipheriv':
+      bench.start();
+      for (let i = 0; i < n; i++) {
+        for (const { iv, aad, plaintext } of messages) {
+          const cipher = createCipheriv(algo, key, iv, { authTagLength: 16 });
+          cipher.setAAD(aad);
+          cipher.update(plaintext);
+          cipher.final();
+          cipher.getAuthTag();
+        }
+      }
+      bench.end(n * batch);
+      break;
+    case 'aeadEncryptBatch': {
+      const output = Buffer.alloc(batch * (len + 16));
+      let remaining = n;
+      bench.start();
+      (function next() {
+        if (remaining-- === 0)
+          return bench.end(n * batch);
+        aeadEncryptBatch(algo, key, messages, output, (err) => {
+          if (err) throw err;
+          next();
+        });
+      })();
+      break;
+    }
+  }
+}
@@ -0,0 +1,58 @@
+// Compare hashing many small inputs one by one with hashing them in batches.
+'use strict';
+
+const common = require('../common.js');
+const {
+  createHash,
+  createHmac,
+  hashBatch,
+  hashBatchSync,
+} = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  api: ['createHash', 'hashBatchSync', 'hashBatch'],
+  hmac: ['false', 'true'],
+  len: [64, 1024],
+  batch: [1000],
+  algo: ['sha1', 'sha256'],
+  n: [100],
+});
+
+function main({ api, hmac, len, batch, algo, n }) {
+  const inputs = [];
+  for (let i = 0; i < batch; i++)
+    inputs.push(Buffer.alloc(len, i));
+  const options = hmac === 'true' ? { key: 'secret' } : {};
+
+  switch (api) {
+    case 'createHash':
+      bench.start();
+      for (let i = 0; i < n; i++) {
+        for (const input of inputs) {
+          const hash = options.key ?
+            createHmac(algo, options.key) : createHash(algo);
+          hash.update(input).digest();
+        }
+      }
+      bench.end(n * batch);
+      break;
+    case 'hashBatchSync':
+      bench.start();
+      for (let i = 0; i < n; i++)
+        hashBatchSync(algo, inputs, options);
+      bench.end(n * batch);
+      break;
+    case 'hashBatch': {
+      let done = 0;
+      bench.start();
+      for (let i = 0; i < n; i++) {
+        hashBatch(algo, inputs, options, (err) => {
+          if (err) throw err;
+          if (++done === n)
+            bench.end(n * batch);
+        });
+      }
+      break;
+    }
+  }
+}
@@ -0,0 +1,70 @@
+// Test UDP send/recv throughput of socket.sendBatch() and the recvBatch
+// socket option against one send() call and 'message' event per datagram.
+'use strict';
+
+const common = require('../common.js');
+const dgram = require('dgram');
+const PORT = common.PORT;
+
+// `num` is the number of datagrams to queue up each time.
+const bench = common.createBenchmark(main, {
+  len: [64, 512],
+  num: [100],
+  mode: ['single', 'batch'],
+  type: ['send', 'recv'],
+  dur: [5]
+});
+
+function main({ dur, len, num, mode, type }) {
+  const chunk = Buffer.allocUnsafe(len);
+  const chunks = new Array(num).fill(chunk);
+  const batch = mode === 'batch';
+  let sent = 0;
+  let received = 0;
+  const socket = dgram.createSocket({ type: 'udp4', recvBatch: batch });
+
+  function onsendBatch() {
+    sent += num;
+    // The setImmediate() is necessary to have event loop progress on OSes
+    // that only perform synchronous I/O on nonblocking UDP sockets.
+    setImmediate(() => {
+      socket.sendBatch(chunks, PORT, '127.0.0.1', onsendBatch);
+    });
+  }
+
+  function onsend() {
+    if (sent++ % num === 0) {
+      setImmediate(() => {
+        for (let i = 0; i < num; i++) {
+          socket.send(chunk, PORT, '127.0.0.1', onsend);
+        }
+      });
+    }
+  }
+
+  socket.on('listening', () => {
+    bench.start();
+    if (batch) {
+      socket.sendBatch(chunks, PORT, '127.0.0.1', onsendBatch);
+    } else {
+      onsend();
+    }
+
+    setTimeout(() => {
+      const bytes = (type === 'send' ? sent : received) * chunk.length;
+      const gbits = (bytes * 8) / (1024 * 1024 * 1024);
+      bench.end(gbits);
+      process.exit(0);
+    }, dur * 1000);
+  });
+
+  socket.on('message', () => {
+    received++;
+  });
+
+  socket.on('messages', (msgs) => {
+    received += msgs.length;
+  });
+
+  socket.bind(PORT);
+}
@@ -0,0 +1,81 @@
+// Compare libuv's io_uring backend for file system requests with the
+// thread pool it falls back to.
+'use strict';
+
+const path = require('path');
+const common = require('../common.js');
+const fs = require('fs');
+
+const tmpdir = require('../../test/common/tmpdir');
+tmpdir.refresh();
+const filename = path.resolve(tmpdir.path,
+                              `.removeme-benchmark-garbage-${process.pid}`);
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  backend: ['threadpool', 'io_uring'],
+  op: ['open-close', 'stat', 'fstat', 'read', 'write'],
+  len: [4096],
+  concurrent: [1, 32]
+});
+
+function main({ n, backend, op, len, concurrent }) {
+  // libuv sets up the ring on the first asynchronous request, so this has to
+  // happen before anything below touches the file system asynchronously.
+  process.env.UV_USE_IO_URING = backend === 'io_uring' ? '1' : '0';
+
+  fs.writeFileSync(filename, Buffer.alloc(len, 'x'));
+  const fd = fs.openSync(filename, 'r+');
+  const buffers = [];
+  for (let i = 0; i < concurrent; i++)
+    buffers.push(Buffer.alloc(len, 'y'));
+
+  let started = 0;
+  let done = 0;
+
+  function afterOp(err) {
+    if (err)
+      throw err;
+    if (++done === n) {
+      bench.end(n);
+      fs.closeSync(fd);
+      try { fs.unlinkSync(filename); } catch {}
+      return;
+    }
+    if (started < n)
+      start(this);
+  }
+
+  function afterOpen(err, fd) {
+    if (err)
+      throw err;
+    fs.close(fd, afterOp.bind(this));
+  }
+
+  function start(buffer) {
+    started++;
+    switch (op) {
+      case 'open-close':
+        fs.open(filename, 'r', afterOpen.bind(buffer));
+        break;
+      case 'stat':
+        fs.stat(filename, afterOp.bind(buffer));
+        break;
+      case 'fstat':
+        fs.fstat(fd, afterOp.bind(buffer));
+        break;
+      case 'read':
+        fs.read(fd, buffer, 0, len, 0, afterOp.bind(buffer));
+        break;
+      case 'write':
+        fs.write(fd, buffer, 0, len, 0, afterOp.bind(buffer));
+        break;
+      default:
+        throw new Error(`Unexpected op: ${op}`);
+    }
+  }
+
+  bench.start();
+  for (let i = 0; i < Math.min(concurrent, n); i++)
+    start(buffers[i]);
+}
@@ -0,0 +1,48 @@
+// Test the throughput of piping an fs.ReadStream into a TCP socket, with the
+// native file-to-socket path and with the data going through JS.
+'use strict';
+
+const path = require('path');
+const common = require('../common.js');
+const fs = require('fs');
+const net = require('net');
+
+const tmpdir = require('../../test/common/tmpdir');
+tmpdir.refresh();
+const filename = path.resolve(tmpdir.path,
+                              `.removeme-benchmark-garbage-${process.pid}`);
+
+const bench = common.createBenchmark(main, {
+  mode: ['native', 'js'],
+  filesize: [64 * 1024, 16 * 1024 * 1024],
+  n: [100]
+});
+
+function main({ mode, filesize, n }) {
+  fs.writeFileSync(filename, Buffer.alloc(filesize, 'x'));
+  // A custom `fs` makes the stream ineligible for the native path.
+  const options = mode === 'js' ? { fs: { ...fs } } : undefined;
+
+  const server = net.createServer((socket) => {
+    fs.createReadStream(filename, options).pipe(socket);
+  });
+
+  server.listen(0, () => {
+    let done = 0;
+    bench.start();
+    (function next() {
+      let received = 0;
+      const client = net.connect(server.address().port);
+      client.on('data', (chunk) => { received += chunk.length; });
+      client.on('end', () => {
+        if (received !== filesize)
+          throw new Error(`Expected ${filesize} bytes, got ${received}`);
+        if (++done < n)
+          return next();
+        bench.end(n * filesize / (1024 * 1024));
+        server.close();
+        try { fs.unlinkSync(filename); } catch {}
+      });
+    })();
+  });
+}
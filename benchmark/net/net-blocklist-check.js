@@ -0,0 +1,59 @@
+// Lookups in a net.BlockList with many address, subnet and range rules.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  rules: [10, 1e3, 1e5],
+  type: ['address', 'subnet', 'range'],
+  family: ['ipv4', 'ipv6'],
+}, {
+  test: { rules: 10 }
+});
+
+function ipv4(i) {
+  return `10.${(i >>> 16) & 255}.${(i >>> 8) & 255}.${i & 255}`;
+}
+
+function ipv6(i) {
+  return `2001:db8:${(i >>> 16).toString(16)}:${(i & 0xffff).toString(16)}::`;
+}
+
+function main({ n, rules, type, family }) {
+  const address = family === 'ipv4' ? ipv4 : ipv6;
+  const blockList = new net.BlockList();
+
+  // Leave every other slot free so that about half of the checks miss.
+  for (let i = 0; i < rules; i++) {
+    const start = address(i * 2);
+    switch (type) {
+      case 'address':
+        blockList.addAddress(start, family);
+        break;
+      case 'subnet':
+        blockList.addSubnet(start, family === 'ipv4' ? 32 : 64, family);
+        break;
+      case 'range':
+        blockList.addRange(start, start, family);
+        break;
+    }
+  }
+
+  const checks = [];
+  for (let i = 0; i < 1024; i++)
+    checks.push(address((i * 7919) % (rules * 2)));
+  // The first check after a change sorts the ranges.
+  blockList.check(checks[0], family);
+
+  let blocked = 0;
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    if (blockList.check(checks[i & 1023], family))
+      blocked++;
+  }
+  bench.end(n);
+  if (blocked === 0)
+    throw new Error('Nothing was blocked');
+}
@@ -0,0 +1,57 @@
+// Pipelined request/response traffic where the server answers every request
+// with its own socket.write(), with and without write coalescing.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+const PORT = common.PORT;
+
+const bench = common.createBenchmark(main, {
+  coalesce: ['true', 'false'],
+  pipeline: [1, 16, 128],
+  len: [16, 256],
+  dur: [5],
+}, {
+  test: { pipeline: 4 }
+});
+
+function main({ dur, coalesce, pipeline, len }) {
+  const request = Buffer.alloc(len * pipeline, 'r');
+  const reply = Buffer.alloc(len, 'x');
+
+  const server = net.createServer((socket) => {
+    socket.setWriteCoalescing(coalesce === 'true');
+    let pending = 0;
+    socket.on('data', (data) => {
+      pending += data.length;
+      for (; pending >= len; pending -= len)
+        socket.write(reply);
+    });
+  });
+
+  server.listen(PORT, () => {
+    const socket = net.connect(PORT);
+    let received = 0;
+    let replies = 0;
+
+    socket.on('connect', () => {
+      bench.start();
+      socket.write(request);
+
+      setTimeout(() => {
+        // Each reply is a separate write on the server side.
+        bench.end(replies);
+        socket.destroy();
+        server.close();
+      }, dur * 1000);
+    });
+
+    socket.on('data', (data) => {
+      received += data.length;
+      for (; received >= len; received -= len) {
+        if (++replies % pipeline === 0)
+          socket.write(request);
+      }
+    });
+  });
+}
@@ -0,0 +1,36 @@
+'use strict';
+// Decoding of text whose multi-byte characters are split across chunks.
+const common = require('../common.js');
+const StringDecoder = require('string_decoder').StringDecoder;
+
+const bench = common.createBenchmark(main, {
+  encoding: ['utf8', 'utf16le', 'base64'],
+  text: ['ascii', 'latin1', 'cjk', 'emoji'],
+  chunkLen: [7, 61, 1021],
+  n: [1e5]
+});
+
+const TEXTS = {
+  ascii: 'Blueberry jam and toast. ',
+  latin1: 'Blåbærsyltetøy på ristet brød. ',
+  cjk: '蓝莓果酱和吐司。ブルーベリージャム。',
+  emoji: 'jam 🫐🍞 toast 😋 ',
+};
+
+function main({ encoding, text, chunkLen, n }) {
+  const input = Buffer.from(TEXTS[text].repeat(200),
+                            encoding === 'utf16le' ? encoding : 'utf8');
+  const chunks = [];
+  for (let i = 0; i < input.length; i += chunkLen)
+    chunks.push(input.slice(i, i + chunkLen));
+
+  const sd = new StringDecoder(encoding);
+
+  bench.start();
+  for (let i = 0; i < n; ++i) {
+    for (let j = 0; j < chunks.length; ++j)
+      sd.write(chunks[j]);
+    sd.end();
+  }
+  bench.end(n);
+}
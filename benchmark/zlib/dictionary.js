@@ -0,0 +1,28 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  dictionary: ['none', 'plain', 'prepared'],
+  dictLen: [32 * 1024],
+  n: [2e4]
+});
+
+function main({ n, dictionary, dictLen }) {
+  const fields = [];
+  for (let i = 0; fields.join(',').length < dictLen; i++)
+    fields.push(`"field${i}":"value${i}"`);
+  const plain = Buffer.from(`{${fields.join(',')}}`).slice(0, dictLen);
+  const message = Buffer.from(`{${fields.slice(0, 20).join(',')}}`);
+
+  const options = {};
+  if (dictionary === 'plain')
+    options.dictionary = plain;
+  else if (dictionary === 'prepared')
+    options.dictionary = zlib.prepareDictionary(plain);
+
+  bench.start();
+  for (let i = 0; i < n; i++)
+    zlib.deflateSync(message, options);
+  bench.end(n);
+}
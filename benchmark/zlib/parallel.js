@@ -0,0 +1,60 @@
+// Throughput of compressing large inputs with the `parallelism` option.
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['gzip', 'gzipSync', 'deflateRawSync', 'brotliCompress'],
+  parallelism: [1, 2, 4, 8],
+  inputLen: [8 * 1024 * 1024],
+  n: [4]
+});
+
+// Text-like input that compresses to roughly a third of its size.
+function makeInput(len) {
+  const words = ['lorem', 'ipsum', 'dolor', 'sit', 'amet', 'consectetur',
+                 'adipiscing', 'elit', 'sed', 'do', 'eiusmod', 'tempor'];
+  const parts = [];
+  let size = 0;
+  let seed = 1;
+  while (size < len) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    const part = seed % 7 === 0 ?
+      `${seed.toString(36)}\n` : `${words[seed % words.length]} `;
+    parts.push(part);
+    size += part.length;
+  }
+  return Buffer.from(parts.join('')).slice(0, len);
+}
+
+function main({ method, parallelism, inputLen, n }) {
+  const input = makeInput(inputLen);
+  const options = { parallelism };
+  if (method === 'brotliCompress') {
+    options.params = {
+      [zlib.constants.BROTLI_PARAM_QUALITY]: zlib.constants.BROTLI_MAX_QUALITY,
+      [zlib.constants.BROTLI_PARAM_SIZE_HINT]: inputLen
+    };
+  }
+  // Reported in MiB of input per second.
+  const mib = n * inputLen / (1024 * 1024);
+
+  if (method.endsWith('Sync')) {
+    const fn = zlib[method];
+    bench.start();
+    for (let i = 0; i < n; i++)
+      fn(input, options);
+    bench.end(mib);
+    return;
+  }
+
+  const fn = zlib[method];
+  let i = 0;
+  bench.start();
+  (function next(err) {
+    if (err) throw err;
+    if (i++ === n)
+      return bench.end(mib);
+    fn(input, options, next);
+  })();
+}
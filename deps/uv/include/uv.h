@@ -697,6 +697,12 @@ UV_EXTERN int uv_udp_try_send(uv_udp_t* handle,
                               const uv_buf_t bufs[],
                               unsigned int nbufs,
                               const struct sockaddr* addr);
+UV_EXTERN int uv_udp_try_send2(uv_udp_t* handle,
+                               unsigned int count,
+                               uv_buf_t* bufs[/*count*/],
+                               unsigned int nbufs[/*count*/],
+                               struct sockaddr* addrs[/*count*/],
+                               unsigned int flags);
 UV_EXTERN int uv_udp_recv_start(uv_udp_t* handle,
                                 uv_alloc_cb alloc_cb,
                                 uv_udp_recv_cb recv_cb);
@@ -1078,6 +1084,26 @@ UV_EXTERN int uv_queue_work(uv_loop_t* loop,
 
 UV_EXTERN int uv_cancel(uv_req_t* req);
 
+typedef struct {
+  uint64_t queued;     /* requests waiting for a thread */
+  uint64_t running;    /* requests being run */
+  uint64_t completed;  /* requests that finished running */
+  uint64_t wait_time;  /* total time requests spent waiting, in ns */
+  uint64_t run_time;   /* total time spent running requests, in ns */
+} uv_threadpool_queue_stats_t;
+
+typedef struct {
+  unsigned int threads;
+  unsigned int idle_threads;
+  unsigned int min_threads;
+  unsigned int max_threads;
+  uv_threadpool_queue_stats_t cpu;      /* uv_queue_work() */
+  uv_threadpool_queue_stats_t fast_io;  /* file system requests */
+  uv_threadpool_queue_stats_t slow_io;  /* DNS lookups */
+} uv_threadpool_stats_t;
+
+UV_EXTERN int uv_threadpool_stats(uv_threadpool_stats_t* stats);
+
 
 struct uv_cpu_times_s {
   uint64_t user; /* milliseconds */
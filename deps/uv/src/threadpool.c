@@ -29,20 +29,50 @@
 
 #define MAX_THREADPOOL_SIZE 1024
 
+/* How long a thread above the minimum pool size waits for work before it
+ * exits again, in nanoseconds.
+ */
+#define IDLE_THREAD_TIMEOUT ((uint64_t) 5 * 1000 * 1000 * 1000)
+
 extern void V8RecordReplayAssert(const char* format, ...);
+extern int V8RecordReplayIsRecordingOrReplaying(void);
+
+enum thread_state {
+  THREAD_UNUSED,
+  THREAD_RUNNING,
+  THREAD_EXITED  /* Returned from worker(), still needs to be joined. */
+};
+
+struct queue_stats {
+  uint64_t queued;
+  uint64_t running;
+  uint64_t completed;
+  uint64_t wait_time;
+  uint64_t run_time;
+  uint64_t last_change;  /* When `queued` last changed. */
+};
 
 static uv_once_t once = UV_ONCE_INIT;
 static uv_cond_t cond;
 static uv_mutex_t mutex;
 static unsigned int idle_threads;
-static unsigned int slow_io_work_running;
+static unsigned int wakeups;  /* Idle threads that have been signaled. */
+static unsigned int starting_threads;
 static unsigned int nthreads;
+static unsigned int min_threads;
+static unsigned int max_threads;
+static unsigned int next_kind;
+static int exiting;
+static int timed;
 static uv_thread_t* threads;
+static unsigned char* thread_states;
 static uv_thread_t default_threads[4];
-static QUEUE exit_message;
-static QUEUE wq;
-static QUEUE run_slow_work_message;
-static QUEUE slow_io_pending_wq;
+static unsigned char default_thread_states[4];
+/* One queue per enum uv__work_kind, so that a backlog of one kind of work
+ * does not hold up the others.
+ */
+static QUEUE wq[3];
+static struct queue_stats stats[3];
 
 static unsigned int slow_work_thread_threshold(void) {
   return (nthreads + 1) / 2;
@@ -53,75 +83,120 @@ static void uv__cancelled(struct uv__work* w) {
 }
 
 
+/* Adds the time spent waiting by all queued requests of a kind since the
+ * last change. Together this is the total time its requests spent waiting.
+ * `mutex` must be locked.
+ */
+static void account_wait_time(struct queue_stats* s) {
+  uint64_t now;
+
+  if (!timed)
+    return;
+
+  now = uv_hrtime();
+  s->wait_time += s->queued * (now - s->last_change);
+  s->last_change = now;
+}
+
+
+/* Picks the next work item, taking turns between the kinds of work that
+ * have some queued. Slow I/O may only occupy half of the threads, so that
+ * it cannot block the others. `mutex` must be locked.
+ */
+static QUEUE* next_work(unsigned int* kind) {
+  unsigned int i;
+  unsigned int k;
+
+  for (i = 0; i < ARRAY_SIZE(wq); i++) {
+    k = (next_kind + i) % ARRAY_SIZE(wq);
+    if (QUEUE_EMPTY(&wq[k]))
+      continue;
+    if (k == UV__WORK_SLOW_IO &&
+        stats[k].running >= slow_work_thread_threshold()) {
+      continue;
+    }
+    next_kind = (k + 1) % ARRAY_SIZE(wq);
+    *kind = k;
+    return QUEUE_HEAD(&wq[k]);
+  }
+
+  return NULL;
+}
+
+
+/* Marks the calling thread's slot as exited. `mutex` must be locked. */
+static void retire_thread(void) {
+  uv_thread_t self;
+  unsigned int i;
+
+  self = uv_thread_self();
+  for (i = 0; i < max_threads; i++) {
+    if (thread_states[i] == THREAD_RUNNING &&
+        uv_thread_equal(&threads[i], &self)) {
+      thread_states[i] = THREAD_EXITED;
+      break;
+    }
+  }
+  nthreads--;
+}
+
+
 /* To avoid deadlock with uv_cancel() it's crucial that the worker
  * never holds the global mutex and the loop-local mutex at the same time.
  */
 static void worker(void* arg) {
   struct uv__work* w;
   QUEUE* q;
-  int is_slow_work;
+  unsigned int kind;
+  uint64_t start;
+  uint64_t run_time;
+  int timed_out;
 
-  uv_sem_post((uv_sem_t*) arg);
+  if (arg != NULL)
+    uv_sem_post((uv_sem_t*) arg);
   arg = NULL;
 
   uv_mutex_lock(&mutex);
+  starting_threads--;
   for (;;) {
     /* `mutex` should always be locked at this point. */
 
-    /* Keep waiting while either no work is present or only slow I/O
-       and we're at the threshold for that. */
-    while (QUEUE_EMPTY(&wq) ||
-           (QUEUE_HEAD(&wq) == &run_slow_work_message &&
-            QUEUE_NEXT(&run_slow_work_message) == &wq &&
-            slow_io_work_running >= slow_work_thread_threshold())) {
+    /* Keep waiting while there is no work that may be run right now. Threads
+       above the minimum pool size exit once they have been idle for a while. */
+    timed_out = 0;
+    while ((q = next_work(&kind)) == NULL) {
+      if (exiting || (timed_out && nthreads > min_threads)) {
+        retire_thread();
+        uv_mutex_unlock(&mutex);
+        return;
+      }
+
       idle_threads += 1;
-      uv_cond_wait(&cond, &mutex);
+      if (nthreads > min_threads)
+        timed_out = uv_cond_timedwait(&cond, &mutex, IDLE_THREAD_TIMEOUT) ==
+                    UV_ETIMEDOUT;
+      else
+        uv_cond_wait(&cond, &mutex);
       idle_threads -= 1;
-    }
-
-    q = QUEUE_HEAD(&wq);
-    if (q == &exit_message) {
-      uv_cond_signal(&cond);
-      uv_mutex_unlock(&mutex);
-      break;
+      if (wakeups > 0)
+        wakeups--;
+      if (wakeups > idle_threads)
+        wakeups = idle_threads;
     }
 
     QUEUE_REMOVE(q);
     QUEUE_INIT(q);  /* Signal uv_cancel() that the work req is executing. */
 
-    is_slow_work = 0;
-    if (q == &run_slow_work_message) {
-      /* If we're at the slow I/O threshold, re-schedule until after all
-         other work in the queue is done. */
-      if (slow_io_work_running >= slow_work_thread_threshold()) {
-        QUEUE_INSERT_TAIL(&wq, q);
-        continue;
-      }
-
-      /* If we encountered a request to run slow I/O work but there is none
-         to run, that means it's cancelled => Start over. */
-      if (QUEUE_EMPTY(&slow_io_pending_wq))
-        continue;
-
-      is_slow_work = 1;
-      slow_io_work_running++;
-
-      q = QUEUE_HEAD(&slow_io_pending_wq);
-      QUEUE_REMOVE(q);
-      QUEUE_INIT(q);
-
-      /* If there is more slow I/O work, schedule it to be run as well. */
-      if (!QUEUE_EMPTY(&slow_io_pending_wq)) {
-        QUEUE_INSERT_TAIL(&wq, &run_slow_work_message);
-        if (idle_threads > 0)
-          uv_cond_signal(&cond);
-      }
-    }
+    account_wait_time(&stats[kind]);
+    stats[kind].queued--;
+    stats[kind].running++;
 
     uv_mutex_unlock(&mutex);
 
     w = QUEUE_DATA(q, struct uv__work, wq);
+    start = timed ? uv_hrtime() : 0;
     w->work(w);
+    run_time = timed ? uv_hrtime() - start : 0;
 
     uv_mutex_lock(&w->loop->wq_mutex);
     w->work = NULL;  /* Signal uv_cancel() that the work req is done
@@ -133,31 +208,68 @@ static void worker(void* arg) {
     /* Lock `mutex` since that is expected at the start of the next
      * iteration. */
     uv_mutex_lock(&mutex);
-    if (is_slow_work) {
-      /* `slow_io_work_running` is protected by `mutex`. */
-      slow_io_work_running--;
+    stats[kind].running--;
+    stats[kind].completed++;
+    stats[kind].run_time += run_time;
+
+    /* Slow I/O that was held back may be run by an idle thread now. */
+    if (kind == UV__WORK_SLOW_IO &&
+        !QUEUE_EMPTY(&wq[UV__WORK_SLOW_IO]) &&
+        idle_threads > wakeups) {
+      wakeups++;
+      uv_cond_signal(&cond);
     }
   }
 }
 
 
-static void post(QUEUE* q, enum uv__work_kind kind) {
-  uv_mutex_lock(&mutex);
-  if (kind == UV__WORK_SLOW_IO) {
-    /* Insert into a separate queue. */
-    QUEUE_INSERT_TAIL(&slow_io_pending_wq, q);
-    if (!QUEUE_EMPTY(&run_slow_work_message)) {
-      /* Running slow I/O tasks is already scheduled => Nothing to do here.
-         The worker that runs said other task will schedule this one as well. */
-      uv_mutex_unlock(&mutex);
-      return;
+/* Starts another worker if there is queued work that no thread is about to
+ * pick up and the pool may still grow. `mutex` must be locked, which keeps
+ * the new thread from using its slot before it is filled in.
+ */
+static void maybe_add_thread(void) {
+  uint64_t queued;
+  unsigned int i;
+
+  if (nthreads >= max_threads)
+    return;
+
+  queued = 0;
+  for (i = 0; i < ARRAY_SIZE(stats); i++)
+    queued += stats[i].queued;
+  if (queued <= wakeups + starting_threads)
+    return;
+
+  for (i = 0; i < max_threads; i++) {
+    if (thread_states[i] == THREAD_EXITED) {
+      if (uv_thread_join(threads + i))
+        abort();
+      thread_states[i] = THREAD_UNUSED;
     }
-    q = &run_slow_work_message;
+    if (thread_states[i] == THREAD_UNUSED)
+      break;
   }
 
-  QUEUE_INSERT_TAIL(&wq, q);
-  if (idle_threads > 0)
+  if (i == max_threads || uv_thread_create(threads + i, worker, NULL))
+    return;
+
+  thread_states[i] = THREAD_RUNNING;
+  starting_threads++;
+  nthreads++;
+}
+
+
+static void post(QUEUE* q, enum uv__work_kind kind) {
+  uv_mutex_lock(&mutex);
+  account_wait_time(&stats[kind]);
+  stats[kind].queued++;
+  QUEUE_INSERT_TAIL(&wq[kind], q);
+  if (idle_threads > wakeups) {
+    wakeups++;
     uv_cond_signal(&cond);
+  } else {
+    maybe_add_thread();
+  }
   uv_mutex_unlock(&mutex);
 }
 
@@ -169,46 +281,82 @@ void uv__threadpool_cleanup(void) {
   if (nthreads == 0)
     return;
 
-  post(&exit_message, UV__WORK_CPU);
+  uv_mutex_lock(&mutex);
+  exiting = 1;
+  uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&mutex);
 
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_join(threads + i))
-      abort();
+  for (i = 0; i < max_threads; i++)
+    if (thread_states[i] != THREAD_UNUSED)
+      if (uv_thread_join(threads + i))
+        abort();
 
-  if (threads != default_threads)
+  if (threads != default_threads) {
     uv__free(threads);
+    uv__free(thread_states);
+  }
 
   uv_mutex_destroy(&mutex);
   uv_cond_destroy(&cond);
 
   threads = NULL;
+  thread_states = NULL;
   nthreads = 0;
 #endif
 }
 
 
+static unsigned int threadpool_size_from_env(const char* name,
+                                             unsigned int fallback) {
+  const char* val;
+  unsigned int size;
+
+  val = getenv(name);
+  if (val == NULL)
+    return fallback;
+
+  size = atoi(val);
+  if (size == 0)
+    size = 1;
+  if (size > MAX_THREADPOOL_SIZE)
+    size = MAX_THREADPOOL_SIZE;
+  return size;
+}
+
+
 static void init_threads(void) {
   unsigned int i;
-  const char* val;
   uv_sem_t sem;
 
-  nthreads = ARRAY_SIZE(default_threads);
-  val = getenv("UV_THREADPOOL_SIZE");
-  if (val != NULL)
-    nthreads = atoi(val);
-  if (nthreads == 0)
-    nthreads = 1;
-  if (nthreads > MAX_THREADPOOL_SIZE)
-    nthreads = MAX_THREADPOOL_SIZE;
+  min_threads = threadpool_size_from_env("UV_THREADPOOL_SIZE",
+                                         ARRAY_SIZE(default_threads));
+  max_threads = threadpool_size_from_env("UV_THREADPOOL_MAX_SIZE",
+                                         min_threads);
+  if (max_threads < min_threads)
+    max_threads = min_threads;
+
+  /* Threads that come and go and timing information would make the
+     recording depend on the machine it was made on. */
+  timed = !V8RecordReplayIsRecordingOrReplaying();
+  if (!timed)
+    max_threads = min_threads;
 
   threads = default_threads;
-  if (nthreads > ARRAY_SIZE(default_threads)) {
-    threads = uv__malloc(nthreads * sizeof(threads[0]));
-    if (threads == NULL) {
-      nthreads = ARRAY_SIZE(default_threads);
+  thread_states = default_thread_states;
+  if (max_threads > ARRAY_SIZE(default_threads)) {
+    threads = uv__malloc(max_threads * sizeof(threads[0]));
+    thread_states = uv__malloc(max_threads * sizeof(thread_states[0]));
+    if (threads == NULL || thread_states == NULL) {
+      uv__free(threads);
+      uv__free(thread_states);
+      if (min_threads > ARRAY_SIZE(default_threads))
+        min_threads = ARRAY_SIZE(default_threads);
+      max_threads = min_threads;
       threads = default_threads;
+      thread_states = default_thread_states;
     }
   }
+  memset(thread_states, THREAD_UNUSED, max_threads * sizeof(thread_states[0]));
 
   if (uv_cond_init(&cond))
     abort();
@@ -217,16 +365,24 @@ static void init_threads(void) {
     abort();
   uv_mutex_mark_ordered(&mutex);
 
-  QUEUE_INIT(&wq);
-  QUEUE_INIT(&slow_io_pending_wq);
-  QUEUE_INIT(&run_slow_work_message);
+  for (i = 0; i < ARRAY_SIZE(wq); i++)
+    QUEUE_INIT(&wq[i]);
+  memset(stats, 0, sizeof(stats));
+  idle_threads = 0;
+  wakeups = 0;
+  next_kind = 0;
+  exiting = 0;
 
   if (uv_sem_init(&sem, 0))
     abort();
 
-  for (i = 0; i < nthreads; i++)
+  nthreads = min_threads;
+  starting_threads = min_threads;
+  for (i = 0; i < nthreads; i++) {
     if (uv_thread_create(threads + i, worker, &sem))
       abort();
+    thread_states[i] = THREAD_RUNNING;
+  }
 
   for (i = 0; i < nthreads; i++)
     uv_sem_wait(&sem);
@@ -269,15 +425,39 @@ void uv__work_submit(uv_loop_t* loop,
 }
 
 
+/* Returns the kind of work whose queue `q` is in, or -1 if it is not in one
+ * of them. `mutex` must be locked.
+ */
+static int queue_kind(QUEUE* q, uv_loop_t* loop) {
+  unsigned int k;
+
+  for (;;) {
+    q = QUEUE_NEXT(q);
+    if (q == &loop->wq)
+      return -1;
+    for (k = 0; k < ARRAY_SIZE(wq); k++)
+      if (q == &wq[k])
+        return k;
+  }
+}
+
+
 static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
   int cancelled;
+  int kind;
 
   uv_mutex_lock(&mutex);
   uv_mutex_lock(&w->loop->wq_mutex);
 
   cancelled = !QUEUE_EMPTY(&w->wq) && w->work != NULL;
-  if (cancelled)
+  if (cancelled) {
+    kind = queue_kind(&w->wq, w->loop);
+    if (kind >= 0) {
+      account_wait_time(&stats[kind]);
+      stats[kind].queued--;
+    }
     QUEUE_REMOVE(&w->wq);
+  }
 
   uv_mutex_unlock(&w->loop->wq_mutex);
   uv_mutex_unlock(&mutex);
@@ -391,3 +571,34 @@ int uv_cancel(uv_req_t* req) {
 
   return uv__work_cancel(loop, req, wreq);
 }
+
+
+static void copy_queue_stats(uv_threadpool_queue_stats_t* dst,
+                             struct queue_stats* src) {
+  account_wait_time(src);
+  dst->queued = src->queued;
+  dst->running = src->running;
+  dst->completed = src->completed;
+  dst->wait_time = src->wait_time;
+  dst->run_time = src->run_time;
+}
+
+
+int uv_threadpool_stats(uv_threadpool_stats_t* threadpool_stats) {
+  if (threadpool_stats == NULL)
+    return UV_EINVAL;
+
+  uv_once(&once, init_once);
+
+  uv_mutex_lock(&mutex);
+  threadpool_stats->threads = nthreads;
+  threadpool_stats->idle_threads = idle_threads;
+  threadpool_stats->min_threads = min_threads;
+  threadpool_stats->max_threads = max_threads;
+  copy_queue_stats(&threadpool_stats->cpu, &stats[UV__WORK_CPU]);
+  copy_queue_stats(&threadpool_stats->fast_io, &stats[UV__WORK_FAST_IO]);
+  copy_queue_stats(&threadpool_stats->slow_io, &stats[UV__WORK_SLOW_IO]);
+  uv_mutex_unlock(&mutex);
+
+  return 0;
+}
@@ -36,6 +36,8 @@
 
 #include <net/if.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/prctl.h>
 #include <sys/sysinfo.h>
@@ -82,8 +84,716 @@ static int read_times(FILE* statfile_fp,
 static void read_speeds(unsigned int numcpus, uv_cpu_info_t* ci);
 static uint64_t read_cpufreq(unsigned int cpunum);
 
+extern int V8RecordReplayIsRecordingOrReplaying(void);
+
+/* io_uring ABI definitions.  Mirrors <linux/io_uring.h> so that we can build
+ * against older kernel headers.
+ */
+enum {
+  UV__IORING_OP_READV = 1,
+  UV__IORING_OP_WRITEV = 2,
+  UV__IORING_OP_FSYNC = 3,
+  UV__IORING_OP_OPENAT = 18,
+  UV__IORING_OP_CLOSE = 19,
+  UV__IORING_OP_STATX = 21
+};
+
+enum {
+  UV__IORING_FEAT_SINGLE_MMAP = 1u,
+  UV__IORING_FEAT_NODROP = 2u,
+  UV__IORING_FEAT_RSRC_TAGS = 1024u  /* linux v5.13 */
+};
+
+enum {
+  UV__IORING_REGISTER_EVENTFD = 4u
+};
+
+#define UV__IORING_OFF_SQ_RING 0ull
+#define UV__IORING_OFF_SQES 0x10000000ull
+
+/* Number of submission queue entries.  The kernel sizes the completion
+ * queue at twice this number.
+ */
+#define UV__IOU_ENTRIES 64
+
+struct uv__io_sqring_offsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t reserved0;
+  uint64_t reserved1;
+};
+
+STATIC_ASSERT(40 == sizeof(struct uv__io_sqring_offsets));
+
+struct uv__io_cqring_offsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint64_t reserved0;
+  uint64_t reserved1;
+};
+
+STATIC_ASSERT(40 == sizeof(struct uv__io_cqring_offsets));
+
+struct uv__io_uring_params {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t features;
+  uint32_t wq_fd;
+  uint32_t reserved[3];
+  struct uv__io_sqring_offsets sq_off;
+  struct uv__io_cqring_offsets cq_off;
+};
+
+STATIC_ASSERT(40 + 40 + 40 == sizeof(struct uv__io_uring_params));
+
+struct uv__io_uring_sqe {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;  /* Also addr2 (the statx buffer for IORING_OP_STATX.) */
+  uint64_t addr;
+  uint32_t len;
+  uint32_t rw_flags;  /* Also fsync_flags, open_flags and statx_flags. */
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+STATIC_ASSERT(64 == sizeof(struct uv__io_uring_sqe));
+
+struct uv__io_uring_cqe {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+STATIC_ASSERT(16 == sizeof(struct uv__io_uring_cqe));
+
+
+static int uv__use_io_uring(void) {
+  static int use_io_uring;  /* 0 = unknown, 1 = yes, -1 = no */
+  const char* val;
+  int use;
+
+  use = uv__load_relaxed(&use_io_uring);
+
+  if (use == 0) {
+    val = getenv("UV_USE_IO_URING");
+    use = val == NULL || atoi(val) ? 1 : -1;
+    uv__store_relaxed(&use_io_uring, use);
+  }
+
+  return use > 0;
+}
+
+
+static void uv__iou_on_eventfd(uv_loop_t* loop,
+                               uv__io_t* w,
+                               unsigned int events);
+static void uv__iou_on_failed(uv_loop_t* loop,
+                              uv__io_t* w,
+                              unsigned int events);
+
+
+static void uv__iou_init(uv_loop_t* loop, struct uv__iou* iou) {
+  struct uv__io_uring_params params;
+  uint32_t i;
+  size_t cqlen;
+  size_t sqlen;
+  size_t maxlen;
+  size_t sqelen;
+  char* sq;
+  char* sqe;
+  int ringfd;
+  int evfd;
+
+  iou->ringfd = -1;  /* Unavailable unless everything below succeeds. */
+
+  if (!uv__use_io_uring())
+    return;
+
+  /* Requests completed by the kernel never pass through the system call
+   * wrappers that the recorder intercepts, so their results would not be
+   * available when replaying.  Stay on the thread pool in that case.
+   */
+  if (V8RecordReplayIsRecordingOrReplaying())
+    return;
+
+  memset(&params, 0, sizeof(params));
+
+  ringfd = uv__io_uring_setup(UV__IOU_ENTRIES, &params);
+  if (ringfd == -1)
+    return;
+
+  /* IORING_FEAT_RSRC_TAGS is only used to detect linux v5.13.  Earlier
+   * kernels have assorted bugs in their file operations that we don't want
+   * to deal with, and lack IORING_OP_STATX before v5.6.
+   */
+  if (!(params.features & UV__IORING_FEAT_RSRC_TAGS) ||
+      !(params.features & UV__IORING_FEAT_SINGLE_MMAP) ||
+      !(params.features & UV__IORING_FEAT_NODROP))
+    goto fail_ring;
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  maxlen = sqlen < cqlen ? cqlen : sqlen;
+  sqelen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+
+  sq = mmap(0,
+            maxlen,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            ringfd,
+            UV__IORING_OFF_SQ_RING);
+
+  if (sq == MAP_FAILED)
+    goto fail_ring;
+
+  sqe = mmap(0,
+             sqelen,
+             PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE,
+             ringfd,
+             UV__IORING_OFF_SQES);
+
+  if (sqe == MAP_FAILED)
+    goto fail_sq;
+
+  /* Completions are announced on an eventfd that is watched like any other
+   * file descriptor, so they are picked up by the regular epoll_wait() call.
+   */
+  evfd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (evfd == -1)
+    goto fail_sqe;
+
+  if (uv__io_uring_register(ringfd, UV__IORING_REGISTER_EVENTFD, &evfd, 1))
+    goto fail_evfd;
+
+  iou->sqhead = (uint32_t*) (sq + params.sq_off.head);
+  iou->sqtail = (uint32_t*) (sq + params.sq_off.tail);
+  iou->sqmask = *(uint32_t*) (sq + params.sq_off.ring_mask);
+  iou->sqarray = (uint32_t*) (sq + params.sq_off.array);
+  iou->cqhead = (uint32_t*) (sq + params.cq_off.head);
+  iou->cqtail = (uint32_t*) (sq + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) (sq + params.cq_off.ring_mask);
+  iou->sq = sq;
+  iou->cqe = sq + params.cq_off.cqes;
+  iou->sqe = sqe;
+  iou->sqlen = sqlen;
+  iou->cqlen = cqlen;
+  iou->maxlen = maxlen;
+  iou->sqelen = sqelen;
+  iou->ringfd = ringfd;
+  iou->in_flight = 0;
+  iou->unsubmitted = 0;
+
+  /* The submission queue indirection array maps 1:1 to the sqe array. */
+  for (i = 0; i <= iou->sqmask; i++)
+    iou->sqarray[i] = i;
+
+  uv__io_init(&iou->eventfd_watcher, uv__iou_on_eventfd, evfd);
+  uv__io_start(loop, &iou->eventfd_watcher, POLLIN);
+
+  return;
+
+fail_evfd:
+  uv__close(evfd);
+fail_sqe:
+  munmap(sqe, sqelen);
+fail_sq:
+  munmap(sq, maxlen);
+fail_ring:
+  uv__close(ringfd);
+}
+
+
+static void uv__iou_delete(uv_loop_t* loop, struct uv__iou* iou) {
+  if (iou->ringfd >= 0) {
+    uv__io_stop(loop, &iou->eventfd_watcher, POLLIN);
+    uv__close(iou->eventfd_watcher.fd);
+    munmap(iou->sqe, iou->sqelen);
+    munmap(iou->sq, iou->maxlen);
+    uv__close(iou->ringfd);
+  }
+
+  iou->ringfd = -2;
+}
+
+
+static struct uv__io_uring_sqe* uv__iou_get_sqe(uv_loop_t* loop,
+                                               uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+  uint32_t head;
+  uint32_t tail;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  /* Lazily set up the ring on first use, most programs never need it. */
+  if (iou->ringfd == -2)
+    uv__iou_init(loop, iou);
+
+  if (iou->ringfd == -1)
+    return NULL;
+
+  /* Don't submit more requests than the completion queue can hold, the
+   * kernel would otherwise have to buffer overflowing completions.
+   */
+  if (iou->in_flight > iou->cqmask)
+    return NULL;
+
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+
+  if (tail - head > iou->sqmask)
+    return NULL;  /* No room in the submission queue. */
+
+  sqe = iou->sqe;
+  sqe = &sqe[tail & iou->sqmask];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = (uintptr_t) req;
+
+  /* Pacify uv_cancel(): with no work function, the request is not mistaken
+   * for one on the thread pool's queue.  work_req.wq links it into the list
+   * of requests on the ring instead.
+   */
+  req->work_req.loop = loop;
+  req->work_req.work = NULL;
+  req->work_req.done = NULL;
+  QUEUE_INSERT_TAIL(&iou->inflight, &req->work_req.wq);
+
+  uv__req_register(loop, req);
+  iou->in_flight++;
+
+  return sqe;
+}
+
+
+static void uv__iou_submit(uv_loop_t* loop) {
+  struct uv__iou* iou;
+
+  /* Only publish the entry here, the kernel is told about it in bulk from
+   * uv__iou_flush() right before the loop blocks for I/O.
+   */
+  iou = &uv__get_internal_fields(loop)->iou;
+  __atomic_store_n(iou->sqtail, *iou->sqtail + 1, __ATOMIC_RELEASE);
+  iou->unsubmitted++;
+}
+
+
+/* Takes a request off the ring, for one that the kernel is never going to
+ * complete.  The request stays registered with the loop.
+ */
+static void uv__iou_fs_drop(struct uv__iou* iou, uv_fs_t* req) {
+  QUEUE_REMOVE(&req->work_req.wq);
+  QUEUE_INIT(&req->work_req.wq);
+  iou->in_flight--;
+
+  switch (req->fs_type) {
+  case UV_FS_STAT:
+  case UV_FS_LSTAT:
+  case UV_FS_FSTAT:
+    uv__free(req->ptr);  /* The statx buffer. */
+    req->ptr = NULL;
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/* Completes a dropped request with |result| from the loop's pending queue,
+ * so that its callback never runs from the caller's stack.
+ */
+static void uv__iou_fs_fail(uv_loop_t* loop,
+                            struct uv__iou* iou,
+                            uv_fs_t* req,
+                            int result) {
+  if (req->fs_type == UV_FS_READ || req->fs_type == UV_FS_WRITE) {
+    if (req->bufs != req->bufsml)
+      uv__free(req->bufs);
+    req->bufs = NULL;
+    req->nbufs = 0;
+  }
+
+  req->result = result;
+  QUEUE_INSERT_TAIL(&iou->failed, &req->work_req.wq);
+  uv__io_feed(loop, &iou->failed_watcher);
+}
+
+
+static void uv__iou_on_failed(uv_loop_t* loop,
+                              uv__io_t* w,
+                              unsigned int events) {
+  struct uv__iou* iou;
+  uv_fs_t* req;
+  QUEUE queue;
+  QUEUE* q;
+
+  iou = container_of(w, struct uv__iou, failed_watcher);
+
+  /* Callbacks may fail more requests, those are picked up next time. */
+  QUEUE_MOVE(&iou->failed, &queue);
+  while (!QUEUE_EMPTY(&queue)) {
+    q = QUEUE_HEAD(&queue);
+    QUEUE_REMOVE(q);
+    QUEUE_INIT(q);
+
+    req = container_of(QUEUE_DATA(q, struct uv__work, wq), uv_fs_t, work_req);
+    uv__req_unregister(loop, req);
+    req->cb(req);
+  }
+}
+
+
+/* Takes back the entries that the kernel hasn't consumed yet and runs them
+ * on the thread pool.
+ */
+static void uv__iou_fall_back(uv_loop_t* loop, struct uv__iou* iou) {
+  struct uv__io_uring_sqe* sqe;
+  uv_fs_t* req;
+  uint32_t head;
+  uint32_t tail;
+
+  /* Without IORING_SETUP_SQPOLL the kernel only consumes entries from inside
+   * io_uring_enter(), so it's safe to rewind the tail here.
+   */
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+  __atomic_store_n(iou->sqtail, head, __ATOMIC_RELEASE);
+  iou->unsubmitted = 0;
+
+  for (; head != tail; head++) {
+    sqe = iou->sqe;
+    sqe = &sqe[head & iou->sqmask];
+    req = (uv_fs_t*) (uintptr_t) sqe->user_data;
+
+    uv__iou_fs_drop(iou, req);
+
+    /* The thread pool would count the bytes of a partially done write from
+     * zero, report what was written so far like uv__fs_write_all() does
+     * when a later write fails.
+     */
+    if (req->fs_type == UV_FS_WRITE && req->result > 0) {
+      uv__iou_fs_fail(loop, iou, req, req->result);
+    } else {
+      uv__req_unregister(loop, req);
+      uv__fs_post_work(loop, req);
+    }
+  }
+}
+
+
+/* The ring and its memory are shared with the parent process after fork(),
+ * and the parent reaps the completions of what is on it.  The child's copies
+ * of those requests are failed with UV_ECANCELED.
+ */
+static void uv__iou_fork(uv_loop_t* loop, struct uv__iou* iou) {
+  uv_fs_t* req;
+  QUEUE* q;
+
+  while (!QUEUE_EMPTY(&iou->inflight)) {
+    q = QUEUE_HEAD(&iou->inflight);
+    req = container_of(QUEUE_DATA(q, struct uv__work, wq), uv_fs_t, work_req);
+    uv__iou_fs_drop(iou, req);
+    uv__iou_fs_fail(loop, iou, req, UV_ECANCELED);
+  }
+
+  iou->unsubmitted = 0;
+}
+
+
+static void uv__iou_flush(uv_loop_t* loop) {
+  struct uv__iou* iou;
+  int rc;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  if (iou->ringfd < 0 || iou->unsubmitted == 0)
+    return;
+
+  do
+    rc = uv__io_uring_enter(iou->ringfd, iou->unsubmitted, 0, 0);
+  while (rc == -1 && errno == EINTR);
+
+  if (rc == -1) {
+    /* EAGAIN and EBUSY mean that the kernel is short on resources or the
+     * completion queue is backed up.  Both resolve themselves once pending
+     * completions are reaped, after which we try again.  Anything else means
+     * that the ring can't take these entries at all.
+     */
+    if (errno != EAGAIN && errno != EBUSY)
+      uv__iou_fall_back(loop, iou);
+    return;
+  }
+
+  iou->unsubmitted -= rc;
+}
+
+
+int uv__iou_fs_close(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->opcode = UV__IORING_OP_CLOSE;
+
+  uv__iou_submit(loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_fsync_or_fdatasync(uv_loop_t* loop,
+                                  uv_fs_t* req,
+                                  uint32_t fsync_flags) {
+  struct uv__io_uring_sqe* sqe;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->rw_flags = fsync_flags;
+  sqe->opcode = UV__IORING_OP_FSYNC;
+
+  uv__iou_submit(loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_open(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->fd = AT_FDCWD;
+  sqe->len = req->mode;
+  sqe->opcode = UV__IORING_OP_OPENAT;
+  sqe->rw_flags = req->flags | O_CLOEXEC;
+
+  uv__iou_submit(loop);
+
+  return 1;
+}
+
+
+static int uv__iou_fs_prep_rw(uv_loop_t* loop, uv_fs_t* req, int is_read) {
+  struct uv__io_uring_sqe* sqe;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->bufs;
+  sqe->fd = req->file;
+  sqe->len = req->nbufs;
+  sqe->off = req->off < 0 ? -1 : req->off;  /* -1 means "current position" */
+  sqe->opcode = is_read ? UV__IORING_OP_READV : UV__IORING_OP_WRITEV;
+
+  uv__iou_submit(loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_read_or_write(uv_loop_t* loop, uv_fs_t* req, int is_read) {
+  /* The kernel rejects vectors longer than IOV_MAX, the thread pool splits
+   * them up for us.
+   */
+  if (req->nbufs > (unsigned int) uv__getiovmax())
+    return 0;
+
+  return uv__iou_fs_prep_rw(loop, req, is_read);
+}
+
+
+int uv__iou_fs_statx(uv_loop_t* loop,
+                     uv_fs_t* req,
+                     int is_fstat,
+                     int is_lstat) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__statx* statxbuf;
+
+  statxbuf = uv__malloc(sizeof(*statxbuf));
+  if (statxbuf == NULL)
+    return 0;
+
+  sqe = uv__iou_get_sqe(loop, req);
+  if (sqe == NULL) {
+    uv__free(statxbuf);
+    return 0;
+  }
+
+  req->ptr = statxbuf;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->off = (uintptr_t) statxbuf;
+  sqe->fd = AT_FDCWD;
+  sqe->len = 0xFFF; /* STATX_BASIC_STATS + STATX_BTIME */
+  sqe->opcode = UV__IORING_OP_STATX;
+
+  if (is_fstat) {
+    sqe->addr = (uintptr_t) "";
+    sqe->fd = req->file;
+    sqe->rw_flags |= 0x1000; /* AT_EMPTY_PATH */
+  }
+
+  if (is_lstat)
+    sqe->rw_flags |= AT_SYMLINK_NOFOLLOW;
+
+  uv__iou_submit(loop);
+
+  return 1;
+}
+
+
+/* Drops the first |n| bytes from a partially written request.  Returns zero
+ * when nothing is left to write.
+ */
+static int uv__iou_fs_write_advance(uv_fs_t* req, size_t n) {
+  unsigned int i;
+
+  for (i = 0; i < req->nbufs && n >= req->bufs[i].len; i++)
+    n -= req->bufs[i].len;
+
+  if (i == req->nbufs)
+    return 0;
+
+  req->bufs[i].base += n;
+  req->bufs[i].len -= n;
+
+  /* Shift in place, req->bufs may be heap allocated and must stay freeable. */
+  memmove(req->bufs, req->bufs + i, (req->nbufs - i) * sizeof(*req->bufs));
+  req->nbufs -= i;
+
+  return 1;
+}
+
+
+static void uv__iou_fs_complete(uv_loop_t* loop, uv_fs_t* req, int res) {
+  struct uv__statx* statxbuf;
+
+  switch (req->fs_type) {
+  case UV_FS_CLOSE:
+    /* Same as uv__fs_close(), the descriptor is gone either way. */
+    if (res == -EINTR || res == -EINPROGRESS)
+      res = 0;
+    break;
+
+  case UV_FS_STAT:
+  case UV_FS_LSTAT:
+  case UV_FS_FSTAT:
+    statxbuf = req->ptr;
+    req->ptr = NULL;
+    if (res == 0) {
+      uv__statx_to_stat(statxbuf, &req->statbuf);
+      req->ptr = &req->statbuf;
+    }
+    uv__free(statxbuf);
+    break;
+
+  case UV_FS_WRITE:
+    /* Like uv__fs_write_all(), keep going until everything is written and
+     * report the partial count if a later write fails.
+     */
+    if (res > 0) {
+      req->result += res;
+      if (req->off >= 0)
+        req->off += res;
+      if (uv__iou_fs_write_advance(req, res))
+        if (uv__iou_fs_prep_rw(loop, req, /* is_read */ 0))
+          return;
+    }
+    if (res >= 0 || req->result > 0)
+      res = req->result;
+    /* Fall through. */
+  case UV_FS_READ:
+    if (req->bufs != req->bufsml)
+      uv__free(req->bufs);
+    req->bufs = NULL;
+    req->nbufs = 0;
+    break;
+
+  default:
+    break;
+  }
+
+  req->result = res;
+  req->cb(req);
+}
+
+
+static void uv__iou_on_eventfd(uv_loop_t* loop,
+                               uv__io_t* w,
+                               unsigned int events) {
+  struct uv__io_uring_cqe* cqe;
+  struct uv__iou* iou;
+  uv_fs_t* req;
+  uint64_t val;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t i;
+  int res;
+  int rc;
+
+  iou = container_of(w, struct uv__iou, eventfd_watcher);
+
+  /* Reset the counter before reaping so that completions that arrive while
+   * we're busy below wake us up again.
+   */
+  do
+    rc = read(w->fd, &val, sizeof(val));
+  while (rc == -1 && errno == EINTR);
+
+  head = *iou->cqhead;
+  tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+
+  for (i = head; i != tail; i++) {
+    cqe = iou->cqe;
+    cqe = &cqe[i & iou->cqmask];
+    req = (uv_fs_t*) (uintptr_t) cqe->user_data;
+    res = cqe->res;
+
+    /* Hand the slot back to the kernel before running the callback, the
+     * callback is free to start new requests.
+     */
+    __atomic_store_n(iou->cqhead, i + 1, __ATOMIC_RELEASE);
+
+    assert(req->type == UV_FS);
+    QUEUE_REMOVE(&req->work_req.wq);
+    QUEUE_INIT(&req->work_req.wq);
+    uv__req_unregister(loop, req);
+    iou->in_flight--;
+
+    uv__iou_fs_complete(loop, req, res);
+  }
+}
+
 
 int uv__platform_loop_init(uv_loop_t* loop) {
+  struct uv__iou* iou;
   int fd;
   fd = epoll_create1(O_CLOEXEC);
 
@@ -101,6 +811,12 @@ int uv__platform_loop_init(uv_loop_t* loop) {
   loop->inotify_fd = -1;
   loop->inotify_watchers = NULL;
 
+  iou = &uv__get_internal_fields(loop)->iou;
+  iou->ringfd = -2;  /* Initialized lazily. */
+  QUEUE_INIT(&iou->inflight);
+  QUEUE_INIT(&iou->failed);
+  uv__io_init(&iou->failed_watcher, uv__iou_on_failed, -1);
+
   if (fd == -1)
     return UV__ERR(errno);
 
@@ -109,11 +825,19 @@ int uv__platform_loop_init(uv_loop_t* loop) {
 
 
 int uv__io_fork(uv_loop_t* loop) {
+  struct uv__iou* iou;
+  QUEUE failed;
   int err;
   void* old_watchers;
 
   old_watchers = loop->inotify_watchers;
 
+  /* Keep the failed requests across uv__platform_loop_init(). */
+  iou = &uv__get_internal_fields(loop)->iou;
+  uv__iou_fork(loop, iou);
+  QUEUE_MOVE(&iou->failed, &failed);
+  QUEUE_REMOVE(&iou->failed_watcher.pending_queue);
+
   uv__close(loop->backend_fd);
   loop->backend_fd = -1;
   uv__platform_loop_delete(loop);
@@ -122,11 +846,16 @@ int uv__io_fork(uv_loop_t* loop) {
   if (err)
     return err;
 
+  QUEUE_MOVE(&failed, &iou->failed);
+  if (!QUEUE_EMPTY(&iou->failed))
+    uv__io_feed(loop, &iou->failed_watcher);
+
   return uv__inotify_fork(loop, old_watchers);
 }
 
 
 void uv__platform_loop_delete(uv_loop_t* loop) {
+  uv__iou_delete(loop, &uv__get_internal_fields(loop)->iou);
   if (loop->inotify_fd == -1) return;
   uv__io_stop(loop, &loop->inotify_read_watcher, POLLIN);
   uv__close(loop->inotify_fd);
@@ -221,6 +950,11 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
   int user_timeout;
   int reset_timeout;
 
+  /* Hand the file system requests queued since the last iteration to the
+   * kernel in one go.
+   */
+  uv__iou_flush(loop);
+
   if (loop->nfds == 0) {
     assert(QUEUE_EMPTY(&loop->watcher_queue));
     return;
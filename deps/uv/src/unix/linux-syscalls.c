@@ -140,6 +140,23 @@
 # endif
 #endif /* __NR_getrandom */
 
+/* The io_uring system calls were added after the per-architecture system
+ * call tables were unified, so they have the same numbers on all of the
+ * architectures we care about.
+ */
+#ifndef __NR_io_uring_setup
+# if defined(__arm__)
+#  define __NR_io_uring_setup (UV_SYSCALL_BASE + 425)
+#  define __NR_io_uring_enter (UV_SYSCALL_BASE + 426)
+#  define __NR_io_uring_register (UV_SYSCALL_BASE + 427)
+# elif defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || \
+       defined(__powerpc__) || defined(__s390__)
+#  define __NR_io_uring_setup 425
+#  define __NR_io_uring_enter 426
+#  define __NR_io_uring_register 427
+# endif
+#endif /* __NR_io_uring_setup */
+
 struct uv__mmsghdr;
 
 int uv__sendmmsg(int fd, struct uv__mmsghdr* mmsg, unsigned int vlen) {
@@ -265,3 +282,42 @@ ssize_t uv__getrandom(void* buf, size_t buflen, unsigned flags) {
   return errno = ENOSYS, -1;
 #endif
 }
+
+
+int uv__io_uring_setup(int entries, void* params) {
+#if defined(__NR_io_uring_setup)
+  return syscall(__NR_io_uring_setup, entries, params);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
+
+
+int uv__io_uring_enter(int fd,
+                       unsigned to_submit,
+                       unsigned min_complete,
+                       unsigned flags) {
+#if defined(__NR_io_uring_enter)
+  /* io_uring_enter used to take _NSIG / 8 as its last argument but that
+   * argument is now ignored when no signal mask is passed.
+   */
+  return syscall(__NR_io_uring_enter,
+                 fd,
+                 to_submit,
+                 min_complete,
+                 flags,
+                 NULL,
+                 0L);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
+
+
+int uv__io_uring_register(int fd, unsigned opcode, void* arg, unsigned nargs) {
+#if defined(__NR_io_uring_register)
+  return syscall(__NR_io_uring_register, fd, opcode, arg, nargs);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
@@ -77,5 +77,11 @@ int uv__statx(int dirfd,
               unsigned int mask,
               struct uv__statx* statxbuf);
 ssize_t uv__getrandom(void* buf, size_t buflen, unsigned flags);
+int uv__io_uring_setup(int entries, void* params);
+int uv__io_uring_enter(int fd,
+                       unsigned to_submit,
+                       unsigned min_complete,
+                       unsigned flags);
+int uv__io_uring_register(int fd, unsigned opcode, void* arg, unsigned nargs);
 
 #endif /* UV_LINUX_SYSCALL_H_ */
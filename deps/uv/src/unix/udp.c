@@ -757,6 +757,95 @@ int uv__udp_try_send(uv_udp_t* handle,
 }
 
 
+static socklen_t uv__udp_sockaddr_len(const struct sockaddr* addr) {
+  if (addr == NULL)
+    return 0;
+  if (addr->sa_family == AF_INET6)
+    return sizeof(struct sockaddr_in6);
+  if (addr->sa_family == AF_INET)
+    return sizeof(struct sockaddr_in);
+  if (addr->sa_family == AF_UNIX)
+    return sizeof(struct sockaddr_un);
+  assert(0 && "unsupported address family");
+  abort();
+}
+
+
+int uv__udp_try_send2(uv_udp_t* handle,
+                      unsigned int count,
+                      uv_buf_t* bufs[],
+                      unsigned int nbufs[],
+                      struct sockaddr* addrs[]) {
+  struct msghdr h;
+  unsigned int i;
+  ssize_t size;
+  int err;
+#if HAVE_MMSG
+  struct uv__mmsghdr m[UV__MMSG_MAXWIDTH];
+  int npkts;
+#endif
+
+  for (i = 0; i < count; i++) {
+    if (addrs[i] != NULL) {
+      err = uv__udp_maybe_deferred_bind(handle, addrs[i]->sa_family, 0);
+      if (err)
+        return err;
+    }
+  }
+
+#if HAVE_MMSG
+  uv_once(&once, uv__udp_mmsg_init);
+  if (uv__sendmmsg_avail) {
+    if (count > ARRAY_SIZE(m))
+      count = ARRAY_SIZE(m);
+
+    memset(m, 0, count * sizeof(m[0]));
+    for (i = 0; i < count; i++) {
+      m[i].msg_hdr.msg_name = addrs[i];
+      m[i].msg_hdr.msg_namelen = uv__udp_sockaddr_len(addrs[i]);
+      m[i].msg_hdr.msg_iov = (struct iovec*) bufs[i];
+      m[i].msg_hdr.msg_iovlen = nbufs[i];
+    }
+
+    do
+      npkts = uv__sendmmsg(handle->io_watcher.fd, m, count);
+    while (npkts == -1 && errno == EINTR);
+
+    if (npkts == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        return UV_EAGAIN;
+      return UV__ERR(errno);
+    }
+
+    return npkts;
+  }
+#endif
+
+  for (i = 0; i < count; i++) {
+    memset(&h, 0, sizeof h);
+    h.msg_name = addrs[i];
+    h.msg_namelen = uv__udp_sockaddr_len(addrs[i]);
+    h.msg_iov = (struct iovec*) bufs[i];
+    h.msg_iovlen = nbufs[i];
+
+    do
+      size = sendmsg(handle->io_watcher.fd, &h, 0);
+    while (size == -1 && errno == EINTR);
+
+    if (size == -1) {
+      /* Report what went out so far; the caller retries the rest. */
+      if (i > 0)
+        return i;
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        return UV_EAGAIN;
+      return UV__ERR(errno);
+    }
+  }
+
+  return i;
+}
+
+
 static int uv__udp_set_membership4(uv_udp_t* handle,
                                    const struct sockaddr_in* multicast_addr,
                                    const char* interface_addr,
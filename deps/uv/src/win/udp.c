@@ -1179,3 +1179,28 @@ int uv__udp_try_send(uv_udp_t* handle,
 
   return bytes;
 }
+
+
+int uv__udp_try_send2(uv_udp_t* handle,
+                      unsigned int count,
+                      uv_buf_t* bufs[],
+                      unsigned int nbufs[],
+                      struct sockaddr* addrs[]) {
+  unsigned int i;
+  int addrlen;
+  int r;
+
+  for (i = 0; i < count; i++) {
+    if (addrs[i] == NULL)
+      addrlen = 0;
+    else if (addrs[i]->sa_family == AF_INET6)
+      addrlen = sizeof(struct sockaddr_in6);
+    else
+      addrlen = sizeof(struct sockaddr_in);
+    r = uv__udp_try_send(handle, bufs[i], nbufs[i], addrs[i], addrlen);
+    if (r < 0)
+      return i > 0 ? i : r;
+  }
+
+  return i;
+}
@@ -676,6 +676,57 @@ TEST_IMPL(fork_threadpool_queue_work_simple) {
 }
 #endif /* !__MVS__ */
 
+
+#ifdef __linux__
+static int fork_stat_cb_called;
+static int fork_stat_result;
+
+
+static void fork_stat_cb(uv_fs_t* req) {
+  fork_stat_cb_called++;
+  fork_stat_result = req->result;
+  uv_fs_req_cleanup(req);
+}
+
+
+TEST_IMPL(fork_fs_io_uring_pending) {
+  /* A request queued on io_uring before fork() completes in the parent, and
+   * fails with UV_ECANCELED in the child instead of hanging its loop.
+   */
+
+  pid_t child_pid;
+  uv_fs_t req;
+
+  ASSERT(0 == uv_fs_stat(uv_default_loop(), &req, ".", fork_stat_cb));
+
+  /* Requests on the thread pool are lost with its threads in the child. */
+  if (req.work_req.work != NULL) {
+    ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+    RETURN_SKIP("io_uring is not available");
+  }
+
+  child_pid = fork();
+  ASSERT(child_pid != -1);
+
+  if (child_pid != 0) {
+    /* parent */
+    ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+    ASSERT(1 == fork_stat_cb_called);
+    ASSERT(0 == fork_stat_result);
+    assert_wait_child(child_pid);
+  } else {
+    /* child */
+    ASSERT(0 == uv_loop_fork(uv_default_loop()));
+    ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+    ASSERT(1 == fork_stat_cb_called);
+    ASSERT(UV_ECANCELED == fork_stat_result);
+  }
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+#endif /* __linux__ */
+
 #else
 
 typedef int file_has_no_tests; /* ISO C forbids an empty translation unit. */
@@ -4415,3 +4415,118 @@ TEST_IMPL(fs_get_system_error) {
 
   return 0;
 }
+
+
+/* On Linux these requests go through io_uring when the kernel supports it,
+ * and through the thread pool otherwise.  The batch of stat requests is
+ * larger than the ring, so some of them take the thread pool either way.
+ */
+#define IO_URING_BATCH_SIZE 200
+
+static uv_fs_t io_uring_req;
+static uv_fs_t io_uring_batch_reqs[IO_URING_BATCH_SIZE];
+static char io_uring_buf[32];
+static const char io_uring_text[] = "io_uring read/write test";
+static uv_file io_uring_file;
+static int io_uring_ops_done;
+static int io_uring_batch_done;
+
+
+static void io_uring_stat_cb(uv_fs_t* req) {
+  ASSERT(req == &io_uring_req);
+  ASSERT(req->fs_type == UV_FS_STAT);
+  ASSERT(req->result == 0);
+  ASSERT(req->statbuf.st_size == sizeof(io_uring_text) - 1);
+  ASSERT(S_ISREG(req->statbuf.st_mode));
+  uv_fs_req_cleanup(req);
+  io_uring_ops_done = 1;
+}
+
+
+static void io_uring_close_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_CLOSE);
+  ASSERT(req->result == 0);
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_stat(loop, req, "test_file", io_uring_stat_cb));
+}
+
+
+static void io_uring_read_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_READ);
+  ASSERT(req->result == sizeof(io_uring_text) - 1);
+  ASSERT(0 == memcmp(io_uring_buf, io_uring_text, req->result));
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_close(loop, req, io_uring_file, io_uring_close_cb));
+}
+
+
+static void io_uring_fstat_cb(uv_fs_t* req) {
+  uv_buf_t buf;
+
+  ASSERT(req->fs_type == UV_FS_FSTAT);
+  ASSERT(req->result == 0);
+  ASSERT(req->statbuf.st_size == sizeof(io_uring_text) - 1);
+  uv_fs_req_cleanup(req);
+
+  buf = uv_buf_init(io_uring_buf, sizeof(io_uring_buf));
+  ASSERT(0 == uv_fs_read(loop, req, io_uring_file, &buf, 1, 0,
+                         io_uring_read_cb));
+}
+
+
+static void io_uring_write_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_WRITE);
+  ASSERT(req->result == sizeof(io_uring_text) - 1);
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_fstat(loop, req, io_uring_file, io_uring_fstat_cb));
+}
+
+
+static void io_uring_open_cb(uv_fs_t* req) {
+  uv_buf_t bufs[2];
+
+  ASSERT(req->fs_type == UV_FS_OPEN);
+  ASSERT(req->result >= 0);
+  io_uring_file = req->result;
+  uv_fs_req_cleanup(req);
+
+  /* Two buffers, so that the write is vectored. */
+  bufs[0] = uv_buf_init((char*) io_uring_text, 8);
+  bufs[1] = uv_buf_init((char*) io_uring_text + 8,
+                        sizeof(io_uring_text) - 1 - 8);
+  ASSERT(0 == uv_fs_write(loop, req, io_uring_file, bufs, 2, 0,
+                          io_uring_write_cb));
+}
+
+
+static void io_uring_batch_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_STAT);
+  ASSERT(req->result == 0);
+  ASSERT(S_ISDIR(req->statbuf.st_mode));
+  uv_fs_req_cleanup(req);
+  io_uring_batch_done++;
+}
+
+
+TEST_IMPL(fs_io_uring_ops) {
+  int i;
+
+  unlink("test_file");
+  loop = uv_default_loop();
+
+  ASSERT(0 == uv_fs_open(loop, &io_uring_req, "test_file",
+                         O_RDWR | O_CREAT | O_TRUNC, S_IWUSR | S_IRUSR,
+                         io_uring_open_cb));
+  for (i = 0; i < IO_URING_BATCH_SIZE; i++)
+    ASSERT(0 == uv_fs_stat(loop, &io_uring_batch_reqs[i], ".",
+                           io_uring_batch_cb));
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(io_uring_ops_done == 1);
+  ASSERT(io_uring_batch_done == IO_URING_BATCH_SIZE);
+
+  unlink("test_file");
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -417,6 +417,7 @@ TEST_DECLARE   (fs_fchmod_archive_readonly)
 TEST_DECLARE   (fs_invalid_mkdir_name)
 #endif
 TEST_DECLARE   (fs_get_system_error)
+TEST_DECLARE   (fs_io_uring_ops)
 TEST_DECLARE   (strscpy)
 TEST_DECLARE   (threadpool_queue_work_simple)
 TEST_DECLARE   (threadpool_queue_work_einval)
@@ -517,6 +518,9 @@ TEST_DECLARE  (fork_fs_events_file_parent_child)
 #ifndef __MVS__
 TEST_DECLARE  (fork_threadpool_queue_work_simple)
 #endif
+#ifdef __linux__
+TEST_DECLARE  (fork_fs_io_uring_pending)
+#endif
 #endif
 
 TEST_DECLARE  (idna_toascii)
@@ -1057,6 +1061,7 @@ TASK_LIST_START
   TEST_ENTRY  (fs_invalid_mkdir_name)
 #endif
   TEST_ENTRY  (fs_get_system_error)
+  TEST_ENTRY  (fs_io_uring_ops)
   TEST_ENTRY  (get_osfhandle_valid_handle)
   TEST_ENTRY  (open_osfhandle_valid_handle)
   TEST_ENTRY  (strscpy)
@@ -1105,6 +1110,9 @@ TASK_LIST_START
 #ifndef __MVS__
   TEST_ENTRY  (fork_threadpool_queue_work_simple)
 #endif
+#ifdef __linux__
+  TEST_ENTRY  (fork_fs_io_uring_pending)
+#endif
 #endif
 
   TEST_ENTRY  (utf8_decode1)
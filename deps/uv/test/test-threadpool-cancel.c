@@ -48,9 +48,11 @@ static unsigned done2_cb_called;
 static unsigned timer_cb_called;
 static uv_work_t pause_reqs[4];
 static uv_sem_t pause_sems[ARRAY_SIZE(pause_reqs)];
+static uv_sem_t running_sem;
 
 
 static void work_cb(uv_work_t* req) {
+  uv_sem_post(&running_sem);
   uv_sem_wait(pause_sems + (req - pause_reqs));
 }
 
@@ -72,10 +74,17 @@ static void saturate_threadpool(void) {
   putenv(buf);
 
   loop = uv_default_loop();
+  ASSERT(0 == uv_sem_init(&running_sem, 0));
   for (i = 0; i < ARRAY_SIZE(pause_reqs); i += 1) {
     ASSERT(0 == uv_sem_init(pause_sems + i, 0));
     ASSERT(0 == uv_queue_work(loop, pause_reqs + i, work_cb, done_cb));
   }
+
+  /* Threads take work from their queues in turn, so a request that is queued
+   * later could otherwise be picked up before all threads are blocked. */
+  for (i = 0; i < ARRAY_SIZE(pause_reqs); i += 1)
+    uv_sem_wait(&running_sem);
+  uv_sem_destroy(&running_sem);
 }
 
 
@@ -289,6 +298,11 @@ TEST_IMPL(threadpool_cancel_fs) {
   saturate_threadpool();
   iov = uv_buf_init(NULL, 0);
 
+  /* Requests on io_uring are in the kernel's hands once the loop has run and
+   * can't be cancelled.  Keep them all on the thread pool.
+   */
+  putenv((char*) "UV_USE_IO_URING=0");
+
   /* Needs to match ARRAY_SIZE(fs_reqs). */
   n = 0;
   ASSERT(0 == uv_fs_chmod(loop, reqs + n++, "/", 0, fs_cb));
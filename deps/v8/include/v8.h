@@ -12120,6 +12120,7 @@ static void SetRecordingOrReplaying(void* handle);
 static bool IsRecordingOrReplaying();
 static bool IsRecording();
 static bool IsReplaying();
+static bool HasDivergedFromRecording();
 
 static void Print(const char* format, ...);
 static void Diagnostic(const char* format, ...);
@@ -12135,6 +12136,7 @@ static void OrderedUnlock(int lock);
 
 static void InvalidateRecording(const char* why);
 static void NewCheckpoint();
+static uint64_t ProgressCounter();
 
 static bool AreEventsDisallowed();
 static void BeginPassThroughEvents();
@@ -11246,6 +11246,10 @@ bool recordreplay::IsRecordingOrReplaying() {
   return gRecordingOrReplaying;
 }
 
+extern "C" int V8RecordReplayIsRecordingOrReplaying() {
+  return recordreplay::IsRecordingOrReplaying();
+}
+
 void recordreplay::Print(const char* format, ...) {
   if (IsRecordingOrReplaying()) {
     va_list args;
@@ -11372,6 +11376,13 @@ void recordreplay::NewCheckpoint() {
   }
 }
 
+uint64_t recordreplay::ProgressCounter() {
+  if (IsRecordingOrReplaying()) {
+    return *internal::gProgressCounter;
+  }
+  return 0;
+}
+
 size_t recordreplay::CreateOrderedLock(const char* name) {
   if (IsRecordingOrReplaying()) {
     return gRecordReplayCreateOrderedLock(name);
@@ -11425,13 +11436,17 @@ bool recordreplay::IsRecording() {
   return !IsReplaying();
 }
 
-extern "C" bool V8RecordReplayHasDivergedFromRecording() {
-  if (recordreplay::IsRecordingOrReplaying()) {
+bool recordreplay::HasDivergedFromRecording() {
+  if (IsRecordingOrReplaying()) {
     return gRecordReplayHasDivergedFromRecording();
   }
   return false;
 }
 
+extern "C" bool V8RecordReplayHasDivergedFromRecording() {
+  return recordreplay::HasDivergedFromRecording();
+}
+
 void recordreplay::RegisterPointer(const void* ptr) {
   if (IsRecordingOrReplaying()) {
     gRecordReplayRegisterPointer(ptr);
@@ -3364,11 +3364,28 @@ void FunctionCallbackIsRecordingOrReplaying(const FunctionCallbackInfo<Value>& c
   callArgs.GetReturnValue().Set(rv);
 }
 
+// Arguments array for the console API call currently being reported to the
+// driver, if any.
+static i::Handle<i::Object>* gCurrentConsoleArguments;
+
 void FunctionCallbackRecordReplayOnConsoleAPI(const FunctionCallbackInfo<Value>& callArgs) {
   CHECK(recordreplay::IsRecordingOrReplaying());
   if (IsMainThread()) {
+    // Keep the message arguments available while the driver processes the
+    // message, so that Target.getCurrentMessageContents can read them directly
+    // instead of finding them via the inspector.
+    i::Handle<i::Object> arguments = Utils::OpenHandle(*callArgs[0]);
+    gCurrentConsoleArguments = &arguments;
     i::RecordReplayOnConsoleMessage(0);
+    gCurrentConsoleArguments = nullptr;
+  }
+}
+
+void FunctionCallbackRecordReplayGetCurrentConsoleArguments(const FunctionCallbackInfo<Value>& args) {
+  if (!gCurrentConsoleArguments) {
+    return;
   }
+  args.GetReturnValue().Set(Utils::ToLocal(*gCurrentConsoleArguments));
 }
 
 void FunctionCallbackRecordReplaySetCommandCallback(const FunctionCallbackInfo<Value>& callArgs) {
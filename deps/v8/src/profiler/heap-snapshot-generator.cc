@@ -2275,7 +2275,10 @@ void HeapSnapshotJSONSerializer::SerializeImpl() {
   // Heap contents can vary when recording vs. replaying, and we don't want
   // these variances to affect behavior when replaying. We could record/replay
   // the snapshot itself, but it is simpler to just disable this functionality.
-  if (recordreplay::IsRecordingOrReplaying()) {
+  // After diverging from the recording when replaying, behavior no longer
+  // needs to match the recording and the snapshot can be generated normally.
+  if (recordreplay::IsRecordingOrReplaying() &&
+      !recordreplay::HasDivergedFromRecording()) {
     writer_->AddString("{}");
     return;
   }
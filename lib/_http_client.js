@@ -289,7 +289,7 @@ function ClientRequest(input, options, cb) {
     }
 
     if (this.getHeader('expect')) {
-      if (this._header) {
+      if (this.headersSent) {
         throw new ERR_HTTP_HEADERS_SENT('render');
       }
 
@@ -345,7 +345,7 @@ ClientRequest.prototype._finish = function _finish() {
 };
 
 ClientRequest.prototype._implicitHeader = function _implicitHeader() {
-  if (this._header) {
+  if (this.headersSent) {
     throw new ERR_HTTP_HEADERS_SENT('render');
   }
   this._storeHeader(this.method + ' ' + this.path + ' HTTP/1.1\r\n',
@@ -773,7 +773,8 @@ function tickOnSocket(req, socket) {
                     req.maxHeaderSize || 0,
                     req.insecureHTTPParser === undefined ?
                       isLenient() : req.insecureHTTPParser,
-                    0);
+                    0,
+                    true);  // lazyHeaders
   parser.socket = socket;
   parser.outgoing = req;
   req.parser = parser;
@@ -72,9 +72,12 @@ function parserOnHeaders(headers, url) {
 // this request.
 // `url` is not set for response parsers but that's not applicable here since
 // all our parsers are request parsers.
+// `headerValues` is set if the parser was initialized with lazy headers and
+// all headers arrived at once. `headers` then only holds the header names,
+// see IncomingMessage.prototype._addLazyHeaderLines().
 function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
                                  url, statusCode, statusMessage, upgrade,
-                                 shouldKeepAlive) {
+                                 shouldKeepAlive, headerValues) {
   const parser = this;
   const { socket } = parser;
 
@@ -106,13 +109,16 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
     incoming.socket[kRequestTimeout] = undefined;
   }
 
-  let n = headers.length;
+  let n = headerValues === undefined ? headers.length : headers.length * 2;
 
   // If parser.maxHeaderPairs <= 0 assume that there's no limit.
   if (parser.maxHeaderPairs > 0)
     n = MathMin(n, parser.maxHeaderPairs);
 
-  incoming._addHeaderLines(headers, n);
+  if (headerValues === undefined)
+    incoming._addHeaderLines(headers, n);
+  else
+    incoming._addLazyHeaderLines(headers, headerValues, n);
 
   if (typeof method === 'number') {
     // server only
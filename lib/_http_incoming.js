@@ -24,13 +24,17 @@
 const {
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
-  Symbol
+  Symbol,
+  Uint32Array,
 } = primordials;
 
 const Stream = require('stream');
 
 const kHeaders = Symbol('kHeaders');
 const kHeadersCount = Symbol('kHeadersCount');
+const kRawHeaders = Symbol('kRawHeaders');
+const kHeaderNames = Symbol('kHeaderNames');
+const kHeaderValues = Symbol('kHeaderValues');
 const kTrailers = Symbol('kTrailers');
 const kTrailersCount = Symbol('kTrailersCount');
 
@@ -66,7 +70,9 @@ function IncomingMessage(socket) {
   this.complete = false;
   this[kHeaders] = null;
   this[kHeadersCount] = 0;
-  this.rawHeaders = [];
+  this[kRawHeaders] = [];
+  this[kHeaderNames] = null;
+  this[kHeaderValues] = null;
   this[kTrailers] = null;
   this[kTrailersCount] = 0;
   this.rawTrailers = [];
@@ -120,6 +126,33 @@ ObjectDefineProperty(IncomingMessage.prototype, 'headers', {
   }
 });
 
+// Headers passed in by _addLazyHeaderLines() are only turned into strings
+// once rawHeaders or headers is accessed.
+ObjectDefineProperty(IncomingMessage.prototype, 'rawHeaders', {
+  get: function() {
+    const values = this[kHeaderValues];
+    if (values) {
+      const names = this[kHeaderNames];
+      const offsets = new Uint32Array(values.buffer, values.byteOffset,
+                                      names.length + 1);
+      const raw = [];
+      for (let i = 0; i < names.length; i++) {
+        raw[i * 2] = names[i];
+        raw[i * 2 + 1] = values.latin1Slice(offsets[i], offsets[i + 1]);
+      }
+      this[kRawHeaders] = raw;
+      this[kHeaderNames] = null;
+      this[kHeaderValues] = null;
+    }
+    return this[kRawHeaders];
+  },
+  set: function(val) {
+    this[kRawHeaders] = val;
+    this[kHeaderNames] = null;
+    this[kHeaderValues] = null;
+  }
+});
+
 ObjectDefineProperty(IncomingMessage.prototype, 'trailers', {
   get: function() {
     if (!this[kTrailers]) {
@@ -195,6 +228,41 @@ function _addHeaderLines(headers, n) {
   }
 }
 
+IncomingMessage.prototype._addLazyHeaderLines = _addLazyHeaderLines;
+function _addLazyHeaderLines(names, values, n) {
+  if (names.length) {
+    this[kRawHeaders] = null;
+    this[kHeaderNames] = names;
+    this[kHeaderValues] = values;
+    this[kHeadersCount] = n;
+  }
+}
+
+
+// Returns what `msg.headers[name]` would, for a lower case `name`, without
+// creating strings for the values of any other headers.
+function getIncomingHeader(msg, name) {
+  const values = msg[kHeaderValues];
+  if (msg[kHeaders] || !values)
+    return msg.headers[name];
+
+  const names = msg[kHeaderNames];
+  const offsets = new Uint32Array(values.buffer, values.byteOffset,
+                                  names.length + 1);
+  let dest;
+  for (let i = 0; i * 2 < msg[kHeadersCount]; i++) {
+    const field = names[i];
+    if (field.length === name.length && field.toLowerCase() === name) {
+      if (dest === undefined)
+        dest = {};
+      msg._addHeaderLine(field,
+                         values.latin1Slice(offsets[i], offsets[i + 1]),
+                         dest);
+    }
+  }
+  return dest === undefined ? undefined : dest[name];
+}
+
 
 // This function is used to help avoid the lowercasing of a field name if it
 // matches a 'traditional cased' version of a field name. It then returns the
@@ -351,6 +419,7 @@ IncomingMessage.prototype._dump = function _dump() {
 
 module.exports = {
   IncomingMessage,
+  getIncomingHeader,
   readStart,
   readStop
 };
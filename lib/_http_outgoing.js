@@ -38,6 +38,7 @@ const EE = require('events');
 const Stream = require('stream');
 const internalUtil = require('internal/util');
 const { kOutHeaders, utcDate, kNeedDrain } = require('internal/http');
+const { serializeHead } = internalBinding('http_parser');
 const { Buffer } = require('buffer');
 const common = require('_http_common');
 const checkIsHttpToken = common._checkIsHttpToken;
@@ -71,6 +72,7 @@ const HIGH_WATER_MARK = getDefaultHighWaterMark();
 const { CRLF, debug } = common;
 
 const kCorked = Symbol('corked');
+const kHeader = Symbol('kHeader');
 
 function nop() {}
 
@@ -123,7 +125,7 @@ function OutgoingMessage() {
   this._closed = false;
 
   this.socket = null;
-  this._header = null;
+  this[kHeader] = null;
   this[kOutHeaders] = null;
 
   this._keepAliveTimeout = 0;
@@ -233,7 +235,7 @@ ObjectDefineProperty(OutgoingMessage.prototype, '_headerNames', {
 
 
 OutgoingMessage.prototype._renderHeaders = function _renderHeaders() {
-  if (this._header) {
+  if (this[kHeader]) {
     throw new ERR_HTTP_HEADERS_SENT('render');
   }
 
@@ -312,11 +314,15 @@ OutgoingMessage.prototype._send = function _send(data, encoding, callback) {
   // the same packet. Future versions of Node are going to take care of
   // this at a lower level and in a more general way.
   if (!this._headerSent) {
-    if (typeof data === 'string' &&
-        (encoding === 'utf8' || encoding === 'latin1' || !encoding)) {
-      data = this._header + data;
+    const header = this[kHeader];
+    if (typeof data === 'string' && data.length === 0 &&
+        typeof header !== 'string') {
+      data = header;
+      encoding = null;
+    } else if (typeof data === 'string' && typeof header === 'string' &&
+               (encoding === 'utf8' || encoding === 'latin1' || !encoding)) {
+      data = header + data;
     } else {
-      const header = this._header;
       this.outputData.unshift({
         data: header,
         encoding: 'latin1',
@@ -372,7 +378,10 @@ function _storeHeader(firstLine, headers) {
     date: false,
     expect: false,
     trailer: false,
-    header: firstLine
+    // Flat list of names and values. Validation of the ones that need it is
+    // left to serializeHead().
+    fields: [],
+    validate: false,
   };
 
   if (headers) {
@@ -404,11 +413,11 @@ function _storeHeader(firstLine, headers) {
     }
   }
 
-  let { header } = state;
+  const { fields } = state;
 
   // Date header
   if (this.sendDate && !state.date) {
-    header += 'Date: ' + utcDate() + CRLF;
+    fields.push('Date', utcDate());
   }
 
   // Force the connection to close when the response is a 204 No Content or
@@ -438,14 +447,14 @@ function _storeHeader(firstLine, headers) {
     const shouldSendKeepAlive = this.shouldKeepAlive &&
         (state.contLen || this.useChunkedEncodingByDefault || this.agent);
     if (shouldSendKeepAlive) {
-      header += 'Connection: keep-alive\r\n';
+      fields.push('Connection', 'keep-alive');
       if (this._keepAliveTimeout && this._defaultKeepAlive) {
         const timeoutSeconds = MathFloor(this._keepAliveTimeout / 1000);
-        header += `Keep-Alive: timeout=${timeoutSeconds}\r\n`;
+        fields.push('Keep-Alive', `timeout=${timeoutSeconds}`);
       }
     } else {
       this._last = true;
-      header += 'Connection: close\r\n';
+      fields.push('Connection', 'close');
     }
   }
 
@@ -458,9 +467,9 @@ function _storeHeader(firstLine, headers) {
     } else if (!state.trailer &&
                !this._removedContLen &&
                typeof this._contentLength === 'number') {
-      header += 'Content-Length: ' + this._contentLength + CRLF;
+      fields.push('Content-Length', '' + this._contentLength);
     } else if (!this._removedTE) {
-      header += 'Transfer-Encoding: chunked\r\n';
+      fields.push('Transfer-Encoding', 'chunked');
       this.chunkedEncoding = true;
     } else {
       // We should only be able to get here if both Content-Length and
@@ -478,7 +487,7 @@ function _storeHeader(firstLine, headers) {
     throw new ERR_HTTP_TRAILER_INVALID();
   }
 
-  this._header = header + CRLF;
+  this[kHeader] = renderHead(firstLine, fields, state.validate);
   this._headerSent = false;
 
   // Wait until the first body chunk, or close(), is sent to flush,
@@ -486,9 +495,36 @@ function _storeHeader(firstLine, headers) {
   if (state.expect) this._send('');
 }
 
+// Returns the head as a Buffer, or as a latin1 string if it contains
+// characters outside of US-ASCII. Before the native serializer existed, those
+// were sent UTF-8 encoded when the first chunk of the body was a string, so
+// they keep going through the string path.
+function renderHead(firstLine, fields, validate) {
+  const head = serializeHead(firstLine, fields);
+  if (typeof head !== 'number') {
+    if (head !== undefined)
+      return head;
+  } else if (validate) {
+    // Throw the same error as setHeader() would.
+    const name = fields[head * 2];
+    validateHeaderName(name);
+    validateHeaderValue(name, fields[head * 2 + 1]);
+  }
+
+  let header = firstLine;
+  for (let i = 0; i < fields.length; i += 2)
+    header += fields[i] + ': ' + fields[i + 1] + CRLF;
+  return header + CRLF;
+}
+
 function processHeader(self, state, key, value, validate) {
-  if (validate)
-    validateHeaderName(key);
+  if (validate) {
+    // The rest of the name is checked by serializeHead(), but the header
+    // matching below needs a string.
+    if (typeof key !== 'string')
+      validateHeaderName(key);
+    state.validate = true;
+  }
   if (ArrayIsArray(value)) {
     if (value.length < 2 || !isCookieField(key)) {
       // Retain for(;;) loop for performance reasons
@@ -503,9 +539,10 @@ function processHeader(self, state, key, value, validate) {
 }
 
 function storeHeader(self, state, key, value, validate) {
-  if (validate)
-    validateHeaderValue(key, value);
-  state.header += key + ': ' + value + CRLF;
+  // serializeHead() rejects anything but strings, which makes it catch
+  // missing values and names. Everything else is stringified like before.
+  state.fields.push(key, typeof value === 'string' || value === undefined ?
+    value : '' + value);
   matchHeader(self, state, key, value);
 }
 
@@ -559,7 +596,7 @@ const validateHeaderValue = hideStackFrames((name, value) => {
 });
 
 OutgoingMessage.prototype.setHeader = function setHeader(name, value) {
-  if (this._header) {
+  if (this[kHeader]) {
     throw new ERR_HTTP_HEADERS_SENT('set');
   }
   validateHeaderName(name);
@@ -619,7 +656,7 @@ OutgoingMessage.prototype.hasHeader = function hasHeader(name) {
 OutgoingMessage.prototype.removeHeader = function removeHeader(name) {
   validateString(name, 'name');
 
-  if (this._header) {
+  if (this[kHeader]) {
     throw new ERR_HTTP_HEADERS_SENT('remove');
   }
 
@@ -653,7 +690,22 @@ OutgoingMessage.prototype._implicitHeader = function _implicitHeader() {
 ObjectDefineProperty(OutgoingMessage.prototype, 'headersSent', {
   configurable: true,
   enumerable: true,
-  get: function() { return !!this._header; }
+  get: function() { return !!this[kHeader]; }
+});
+
+// The head is usually serialized into a Buffer by _storeHeader(). It is only
+// turned into a string for code that looks at _header itself.
+ObjectDefineProperty(OutgoingMessage.prototype, '_header', {
+  configurable: true,
+  get: function() {
+    const header = this[kHeader];
+    if (isUint8Array(header))
+      return header.latin1Slice(0, header.length);
+    return header;
+  },
+  set: function(val) {
+    this[kHeader] = val;
+  }
 });
 
 ObjectDefineProperty(OutgoingMessage.prototype, 'writableEnded', {
@@ -728,7 +780,7 @@ function write_(msg, chunk, encoding, callback, fromEnd) {
     return false;
   }
 
-  if (!msg._header) {
+  if (!msg[kHeader]) {
     if (fromEnd) {
       msg._contentLength = len;
     }
@@ -830,7 +882,7 @@ OutgoingMessage.prototype.end = function end(chunk, encoding, callback) {
       }
     }
     return this;
-  } else if (!this._header) {
+  } else if (!this[kHeader]) {
     this._contentLength = 0;
     this._implicitHeader();
   }
@@ -941,7 +993,7 @@ OutgoingMessage.prototype._flushOutput = function _flushOutput(socket) {
 
 
 OutgoingMessage.prototype.flushHeaders = function flushHeaders() {
-  if (!this._header) {
+  if (!this[kHeader]) {
     this._implicitHeader();
   }
 
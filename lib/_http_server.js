@@ -57,7 +57,10 @@ const {
   defaultTriggerAsyncIdScope,
   getOrSetAsyncId
 } = require('internal/async_hooks');
-const { IncomingMessage } = require('_http_incoming');
+const {
+  IncomingMessage,
+  getIncomingHeader,
+} = require('_http_incoming');
 const {
   connResetException,
   codes
@@ -178,7 +181,8 @@ function ServerResponse(req) {
   this._expect_continue = false;
 
   if (req.httpVersionMajor < 1 || req.httpVersionMinor < 1) {
-    this.useChunkedEncodingByDefault = chunkExpression.test(req.headers.te);
+    this.useChunkedEncodingByDefault =
+      chunkExpression.test(getIncomingHeader(req, 'te'));
     this.shouldKeepAlive = false;
   }
 
@@ -302,7 +306,7 @@ function writeHead(statusCode, reason, obj) {
         if (k) this.setHeader(k, obj[k]);
       }
     }
-    if (k === undefined && this._header) {
+    if (k === undefined && this.headersSent) {
       throw new ERR_HTTP_HEADERS_SENT('render');
     }
     // Only progressive api is used
@@ -454,6 +458,7 @@ function connectionListenerInternal(server, socket) {
     server.insecureHTTPParser === undefined ?
       isLenient() : server.insecureHTTPParser,
     server.headersTimeout || 0,
+    true,  // lazyHeaders
   );
   parser.socket = socket;
   socket.parser = parser;
@@ -896,9 +901,10 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
   res.on('finish',
          resOnFinish.bind(undefined, req, res, socket, state, server));
 
-  if (req.headers.expect !== undefined &&
+  const expect = getIncomingHeader(req, 'expect');
+  if (expect !== undefined &&
       (req.httpVersionMajor === 1 && req.httpVersionMinor === 1)) {
-    if (continueExpression.test(req.headers.expect)) {
+    if (continueExpression.test(expect)) {
       res._expect_continue = true;
 
       if (server.listenerCount('checkContinue') > 0) {
@@ -91,6 +91,7 @@ const kHandshakeTimeout = Symbol('handshake-timeout');
 const kRes = Symbol('res');
 const kSNICallback = Symbol('snicallback');
 const kEnableTrace = Symbol('enableTrace');
+const kKernelTLS = Symbol('kernelTLS');
 const kPskCallback = Symbol('pskcallback');
 const kPskIdentityHint = Symbol('pskidentityhint');
 const kPendingSession = Symbol('pendingSession');
@@ -460,6 +461,12 @@ function TLSSocket(socket, opts) {
       'options.enableTrace', 'boolean', enableTrace);
   }
 
+  if (tlsOptions.kernelTLS != null &&
+      typeof tlsOptions.kernelTLS !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE(
+      'options.kernelTLS', 'boolean', tlsOptions.kernelTLS);
+  }
+
   if (tlsOptions.ALPNProtocols)
     tls.convertALPNProtocols(tlsOptions.ALPNProtocols, tlsOptions);
 
@@ -790,6 +797,9 @@ TLSSocket.prototype._init = function(socket, wrap) {
   }
 
 
+  if (options.kernelTLS && ssl.enableKernelTLS)
+    ssl.enableKernelTLS();
+
   if (options.handshakeTimeout > 0)
     this.setTimeout(options.handshakeTimeout, this._handleTimeout);
 
@@ -1007,6 +1017,7 @@ function makeSocketMethodProxy(name) {
   'getProtocol',
   'getSession',
   'getTLSTicket',
+  'isKernelTLSActive',
   'isSessionReused',
   'enableTrace',
 ].forEach((method) => {
@@ -1073,6 +1084,7 @@ function tlsConnectionListener(rawSocket) {
     ALPNProtocols: this.ALPNProtocols,
     SNICallback: this[kSNICallback] || SNICallback,
     enableTrace: this[kEnableTrace],
+    kernelTLS: this[kKernelTLS],
     pauseOnConnect: this.pauseOnConnect,
     pskCallback: this[kPskCallback],
     pskIdentityHint: this[kPskIdentityHint],
@@ -1216,6 +1228,7 @@ function Server(options, listener) {
   }
 
   this[kEnableTrace] = options.enableTrace;
+  this[kKernelTLS] = options.kernelTLS;
 }
 
 ObjectSetPrototypeOf(Server.prototype, net.Server.prototype);
@@ -1591,6 +1604,7 @@ exports.connect = function connect(...args) {
     ALPNProtocols: options.ALPNProtocols,
     requestOCSP: options.requestOCSP,
     enableTrace: options.enableTrace,
+    kernelTLS: options.kernelTLS,
     pskCallback: options.pskCallback,
     highWaterMark: options.highWaterMark,
     onread: options.onread,
@@ -95,6 +95,8 @@ const {
   publicDecrypt,
   publicEncrypt,
   getCipherInfo,
+  aeadDecryptBatch,
+  aeadEncryptBatch,
 } = require('internal/crypto/cipher');
 const {
   Sign,
@@ -104,7 +106,9 @@ const {
 } = require('internal/crypto/sig');
 const {
   Hash,
-  Hmac
+  Hmac,
+  hashBatch,
+  hashBatchSync,
 } = require('internal/crypto/hash');
 const {
   getCiphers,
@@ -165,6 +169,8 @@ function createVerify(algorithm, options) {
 
 module.exports = {
   // Methods
+  aeadDecryptBatch,
+  aeadEncryptBatch,
   createCipheriv,
   createDecipheriv,
   createDiffieHellman,
@@ -183,6 +189,8 @@ module.exports = {
   getCurves,
   getDiffieHellman: createDiffieHellmanGroup,
   getHashes,
+  hashBatch,
+  hashBatchSync,
   hkdf,
   hkdfSync,
   pbkdf2,
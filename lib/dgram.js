@@ -63,7 +63,7 @@ const {
 const { UV_UDP_REUSEADDR } = internalBinding('constants').os;
 
 const {
-  constants: { UV_UDP_IPV6ONLY },
+  constants: { UV_UDP_IPV6ONLY, UV_UDP_RECVMMSG },
   UDP,
   SendWrap
 } = internalBinding('udp_wrap');
@@ -91,6 +91,7 @@ function Socket(type, listener) {
   let lookup;
   let recvBufferSize;
   let sendBufferSize;
+  let recvBatch = false;
 
   let options;
   if (type !== null && typeof type === 'object') {
@@ -99,9 +100,10 @@ function Socket(type, listener) {
     lookup = options.lookup;
     recvBufferSize = options.recvBufferSize;
     sendBufferSize = options.sendBufferSize;
+    recvBatch = !!options.recvBatch;
   }
 
-  const handle = newHandle(type, lookup);
+  const handle = newHandle(type, lookup, recvBatch ? UV_UDP_RECVMMSG : 0);
   handle[owner_symbol] = this;
 
   this[async_id_symbol] = handle.getAsyncId();
@@ -119,7 +121,8 @@ function Socket(type, listener) {
     reuseAddr: options && options.reuseAddr, // Use UV_UDP_REUSEADDR if true.
     ipv6Only: options && options.ipv6Only,
     recvBufferSize,
-    sendBufferSize
+    sendBufferSize,
+    recvBatch
   };
 }
 ObjectSetPrototypeOf(Socket.prototype, EventEmitter.prototype);
@@ -134,7 +137,7 @@ function createSocket(type, listener) {
 function startListening(socket) {
   const state = socket[kStateSymbol];
 
-  state.handle.onmessage = onMessage;
+  state.handle.onmessage = state.recvBatch ? onMessageBatch : onMessage;
   // Todo: handle errors
   state.handle.recvStart();
   state.receiving = true;
@@ -157,6 +160,7 @@ function replaceHandle(self, newHandle) {
   newHandle.lookup = oldHandle.lookup;
   newHandle.bind = oldHandle.bind;
   newHandle.send = oldHandle.send;
+  newHandle.sendBatch = oldHandle.sendBatch;
   newHandle[owner_symbol] = self;
 
   // Replace the existing handle by the handle we got from master.
@@ -694,6 +698,127 @@ function doSend(ex, self, ip, list, address, port, callback) {
   }
 }
 
+Socket.prototype.sendBatch = function(msgs, port, address, callback) {
+  const state = this[kStateSymbol];
+  const connected = state.connectState === CONNECT_STATE_CONNECTED;
+
+  if (typeof port === 'function') {
+    callback = port;
+    port = undefined;
+    address = undefined;
+  } else if (typeof address === 'function') {
+    callback = address;
+    address = undefined;
+  }
+
+  if (connected) {
+    if (port || address)
+      throw new ERR_SOCKET_DGRAM_IS_CONNECTED();
+  } else {
+    port = validatePort(port, 'Port', { allowZero: false });
+  }
+
+  if (address && typeof address !== 'string')
+    throw new ERR_INVALID_ARG_TYPE('address', ['string', 'falsy'], address);
+
+  if (!ArrayIsArray(msgs))
+    throw new ERR_INVALID_ARG_TYPE('msgs', 'Array', msgs);
+
+  const list = new Array(msgs.length);
+  for (let i = 0; i < msgs.length; i++) {
+    const msg = msgs[i];
+    if (typeof msg === 'string') {
+      list[i] = Buffer.from(msg);
+    } else if (isArrayBufferView(msg)) {
+      list[i] = msg;
+    } else {
+      throw new ERR_INVALID_ARG_TYPE(`msgs[${i}]`,
+                                     ['Buffer',
+                                      'TypedArray',
+                                      'DataView',
+                                      'string'],
+                                     msg);
+    }
+  }
+
+  if (typeof callback !== 'function')
+    callback = undefined;
+
+  healthCheck(this);
+
+  if (state.bindState === BIND_STATE_UNBOUND)
+    this.bind({ port: 0, exclusive: true }, null);
+
+  if (state.bindState !== BIND_STATE_BOUND) {
+    enqueue(this, this.sendBatch.bind(this, list, port, address, callback));
+    return;
+  }
+
+  const afterDns = (ex, ip) => {
+    defaultTriggerAsyncIdScope(
+      this[async_id_symbol],
+      doSendBatch,
+      ex, this, ip, list, address, port, callback
+    );
+  };
+
+  if (!connected) {
+    state.handle.lookup(address, afterDns);
+  } else {
+    afterDns(null, null);
+  }
+};
+
+function doSendBatch(ex, self, ip, list, address, port, callback) {
+  const state = self[kStateSymbol];
+
+  if (ex) {
+    if (typeof callback === 'function') {
+      process.nextTick(callback, ex);
+      return;
+    }
+
+    process.nextTick(() => self.emit('error', ex));
+    return;
+  } else if (!state.handle) {
+    return;
+  }
+
+  let sent;
+  if (port)
+    sent = state.handle.sendBatch(list, list.length, port, ip);
+  else
+    sent = state.handle.sendBatch(list, list.length);
+
+  if (sent < 0) {
+    // Don't emit as error, same as send().
+    if (callback)
+      process.nextTick(callback, exceptionWithHostPort(sent, 'send',
+                                                       address, port));
+    return;
+  }
+
+  if (sent === list.length) {
+    if (callback)
+      process.nextTick(callback, null);
+    return;
+  }
+
+  // The socket would block. Queue the remaining datagrams one by one; libuv
+  // flushes its send queue with sendmmsg() as well once the socket is
+  // writable again.
+  let pending = list.length - sent;
+  let error = null;
+  const afterBatchSend = callback && ((err) => {
+    if (err && error === null)
+      error = err;
+    if (--pending === 0)
+      callback(error);
+  });
+  for (let i = sent; i < list.length; i++)
+    doSend(null, self, ip, [list[i]], address, port, afterBatchSend);
+}
+
 function afterSend(err, sent) {
   if (err) {
     err = exceptionWithHostPort(err, 'send', this.address, this.port);
@@ -910,6 +1035,28 @@ function stopReceiving(socket) {
 }
 
 
+function onMessageBatch(nread, handle, buf, rinfos) {
+  const self = handle[owner_symbol];
+  if (nread < 0) {
+    return self.emit('error', errnoException(nread, 'recvmmsg'));
+  }
+  // Handles created without UV_UDP_RECVMMSG, like the ones shared by the
+  // cluster primary, still report one datagram at a time.
+  if (!ArrayIsArray(rinfos)) {
+    rinfos.size = buf.length;
+    return self.emit('messages', [buf], [rinfos]);
+  }
+  const msgs = new Array(nread);
+  let offset = 0;
+  for (let i = 0; i < nread; i++) {
+    const end = offset + rinfos[i].size;
+    msgs[i] = buf.slice(offset, end);
+    offset = end;
+  }
+  self.emit('messages', msgs, rinfos);
+}
+
+
 function onMessage(nread, handle, buf, rinfo) {
   const self = handle[owner_symbol];
   if (nread < 0) {
@@ -323,18 +323,33 @@ function readFileAfterStat(err, stats) {
   context.read();
 }
 
+function readFileAfterReadFile(err, data) {
+  const { callback, signal } = this.context;
+
+  if (err)
+    return callback(err);
+
+  if (signal && signal.aborted) {
+    return callback(
+      lazyDOMException('The operation was aborted', 'AbortError'));
+  }
+
+  callback(null, data);
+}
+
 function readFile(path, options, callback) {
   callback = maybeCallback(callback || options);
   options = getOptions(options, { flag: 'r' });
-  if (!ReadFileContext)
-    ReadFileContext = require('internal/fs/read_file_context');
-  const context = new ReadFileContext(callback, options.encoding);
-  context.isUserFd = isFd(path); // File descriptor ownership
 
-  if (options.signal) {
-    context.signal = options.signal;
-  }
-  if (context.isUserFd) {
+  if (isFd(path)) {
+    if (!ReadFileContext)
+      ReadFileContext = require('internal/fs/read_file_context');
+    const context = new ReadFileContext(callback, options.encoding);
+    context.isUserFd = true; // File descriptor ownership
+
+    if (options.signal) {
+      context.signal = options.signal;
+    }
     process.nextTick(function tick(context) {
       ReflectApply(readFileAfterOpen, { context }, [null, path]);
     }, context);
@@ -344,13 +359,14 @@ function readFile(path, options, callback) {
   const flagsNumber = stringToFlags(options.flag);
   path = getValidatedPath(path);
 
+  // The file is opened, read and closed by a single thread pool task.
   const req = new FSReqCallback();
-  req.context = context;
-  req.oncomplete = readFileAfterOpen;
-  binding.open(pathModule.toNamespacedPath(path),
-               flagsNumber,
-               0o666,
-               req);
+  req.context = { callback, signal: options.signal };
+  req.oncomplete = readFileAfterReadFile;
+  binding.readFile(pathModule.toNamespacedPath(path),
+                   flagsNumber,
+                   options.encoding,
+                   req);
 }
 
 function tryStatSync(fd, isUserFd) {
@@ -89,11 +89,15 @@ const rawMethods = internalBinding('process_methods');
   process._recordReplaySetCDPMessageCallback = rawMethods.recordReplaySetCDPMessageCallback;
   process._recordReplaySendCDPMessage = rawMethods.recordReplaySendCDPMessage;
   process._recordReplayGetCurrentError = rawMethods.recordReplayGetCurrentError;
+  process._recordReplayGetCurrentConsoleArguments =
+    rawMethods.recordReplayGetCurrentConsoleArguments;
 
   const wrapped = perThreadSetup.wrapProcessMethods(rawMethods);
   process._rawDebug = wrapped._rawDebug;
   process.cpuUsage = wrapped.cpuUsage;
   process.resourceUsage = wrapped.resourceUsage;
+  process.threadpoolUsage = wrapped.threadpoolUsage;
+  process.recordReplayCheckpointStats = wrapped.recordReplayCheckpointStats;
   process.memoryUsage = wrapped.memoryUsage;
   process.kill = wrapped.kill;
   process.exit = wrapped.exit;
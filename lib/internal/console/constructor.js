@@ -354,10 +354,11 @@ function createWriteErrorHandler(instance, streamSymbol) {
 }
 
 // Note: the "this" value for this call is the console message arguments,
-// which Target_getCurrentMessageContents will read via the inspector.
+// which are passed through to the driver so that
+// Target_getCurrentMessageContents can read them without using the inspector.
 function onConsoleMessage() {
   if (process.isRecordingOrReplaying()) {
-    process.recordReplayOnConsoleAPI();
+    process.recordReplayOnConsoleAPI(this);
   }
 }
 
@@ -1,18 +1,25 @@
 'use strict';
 
 const {
+  ArrayPrototypePush,
+  FunctionPrototypeCall,
   ObjectSetPrototypeOf,
   ReflectApply,
   StringPrototypeToLowerCase,
 } = primordials;
 
 const {
+  AeadBatchJob,
   CipherBase,
   privateDecrypt: _privateDecrypt,
   privateEncrypt: _privateEncrypt,
   publicDecrypt: _publicDecrypt,
   publicEncrypt: _publicEncrypt,
   getCipherInfo: _getCipherInfo,
+  kCryptoJobAsync,
+  kCryptoJobSync,
+  kWebCryptoCipherDecrypt,
+  kWebCryptoCipherEncrypt,
 } = internalBinding('crypto');
 
 const {
@@ -27,14 +34,18 @@ const {
     ERR_CRYPTO_INVALID_STATE,
     ERR_INVALID_ARG_TYPE,
     ERR_INVALID_ARG_VALUE,
+    ERR_INVALID_CALLBACK,
+    ERR_OUT_OF_RANGE,
   }
 } = require('internal/errors');
 
 const {
+  validateArray,
   validateEncoding,
   validateInt32,
   validateObject,
   validateString,
+  validateUint32,
 } = require('internal/validators');
 
 const {
@@ -51,9 +62,12 @@ const {
 } = require('internal/crypto/util');
 
 const {
+  isAnyArrayBuffer,
   isArrayBufferView,
 } = require('internal/util/types');
 
+const { FastBuffer } = require('internal/buffer');
+
 const assert = require('internal/assert');
 
 const LazyTransform = require('internal/streams/lazy_transform');
@@ -323,6 +337,109 @@ function getCipherInfo(nameOrNid, options) {
   return ret;
 }
 
+// Batches of AEAD messages whose inputs are no larger than this in total are
+// processed on the main thread, as that is cheaper than a threadpool task.
+const kAeadBatchSyncLimit = 64 * 1024;
+
+const kEmptyBuffer = new FastBuffer();
+
+function aeadBatch(cipherMode, algorithm, key, messages, output, options,
+                   callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
+  if (typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  validateString(algorithm, 'algorithm');
+  key = prepareSecretKey(key);
+  validateArray(messages, 'messages');
+  if (!isAnyArrayBuffer(output) && !isArrayBufferView(output)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'output',
+      ['ArrayBuffer', 'Buffer', 'TypedArray', 'DataView'],
+      output);
+  }
+  if (options !== undefined)
+    validateObject(options, 'options');
+  const { authTagLength = 16, outputOffset = 0 } = options || {};
+  validateUint32(authTagLength, 'options.authTagLength');
+  validateUint32(outputOffset, 'options.outputOffset');
+
+  const encrypt = cipherMode === kWebCryptoCipherEncrypt;
+  const field = encrypt ? 'plaintext' : 'ciphertext';
+  const ivs = [];
+  const aads = [];
+  const inputs = [];
+  let inputLength = 0;
+  let outputLength = 0;
+  for (let i = 0; i < messages.length; i++) {
+    const message = messages[i];
+    validateObject(message, `messages[${i}]`);
+    const { iv, aad } = message;
+    ArrayPrototypePush(ivs, getArrayBufferOrView(iv, `messages[${i}].iv`));
+    ArrayPrototypePush(aads, aad === undefined ? kEmptyBuffer :
+      getArrayBufferOrView(aad, `messages[${i}].aad`));
+    const data = getArrayBufferOrView(message[field],
+                                      `messages[${i}].${field}`);
+    ArrayPrototypePush(inputs, data);
+    inputLength += data.byteLength;
+    if (encrypt) {
+      outputLength += data.byteLength + authTagLength;
+    } else {
+      // The authentication tag follows the ciphertext.
+      if (data.byteLength < authTagLength) {
+        throw new ERR_INVALID_ARG_VALUE(
+          `messages[${i}].ciphertext`, data,
+          'must end with the authentication tag');
+      }
+      outputLength += data.byteLength - authTagLength;
+    }
+  }
+  if (outputOffset + outputLength > output.byteLength) {
+    throw new ERR_OUT_OF_RANGE(
+      'output.byteLength', `>= ${outputOffset + outputLength}`,
+      output.byteLength);
+  }
+
+  const mode =
+    inputLength <= kAeadBatchSyncLimit ? kCryptoJobSync : kCryptoJobAsync;
+  const job = new AeadBatchJob(mode, cipherMode, algorithm, key, ivs, aads,
+                               inputs, authTagLength, output, outputOffset);
+  const ondone = (err, index) => {
+    if (err !== undefined) {
+      // The message that failed to authenticate, if any.
+      if (index !== undefined)
+        err.index = index;
+      return FunctionPrototypeCall(callback, job, err);
+    }
+    FunctionPrototypeCall(callback, job, null, outputLength);
+  };
+
+  if (mode === kCryptoJobAsync) {
+    // Keeps the output alive while the job writes into it.
+    job.output = output;
+    job.ondone = ondone;
+    job.run();
+  } else {
+    const [err, index] = job.run();
+    process.nextTick(ondone, err, index);
+  }
+}
+
+function aeadEncryptBatch(algorithm, key, messages, output, options,
+                          callback) {
+  aeadBatch(kWebCryptoCipherEncrypt, algorithm, key, messages, output,
+            options, callback);
+}
+
+function aeadDecryptBatch(algorithm, key, messages, output, options,
+                          callback) {
+  aeadBatch(kWebCryptoCipherDecrypt, algorithm, key, messages, output,
+            options, callback);
+}
+
 module.exports = {
   Cipher,
   Cipheriv,
@@ -333,4 +450,6 @@ module.exports = {
   publicDecrypt,
   publicEncrypt,
   getCipherInfo,
+  aeadDecryptBatch,
+  aeadEncryptBatch,
 };
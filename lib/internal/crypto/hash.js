@@ -1,6 +1,8 @@
 'use strict';
 
 const {
+  ArrayPrototypeMap,
+  FunctionPrototypeCall,
   ObjectSetPrototypeOf,
   ReflectApply,
   Symbol,
@@ -9,8 +11,10 @@ const {
 const {
   Hash: _Hash,
   HashJob,
+  HashBatchJob,
   Hmac: _Hmac,
   kCryptoJobAsync,
+  kCryptoJobSync,
 } = internalBinding('crypto');
 
 const {
@@ -37,11 +41,14 @@ const {
     ERR_CRYPTO_HASH_FINALIZED,
     ERR_CRYPTO_HASH_UPDATE_FAILED,
     ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_CALLBACK,
   }
 } = require('internal/errors');
 
 const {
+  validateArray,
   validateEncoding,
+  validateObject,
   validateString,
   validateUint32,
 } = require('internal/validators');
@@ -178,8 +185,58 @@ async function asyncDigest(algorithm, data) {
     algorithm.length));
 }
 
+// Digests or HMACs of many inputs, computed in one native call or threadpool
+// task and returned back to back in one buffer.
+
+function createHashBatchJob(mode, algorithm, inputs, options = {}) {
+  validateString(algorithm, 'algorithm');
+  validateArray(inputs, 'inputs');
+  validateObject(options, 'options');
+  const { key, outputLength } = options;
+  if (outputLength !== undefined)
+    validateUint32(outputLength, 'options.outputLength');
+  inputs = ArrayPrototypeMap(inputs, (input, i) => {
+    const data = getArrayBufferOrView(input, `inputs[${i}]`);
+    validateMaxBufferLength(data, `inputs[${i}]`);
+    return data;
+  });
+  return new HashBatchJob(
+    mode,
+    algorithm,
+    inputs,
+    key === undefined ? undefined : prepareSecretKey(key),
+    outputLength);
+}
+
+function hashBatch(algorithm, inputs, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
+  if (typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  const job = createHashBatchJob(kCryptoJobAsync, algorithm, inputs, options);
+  job.ondone = (err, result) => {
+    if (err !== undefined)
+      return FunctionPrototypeCall(callback, job, err);
+    FunctionPrototypeCall(callback, job, null, Buffer.from(result));
+  };
+  job.run();
+}
+
+function hashBatchSync(algorithm, inputs, options) {
+  const job = createHashBatchJob(kCryptoJobSync, algorithm, inputs, options);
+  const [err, result] = job.run();
+  if (err !== undefined)
+    throw err;
+  return Buffer.from(result);
+}
+
 module.exports = {
   Hash,
   Hmac,
   asyncDigest,
+  hashBatch,
+  hashBatchSync,
 };
@@ -423,6 +423,9 @@ function makeTextDecoderICU() {
       if (typeof ret === 'number') {
         throw new ERR_ENCODING_INVALID_ENCODED_DATA(this.encoding, ret);
       }
+      // Valid UTF-8 is returned as a string right away.
+      if (typeof ret === 'string')
+        return ret;
       return ret.toString('ucs2');
     }
   }
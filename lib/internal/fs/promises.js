@@ -677,8 +677,23 @@ async function readFile(path, options) {
   if (path instanceof FileHandle)
     return readFileHandle(path, options);
 
-  const fd = await open(path, flag, 0o666);
-  return PromisePrototypeFinally(readFileHandle(fd, options), fd.close);
+  const signal = options.signal;
+  if (signal && signal.aborted) {
+    throw lazyDOMException('The operation was aborted', 'AbortError');
+  }
+
+  // The file is opened, read and closed by a single thread pool task.
+  path = getValidatedPath(path);
+  const result = await binding.readFile(pathModule.toNamespacedPath(path),
+                                        stringToFlags(flag),
+                                        options.encoding,
+                                        kUsePromises);
+
+  if (signal && signal.aborted) {
+    throw lazyDOMException('The operation was aborted', 'AbortError');
+  }
+
+  return result;
 }
 
 module.exports = {
@@ -2,6 +2,7 @@
 
 const {
   Array,
+  FunctionPrototypeCall,
   MathMin,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
@@ -10,9 +11,12 @@ const {
 } = primordials;
 
 const {
-  ERR_INVALID_ARG_TYPE,
-  ERR_OUT_OF_RANGE
-} = require('internal/errors').codes;
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_OUT_OF_RANGE
+  },
+  errnoException,
+} = require('internal/errors');
 const { deprecate } = require('internal/util');
 const { validateInteger } = require('internal/validators');
 const { errorOrDestroy } = require('internal/streams/destroy');
@@ -26,9 +30,14 @@ const { Readable, Writable, finished } = require('stream');
 const { toPathIfFileURL } = require('internal/url');
 const kIoDone = Symbol('kIoDone');
 const kIsPerformingIO = Symbol('kIsPerformingIO');
+const kSocketPipe = Symbol('kSocketPipe');
 
 const kFs = Symbol('kFs');
 
+// Lazily loaded, only needed when piping into sockets.
+let net;
+let socketPipeBindings;
+
 function _construct(callback) {
   const stream = this;
   if (typeof stream.fd === 'number') {
@@ -168,6 +177,12 @@ ReadStream.prototype.open = openReadFs;
 ReadStream.prototype._construct = _construct;
 
 ReadStream.prototype._read = function(n) {
+  // Reading resumes once the native transfer into a socket is over.
+  if (this[kSocketPipe]) {
+    this[kSocketPipe].readSize = n;
+    return;
+  }
+
   n = this.pos !== undefined ?
     MathMin(this.end - this.pos + 1, n) :
     MathMin(this.end - this.bytesRead + 1, n);
@@ -215,7 +230,185 @@ ReadStream.prototype._read = function(n) {
   }
 };
 
+// Whether `stream` is a net.Socket that the file can be sent to by the
+// native layer directly, without going through JS.
+function isIdleSocket(stream) {
+  if (net === undefined)
+    net = require('net');
+  if (!(stream instanceof net.Socket) ||
+      stream === process.stdout ||
+      stream === process.stderr ||
+      stream.connecting ||
+      !stream.writable ||
+      stream.writableLength !== 0 ||
+      stream.writableCorked !== 0) {
+    return false;
+  }
+  if (socketPipeBindings === undefined) {
+    const { kReadBytesOrError, streamBaseState } =
+      internalBinding('stream_wrap');
+    socketPipeBindings = {
+      FileHandle: internalBinding('fs').FileHandle,
+      Pipe: internalBinding('pipe_wrap').Pipe,
+      StreamPipe: internalBinding('stream_pipe').StreamPipe,
+      TCP: internalBinding('tcp_wrap').TCP,
+      UV_EOF: internalBinding('uv').UV_EOF,
+      kReadBytesOrError,
+      streamBaseState
+    };
+  }
+  // TLS sockets have a TLSWrap handle and are not eligible.
+  const { Pipe, TCP } = socketPipeBindings;
+  return stream._handle instanceof TCP || stream._handle instanceof Pipe;
+}
+
+// Whether nothing has been read from `stream` yet and nothing would observe
+// the data on its way to the destination.
+function isPristine(stream) {
+  const state = stream._readableState;
+  return stream[kFs] === fs &&
+         stream.open === openReadFs &&
+         stream._read === ReadStream.prototype._read &&
+         !stream.destroyed &&
+         stream.bytesRead === 0 &&
+         state.length === 0 &&
+         state.pipes.length === 0 &&
+         state.flowing === null &&
+         !state.ended &&
+         !state.objectMode &&
+         state.decoder === null &&
+         stream.listenerCount('data') === 0 &&
+         stream.listenerCount('readable') === 0;
+}
+
+// Stops the native transfer of `stream` into a socket, if there is one, so
+// that the rest of the file is read through _read().
+function stopSocketPipe(stream) {
+  const socketPipe = stream[kSocketPipe];
+  if (!socketPipe)
+    return;
+  socketPipe.stopped = true;
+  if (socketPipe.pipe !== null)
+    socketPipe.pipe.unpipe();
+}
+
+function endSocketPipe(stream) {
+  const { readSize } = stream[kSocketPipe];
+  stream[kSocketPipe] = null;
+  if (readSize !== undefined && !stream.destroyed)
+    stream._read(readSize);
+}
+
+function pipeToSocket(src, dest) {
+  const socketPipe = src[kSocketPipe];
+  const state = src._readableState;
+  // Readable.prototype.pipe() only added its own 'data' listener.
+  if (socketPipe.stopped ||
+      src.destroyed ||
+      !isIdleSocket(dest) ||
+      state.pipes.length !== 1 ||
+      state.length !== 0 ||
+      src.listenerCount('data') !== 1 ||
+      src.listenerCount('readable') !== 0) {
+    endSocketPipe(src);
+    return;
+  }
+
+  const {
+    FileHandle,
+    StreamPipe,
+    UV_EOF,
+    kReadBytesOrError,
+    streamBaseState
+  } = socketPipeBindings;
+  const length = src.end === Infinity ?
+    -1 : src.end - (src.pos === undefined ? 0 : src.pos) + 1;
+  const handle =
+    new FileHandle(src.fd, src.pos === undefined ? -1 : src.pos, length);
+  let result = 0;
+  // Only EOF and errors make it here, the data itself goes to the pipe.
+  handle.onread = () => {
+    result = streamBaseState[kReadBytesOrError];
+  };
+
+  const pipe = new StreamPipe(handle, dest._handle);
+  pipe.onunpipe = () => {
+    const bytesRead = pipe.bytesPiped();
+    handle.releaseFD();
+    src[kIsPerformingIO] = false;
+    src.bytesRead += bytesRead;
+    if (src.pos !== undefined)
+      src.pos += bytesRead;
+
+    if (src.destroyed) {
+      src[kSocketPipe] = null;
+      src.emit(kIoDone);
+    } else if (result === UV_EOF) {
+      // Ends the socket through Readable.prototype.pipe(), if asked to.
+      src[kSocketPipe] = null;
+      src.push(null);
+    } else if (result < 0) {
+      src[kSocketPipe] = null;
+      dest.destroy(errnoException(result, 'sendfile'));
+      src.destroy();
+    } else {
+      // The stream was unpiped, or the socket went away. Either way, what
+      // is left of the file is read like it would have been without the
+      // native transfer.
+      endSocketPipe(src);
+    }
+  };
+
+  socketPipe.pipe = pipe;
+  src[kIsPerformingIO] = true;
+  // Readable.prototype.pipe() ends the socket, so the pipe must not shut it
+  // down.
+  pipe.start(false);
+}
+
+// Piping a file into a plain TCP or IPC socket is done natively, using
+// sendfile(2) where it is available, as long as no one else looks at the data.
+// Readable.prototype.pipe() still does the bookkeeping, so that unpiping and
+// ending the socket work the same either way; _read() is held back until the
+// native transfer is over.
+ReadStream.prototype.pipe = function(dest, pipeOpts) {
+  if (!isPristine(this) || !isIdleSocket(dest)) {
+    // Other destinations need to see the data too.
+    stopSocketPipe(this);
+    return FunctionPrototypeCall(Readable.prototype.pipe, this, dest, pipeOpts);
+  }
+
+  this[kSocketPipe] = { pipe: null, readSize: undefined, stopped: false };
+  const src = this;
+  dest.on('unpipe', function onunpipe(readable) {
+    if (readable !== src)
+      return;
+    dest.removeListener('unpipe', onunpipe);
+    stopSocketPipe(src);
+  });
+  FunctionPrototypeCall(Readable.prototype.pipe, this, dest, pipeOpts);
+
+  // Wait for the file to be opened; the socket might have become busy by
+  // then, in which case pipeToSocket() hands over to _read().
+  if (this.fd === null)
+    this.once('open', () => pipeToSocket(this, dest));
+  else
+    process.nextTick(pipeToSocket, this, dest);
+  return dest;
+};
+
+// Unlike `bytesRead`, which is only updated once a native transfer into a
+// socket is over, this includes what has been sent so far.
+ReadStream.prototype.getBytesRead = function() {
+  const socketPipe = this[kSocketPipe];
+  if (socketPipe && socketPipe.pipe !== null)
+    return this.bytesRead + socketPipe.pipe.bytesPiped();
+  return this.bytesRead;
+};
+
 ReadStream.prototype._destroy = function(err, cb) {
+  stopSocketPipe(this);
+
   // Usually for async IO it is safe to close a file descriptor
   // even when there are pending operations. However, due to platform
   // differences file IO is implemented using synchronous operations
@@ -102,6 +102,16 @@ const policy = getOptionValue('--experimental-policy') ?
   null;
 const { compileFunction } = internalBinding('contextify');
 
+// The compile cache is only loaded when it is enabled.
+let compileCache;
+function getCompileCache() {
+  if (compileCache === undefined) {
+    compileCache = safeGetenv('NODE_COMPILE_CACHE') ?
+      require('internal/modules/compile_cache') : null;
+  }
+  return compileCache;
+}
+
 // Whether any user-provided CJS modules had been loaded (executed).
 // Used for internal assertions.
 let hasLoadedAnyUserCJSModule = false;
@@ -1013,6 +1023,7 @@ function wrapSafe(filename, content, cjsModuleInstance) {
       },
     });
   }
+  const cacheEntry = getCompileCache()?.getCompileCacheEntry('cjs', content);
   let compiled;
   try {
     compiled = compileFunction(
@@ -1020,7 +1031,7 @@ function wrapSafe(filename, content, cjsModuleInstance) {
       filename,
       0,
       0,
-      undefined,
+      cacheEntry?.data,
       false,
       undefined,
       [],
@@ -1038,6 +1049,11 @@ function wrapSafe(filename, content, cjsModuleInstance) {
     throw err;
   }
 
+  if (cacheEntry !== undefined &&
+      (cacheEntry.data === undefined || compiled.cachedDataRejected)) {
+    compileCache.saveCompileCacheEntry(cacheEntry, compiled.function);
+  }
+
   const { callbackMap } = internalBinding('module_wrap');
   callbackMap.set(compiled.cacheKey, {
     importModuleDynamically: async (specifier) => {
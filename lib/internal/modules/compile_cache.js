@@ -0,0 +1,189 @@
+'use strict';
+
+// An opt-in cache of V8 code cache data for user modules, kept in the
+// directory named by the NODE_COMPILE_CACHE environment variable. Entries are
+// named after the SHA-256 digest of the source text they were produced for,
+// and live in a subdirectory named after a hash of the Node.js version and
+// the options that the process was started with. Each entry starts with the
+// digest and length of its source text again, and is ignored if they do not
+// match, since V8 itself only checks the length.
+//
+// The cache data for CommonJS modules is created after they have been running
+// for a while, so that it also covers the functions that V8 compiled lazily.
+// ES modules can only be cached before they are evaluated. The data is written
+// asynchronously, except for what is still pending when the process exits.
+
+const {
+  ArrayPrototypeJoin,
+  ArrayPrototypePush,
+  SafeSet,
+} = primordials;
+
+const { Buffer } = require('buffer');
+const {
+  createCachedDataForFunction,
+  hashSource,
+} = internalBinding('contextify');
+const { safeGetenv } = internalBinding('credentials');
+const { threadId } = internalBinding('worker');
+const fs = require('fs');
+const path = require('path');
+let debug = require('internal/util/debuglog').debuglog('module', (fn) => {
+  debug = fn;
+});
+
+// How long modules are run before their cache data is created.
+const kWarmUpDelay = 5000;
+
+// The directory for this Node.js version and set of options. Null if the
+// cache is disabled, and undefined until it is first needed.
+let directory;
+// Entries whose cache data is yet to be written.
+let pending = [];
+// Files that entries have been written to, or are pending for.
+const saved = new SafeSet();
+let flushTimer;
+let exitListenerAdded = false;
+
+function getDirectory() {
+  if (directory !== undefined)
+    return directory;
+  directory = null;
+
+  const root = safeGetenv('NODE_COMPILE_CACHE');
+  // Code that is compiled while recording or replaying is not cached, as it
+  // might end up being run on another thread.
+  if (!root || process.isRecordingOrReplaying())
+    return directory;
+
+  // Without OpenSSL, there is no way to tell sources apart reliably.
+  const options = hashSource(ArrayPrototypeJoin([
+    process.version,
+    process.arch,
+    ArrayPrototypeJoin(process.execArgv, ' '),
+    safeGetenv('NODE_OPTIONS'),
+  ], '\0'));
+  if (options === undefined)
+    return directory;
+  const dir = path.join(path.resolve(root), options);
+  try {
+    fs.mkdirSync(dir, { recursive: true });
+    directory = dir;
+  } catch (err) {
+    debug('cannot use compile cache directory %s: %s', dir, err.message);
+  }
+  return directory;
+}
+
+// Looks up the cache data for a source text. `kind` tells apart the ways in
+// which a source text can be compiled. Returns undefined if the cache is
+// disabled, or an entry whose `data` is the cache data, if there is any.
+function getCompileCacheEntry(kind, source) {
+  const dir = getDirectory();
+  if (dir === null)
+    return;
+
+  const hash = hashSource(source);
+  const entry = {
+    file: path.join(dir, `${hash}.${kind}`),
+    header: Buffer.from(`${hash} ${source.length}\n`, 'latin1'),
+    data: undefined,
+    target: undefined,
+  };
+  let contents;
+  try {
+    contents = fs.readFileSync(entry.file);
+  } catch {
+    // Not cached yet.
+    return entry;
+  }
+  const { header } = entry;
+  if (contents.length > header.length &&
+      header.equals(contents.subarray(0, header.length))) {
+    entry.data = contents.subarray(header.length);
+  }
+  return entry;
+}
+
+// Saves the cache data for an entry that had none, or whose data V8
+// rejected. `target` is either the cache data itself, or the function that
+// the cache data is to be created for once it has warmed up.
+function saveCompileCacheEntry(entry, target) {
+  if (saved.has(entry.file))
+    return;
+  saved.add(entry.file);
+  entry.target = target;
+  ArrayPrototypePush(pending, entry);
+
+  if (flushTimer === undefined) {
+    const { setUnrefTimeout } = require('internal/timers');
+    flushTimer = setUnrefTimeout(flushCompileCache, kWarmUpDelay);
+  }
+  if (!exitListenerAdded) {
+    exitListenerAdded = true;
+    process.on('exit', flushCompileCacheSync);
+  }
+}
+
+function takePending() {
+  const entries = pending;
+  pending = [];
+  return entries;
+}
+
+function createCachedData({ header, target }) {
+  const data = typeof target === 'function' ?
+    createCachedDataForFunction(target) : target;
+  if (data !== undefined && data.length > 0)
+    return Buffer.concat([header, data]);
+}
+
+// Cache files are written under a temporary name first, so that other
+// processes never read one that is incomplete.
+function getTemporaryFile(file) {
+  return `${file}.${process.pid}-${threadId}`;
+}
+
+function flushCompileCache() {
+  flushTimer = undefined;
+  const entries = takePending();
+  for (let i = 0; i < entries.length; i++) {
+    const { file } = entries[i];
+    const data = createCachedData(entries[i]);
+    if (data === undefined)
+      continue;
+    const temporary = getTemporaryFile(file);
+    fs.writeFile(temporary, data, (err) => {
+      if (err)
+        return debug('cannot write compile cache %s: %s', file, err.message);
+      fs.rename(temporary, file, (err) => {
+        if (!err)
+          return;
+        debug('cannot write compile cache %s: %s', file, err.message);
+        fs.unlink(temporary, () => {});
+      });
+    });
+  }
+}
+
+function flushCompileCacheSync() {
+  const entries = takePending();
+  for (let i = 0; i < entries.length; i++) {
+    const { file } = entries[i];
+    const data = createCachedData(entries[i]);
+    if (data === undefined)
+      continue;
+    const temporary = getTemporaryFile(file);
+    try {
+      fs.writeFileSync(temporary, data);
+      fs.renameSync(temporary, file);
+    } catch (err) {
+      debug('cannot write compile cache %s: %s', file, err.message);
+    }
+  }
+}
+
+module.exports = {
+  getCompileCacheEntry,
+  saveCompileCacheEntry,
+};
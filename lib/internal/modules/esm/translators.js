@@ -55,6 +55,7 @@ const {
 } = require('internal/errors').codes;
 const { maybeCacheSourceMap } = require('internal/source_map/source_map_cache');
 const moduleWrap = internalBinding('module_wrap');
+const { safeGetenv } = internalBinding('credentials');
 const { ModuleWrap } = moduleWrap;
 const { getOptionValue } = require('internal/options');
 const experimentalImportMetaResolve =
@@ -74,6 +75,16 @@ async function initCJSParse() {
   }
 }
 
+// The compile cache is only loaded when it is enabled.
+let compileCache;
+function getCompileCache() {
+  if (compileCache === undefined) {
+    compileCache = safeGetenv('NODE_COMPILE_CACHE') ?
+      require('internal/modules/compile_cache') : null;
+  }
+  return compileCache;
+}
+
 const translators = new SafeMap();
 exports.translators = translators;
 exports.enrichCJSError = enrichCJSError;
@@ -142,7 +153,21 @@ translators.set('module', async function moduleStrategy(url) {
   source = stringify(source);
   maybeCacheSourceMap(url, source);
   debug(`Translating StandardModule ${url}`);
-  const module = new ModuleWrap(url, undefined, source, 0, 0);
+  const cacheEntry = getCompileCache()?.getCompileCacheEntry('mjs', source);
+  let module;
+  try {
+    module = new ModuleWrap(url, undefined, source, 0, 0, cacheEntry?.data);
+  } catch (err) {
+    if (cacheEntry?.data === undefined ||
+        err?.code !== 'ERR_VM_MODULE_CACHED_DATA_REJECTED') {
+      throw err;
+    }
+    cacheEntry.data = undefined;
+    module = new ModuleWrap(url, undefined, source, 0, 0);
+  }
+  // The cache data of modules can only be created before they are evaluated.
+  if (cacheEntry !== undefined && cacheEntry.data === undefined)
+    compileCache.saveCompileCacheEntry(cacheEntry, module.createCachedData());
   moduleWrap.callbackMap.set(module, {
     initializeImportMeta,
     importModuleDynamically,
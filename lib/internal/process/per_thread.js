@@ -93,7 +93,9 @@ function wrapProcessMethods(binding) {
   const {
     cpuUsage: _cpuUsage,
     memoryUsage: _memoryUsage,
-    resourceUsage: _resourceUsage
+    resourceUsage: _resourceUsage,
+    threadpoolUsage: _threadpoolUsage,
+    recordReplayCheckpointStats: _recordReplayCheckpointStats
   } = binding;
 
   function _rawDebug(...args) {
@@ -156,7 +158,7 @@ function wrapProcessMethods(binding) {
         num >= 0;
   }
 
-  const memValues = new Float64Array(5);
+  const memValues = new Float64Array(8);
   function memoryUsage() {
     _memoryUsage(memValues);
     return {
@@ -164,7 +166,12 @@ function wrapProcessMethods(binding) {
       heapTotal: memValues[1],
       heapUsed: memValues[2],
       external: memValues[3],
-      arrayBuffers: memValues[4]
+      arrayBuffers: memValues[4],
+      arrayBufferPool: {
+        cached: memValues[5],
+        hits: memValues[6],
+        misses: memValues[7]
+      }
     };
   }
 
@@ -233,11 +240,48 @@ function wrapProcessMethods(binding) {
     };
   }
 
+  const threadpoolValues = new Float64Array(19);
+  function threadpoolQueueUsage(offset) {
+    return {
+      queued: threadpoolValues[offset],
+      running: threadpoolValues[offset + 1],
+      completed: threadpoolValues[offset + 2],
+      waitTime: threadpoolValues[offset + 3],
+      runTime: threadpoolValues[offset + 4]
+    };
+  }
+
+  function threadpoolUsage() {
+    _threadpoolUsage(threadpoolValues);
+    return {
+      threads: threadpoolValues[0],
+      idleThreads: threadpoolValues[1],
+      minThreads: threadpoolValues[2],
+      maxThreads: threadpoolValues[3],
+      cpu: threadpoolQueueUsage(4),
+      fastIO: threadpoolQueueUsage(9),
+      slowIO: threadpoolQueueUsage(14)
+    };
+  }
+
+  const checkpointValues = new Float64Array(5);
+  function recordReplayCheckpointStats() {
+    _recordReplayCheckpointStats(checkpointValues);
+    return {
+      minProgress: checkpointValues[0],
+      minIntervalMs: checkpointValues[1],
+      candidates: checkpointValues[2],
+      created: checkpointValues[3],
+      progress: checkpointValues[4]
+    };
+  }
 
   return {
     _rawDebug,
     cpuUsage,
     resourceUsage,
+    threadpoolUsage,
+    recordReplayCheckpointStats,
     memoryUsage,
     kill,
     exit
@@ -9,6 +9,7 @@ const {
 } = require("internal/recordreplay/message");
 const {
   remoteObjectToProtocolValue,
+  valueToProtocolValue,
   clearPauseDataCallback,
   protocolIdToRemoteObject,
 } = require("internal/recordreplay/object");
@@ -19,6 +20,11 @@ const {
   createProtocolScope,
 } = require("internal/recordreplay/preview");
 const { assert, log } = require("internal/recordreplay/utils");
+const {
+  takeRecordReplayHeapSnapshot,
+  getRecordReplayHeapSnapshotChunk,
+  releaseRecordReplayHeapSnapshot,
+} = internalBinding("heap_utils");
 
 function initializeRecordReplay() {
   if (process.isRecordingOrReplaying()) {
@@ -40,9 +46,12 @@ const CommandCallbacks = {
   "Pause.evaluateInGlobal": Pause_evaluateInGlobal,
   "Pause.getAllFrames": Pause_getAllFrames,
   "Pause.getExceptionValue": Pause_getExceptionValue,
+  "Pause.getHeapSnapshotChunk": Pause_getHeapSnapshotChunk,
   "Pause.getObjectPreview": Pause_getObjectPreview,
   "Pause.getObjectProperty": Pause_getObjectProperty,
   "Pause.getScope": Pause_getScope,
+  "Pause.releaseHeapSnapshot": Pause_releaseHeapSnapshot,
+  "Pause.takeHeapSnapshot": Pause_takeHeapSnapshot,
 };
 
 function commandCallback(method, params) {
@@ -91,35 +100,12 @@ function Target_getCurrentMessageContents() {
     };
   }
 
-  // Look for the "args" variable on an onConsoleMessage frame.
-  // The arguments are also stored on the last console API call, though
-  // if we use that we need to be careful because the pause state could have
-  // been cleared since the last Runtime.consoleAPICalled event.
-  const { callFrames } = sendMessage("Debugger.getCallFrames");
-  const consoleMessageFrame = callFrames.find(
-    frame => frame.functionName == "onConsoleMessage"
-  );
-  assert(consoleMessageFrame);
-  assert(consoleMessageFrame.this.type == "object");
-  assert(consoleMessageFrame.this.className == "Array");
-  const argumentsId = consoleMessageFrame.this.objectId;
-
-  // Get the properties of the message arguments array.
-  const argumentsProperties = sendMessage("Runtime.getProperties", {
-    objectId: argumentsId,
-    ownProperties: true,
-    generatePreview: false,
-  }).result;
-
-  // Get the protocol representation of the message arguments.
-  const argumentValues = [];
-  for (let i = 0;; i++) {
-    const property = argumentsProperties.find(prop => prop.name == i.toString());
-    if (!property) {
-      break;
-    }
-    argumentValues.push(remoteObjectToProtocolValue(property.value));
-  }
+  // The arguments to the console call are held natively while the driver is
+  // processing the message, so we can convert them directly without using the
+  // inspector to find and enumerate the arguments array.
+  const args = process._recordReplayGetCurrentConsoleArguments();
+  assert(Array.isArray(args));
+  const argumentValues = args.map(valueToProtocolValue);
 
   let level = "info";
   switch (gLastConsoleAPICall.level) {
@@ -268,6 +254,32 @@ function Pause_getScope({ scope }) {
   return { data: { scopes: [scopeData] } };
 }
 
+// Heap snapshots can only be taken after the replay has diverged from the
+// recording. The snapshot is summarized natively, and its full contents are
+// fetched in chunks via Pause.getHeapSnapshotChunk. It is kept until the next
+// snapshot is taken or Pause.releaseHeapSnapshot is sent.
+function Pause_takeHeapSnapshot() {
+  const rv = takeRecordReplayHeapSnapshot();
+  if (!rv) {
+    throw new Error("Heap snapshots require a diverged replay");
+  }
+  const { size, chunkCount, summary } = rv;
+  return { size, chunkCount, summary };
+}
+
+function Pause_getHeapSnapshotChunk({ index }) {
+  const chunk = getRecordReplayHeapSnapshotChunk(index);
+  if (chunk === undefined) {
+    return {};
+  }
+  return { chunk };
+}
+
+function Pause_releaseHeapSnapshot() {
+  releaseRecordReplayHeapSnapshot();
+  return {};
+}
+
 module.exports = {
   initializeRecordReplay,
 };
@@ -1,6 +1,10 @@
 // Manage association between remote objects and protocol object IDs.
 
 const { assert, log } = require("internal/recordreplay/utils");
+const {
+  recordReplayValueToRemoteObject,
+  recordReplayRemoteObjectIdToValue,
+} = internalBinding("process_methods");
 
 // Map protocol ObjectId => RemoteObject
 const gProtocolIdToObject = new Map();
@@ -11,12 +15,23 @@ const gObjectIdToProtocolId = new Map();
 // Map protocol ScopeId => Debugger.Scope
 const gProtocolIdToScope = new Map();
 
+// Map JS object => protocol ObjectId. The inspector gives an object a new
+// objectId each time it is wrapped, so this is the map which decides the
+// protocol ID of every object, however we got a reference to it.
+const gValueToProtocolId = new Map();
+
+// Map protocol ObjectId => JS object, for objects in gValueToProtocolId which
+// have not been converted to a RemoteObject yet.
+const gProtocolIdToValue = new Map();
+
 let gNextObjectId = 1;
 
 function clearPauseDataCallback() {
   gProtocolIdToObject.clear();
   gObjectIdToProtocolId.clear();
   gProtocolIdToScope.clear();
+  gValueToProtocolId.clear();
+  gProtocolIdToValue.clear();
   gNextObjectId = 1;
 }
 
@@ -28,15 +43,48 @@ function remoteObjectToProtocolId(remoteObject) {
     return existing;
   }
 
-  const protocolObjectId = (gNextObjectId++).toString();
+  const value = recordReplayRemoteObjectIdToValue(remoteObject.objectId);
+  let protocolObjectId = value !== undefined && gValueToProtocolId.get(value);
+  if (!protocolObjectId) {
+    protocolObjectId = (gNextObjectId++).toString();
+    if (value !== undefined) {
+      gValueToProtocolId.set(value, protocolObjectId);
+    }
+  }
   gObjectIdToProtocolId.set(remoteObject.objectId, protocolObjectId);
-  gProtocolIdToObject.set(protocolObjectId, remoteObject);
+  if (!gProtocolIdToObject.has(protocolObjectId)) {
+    gProtocolIdToObject.set(protocolObjectId, remoteObject);
+    gProtocolIdToValue.delete(protocolObjectId);
+  }
+
+  return protocolObjectId;
+}
+
+// Get the protocol ID for a JS object we have a direct reference to. Creating
+// the RemoteObject is deferred until the object's contents are needed.
+function valueToProtocolId(value) {
+  const existing = gValueToProtocolId.get(value);
+  if (existing) {
+    return existing;
+  }
+
+  const protocolObjectId = (gNextObjectId++).toString();
+  gValueToProtocolId.set(value, protocolObjectId);
+  gProtocolIdToValue.set(protocolObjectId, value);
 
   return protocolObjectId;
 }
 
 function protocolIdToRemoteObject(objectId) {
-  const remoteObject = gProtocolIdToObject.get(objectId);
+  let remoteObject = gProtocolIdToObject.get(objectId);
+  if (!remoteObject && gProtocolIdToValue.has(objectId)) {
+    remoteObject =
+      recordReplayValueToRemoteObject(gProtocolIdToValue.get(objectId));
+    assert(remoteObject && remoteObject.objectId);
+    gProtocolIdToValue.delete(objectId);
+    gProtocolIdToObject.set(objectId, remoteObject);
+    gObjectIdToProtocolId.set(remoteObject.objectId, objectId);
+  }
   assert(remoteObject);
   return remoteObject;
 }
@@ -77,6 +125,37 @@ function remoteObjectToProtocolValue(obj) {
   }
 }
 
+// Get the protocol representation of a JS value we have a direct reference to,
+// matching the result of remoteObjectToProtocolValue for the same value.
+function valueToProtocolValue(value) {
+  switch (typeof value) {
+    case "undefined":
+      return {};
+    case "string":
+      if (value.length > MaxStringLength) {
+        return { value: value.substring(0, MaxStringLength) + "…" };
+      }
+      return { value };
+    case "number":
+      if (!Number.isFinite(value) || Object.is(value, -0)) {
+        return { unserializableNumber: Object.is(value, -0) ? "-0" : `${value}` };
+      }
+      return { value };
+    case "boolean":
+      return { value };
+    case "bigint":
+      return { bigint: value.toString() };
+    case "object":
+    case "function":
+      if (value === null) {
+        return { value: null };
+      }
+      return { object: valueToProtocolId(value) };
+    default:
+      return { unavailable: true };
+  }
+}
+
 function scopeToProtocolId(scope) {
   // Use the scope object's ID as the ID for the scope itself.
   const id = remoteObjectToProtocolId(scope.object);
@@ -94,6 +173,7 @@ module.exports = {
   remoteObjectToProtocolId,
   protocolIdToRemoteObject,
   remoteObjectToProtocolValue,
+  valueToProtocolValue,
   scopeToProtocolId,
   protocolIdToScope,
   clearPauseDataCallback,
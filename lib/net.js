@@ -495,6 +495,19 @@ Socket.prototype.setNoDelay = function(enable) {
 };
 
 
+Socket.prototype.setWriteCoalescing = function(enable) {
+  if (!this._handle) {
+    this.once('connect', () => this.setWriteCoalescing(enable));
+    return this;
+  }
+
+  if (this._handle.setWriteCoalescing)
+    this._handle.setWriteCoalescing(enable === undefined ? true : !!enable);
+
+  return this;
+};
+
+
 Socket.prototype.setKeepAlive = function(setting, msecs) {
   if (!this._handle) {
     this.once('connect', () => this.setKeepAlive(setting, msecs));
@@ -23,6 +23,7 @@
 
 const {
   ArrayBuffer,
+  ArrayIsArray,
   Error,
   MathMax,
   NumberIsFinite,
@@ -65,6 +66,7 @@ const {
 const { owner_symbol } = require('internal/async_hooks').symbols;
 
 const kFlushFlag = Symbol('kFlushFlag');
+const kPendingFlushes = Symbol('kPendingFlushes');
 const kError = Symbol('kError');
 
 const constants = internalBinding('constants').zlib;
@@ -100,6 +102,8 @@ for (const ckey of ObjectKeys(codes)) {
   codes[codes[ckey]] = ckey;
 }
 
+const kMaxParallelism = 1024;
+
 function zlibBuffer(engine, buffer, callback) {
   if (typeof callback !== 'function')
     throw new ERR_INVALID_ARG_TYPE('callback', 'function', callback);
@@ -230,6 +234,11 @@ const checkRangesOrGetDefault = hideStackFrames(
   }
 );
 
+function getParallelism(opts) {
+  return checkRangesOrGetDefault(
+    opts && opts.parallelism, 'options.parallelism', 1, kMaxParallelism, 1);
+}
+
 // The base class for all Zlib-style streams.
 function ZlibBase(opts, mode, handle, { flush, finishFlush, fullFlush }) {
   let chunkSize = Z_DEFAULT_CHUNK;
@@ -275,6 +284,9 @@ function ZlibBase(opts, mode, handle, { flush, finishFlush, fullFlush }) {
   handle[owner_symbol] = this;
   // Used by processCallback() and zlibOnError()
   handle.onerror = zlibOnError;
+  // Used by processBatch()
+  handle.oncomplete = processBatchCallback;
+  this[kPendingFlushes] = 0;
   this._outBuffer = Buffer.allocUnsafe(chunkSize);
   this._outOffset = 0;
 
@@ -374,6 +386,11 @@ ZlibBase.prototype.flush = function(kind, callback) {
     if (callback)
       this.once('end', callback);
   } else {
+    // Writes queued behind a flush are not batched, so that its callback runs
+    // once the data written before it can be read, and not after the data
+    // written after it.
+    this[kPendingFlushes]++;
+    this._writev = null;
     this.write(kFlushBuffers[kind], '', callback);
   }
 };
@@ -388,12 +405,28 @@ ZlibBase.prototype._destroy = function(err, callback) {
   callback(err);
 };
 
+// Chunks that were queued while another write was in progress are handed to
+// _transform() as one array, and compressed in a single trip to the
+// threadpool.
+function writevBatch(chunks, cb) {
+  this._write(chunks, '', cb);
+}
+
+ZlibBase.prototype._writev = writevBatch;
+
 ZlibBase.prototype._transform = function(chunk, encoding, cb) {
+  if (ArrayIsArray(chunk)) {
+    processBatch(this, chunk, cb);
+    return;
+  }
+
   let flushFlag = this._defaultFlushFlag;
   // We use a 'fake' zero-length chunk to carry information about flushes from
   // the public API to the actual stream implementation.
   if (typeof chunk[kFlushFlag] === 'number') {
     flushFlag = chunk[kFlushFlag];
+    if (--this[kPendingFlushes] === 0)
+      this._writev = writevBatch;
   }
 
   // For the last chunk, also apply `_finishFlushFlag`.
@@ -592,6 +625,100 @@ function processCallback() {
   this.cb();
 }
 
+function processBatch(self, entries, cb) {
+  const handle = self._handle;
+  if (!handle) return process.nextTick(cb);
+
+  const chunks = new Array(entries.length);
+  let length = 0;
+  for (let i = 0; i < entries.length; i++) {
+    chunks[i] = entries[i].chunk;
+    length += chunks[i].byteLength;
+  }
+
+  // For the last chunk, also apply `_finishFlushFlag`.
+  let lastFlushFlag = self._defaultFlushFlag;
+  if (self.writableEnded && self.writableLength === length)
+    lastFlushFlag = maxFlush(lastFlushFlag, self._finishFlushFlag);
+
+  handle.buffer = chunks;
+  handle.cb = cb;
+  handle.batchIndex = 0;
+  handle.inOff = 0;
+  handle.flushFlag = self._defaultFlushFlag;
+  handle.lastFlushFlag = lastFlushFlag;
+
+  handle.writeBatch(handle.flushFlag,
+                    lastFlushFlag,
+                    chunks,
+                    0, // index
+                    0, // in_off
+                    self._chunkSize);
+}
+
+function processBatchCallback(output, ended) {
+  // Like processCallback(), but for processBatch(). All of the output comes
+  // in `output`, which is handed out in slices of up to `_chunkSize` bytes.
+  const handle = this;
+  const self = this[owner_symbol];
+  const state = self._writeState;
+  const chunks = this.buffer;
+
+  if (self.destroyed) {
+    this.buffer = null;
+    this.cb();
+    return;
+  }
+
+  // The batch stopped in chunks[index], with `availInAfter` bytes left.
+  const index = state[0];
+  const availInAfter = state[1];
+  const inOff = index < chunks.length ?
+    chunks[index].byteLength - availInAfter : 0;
+
+  let inDelta = inOff - handle.inOff;
+  for (let i = handle.batchIndex; i < index; i++)
+    inDelta += chunks[i].byteLength;
+  self.bytesWritten += inDelta;
+
+  if (output !== undefined) {
+    const chunkSize = self._chunkSize;
+    for (let offset = 0; offset < output.length; offset += chunkSize) {
+      self.push(output.slice(offset, offset + chunkSize));
+      if (self.destroyed)
+        break;
+    }
+  }
+
+  if (self.destroyed) {
+    this.cb();
+    return;
+  }
+
+  if (index < chunks.length && !ended) {
+    // The output has reached its limit before all of the input was consumed.
+    // Pick up where it stopped.
+    handle.batchIndex = index;
+    handle.inOff = inOff;
+    this.writeBatch(handle.flushFlag,
+                    handle.lastFlushFlag,
+                    chunks,
+                    index,
+                    inOff,
+                    self._chunkSize);
+    return;
+  }
+
+  if (ended) {
+    // See the comment in processCallback().
+    self.push(null);
+  }
+
+  // Finished with the batch.
+  this.buffer = null;
+  this.cb();
+}
+
 function _close(engine) {
   // Caller may invoke .close after a zlib error (which will null _handle).
   if (!engine._handle)
@@ -613,6 +740,7 @@ function Zlib(opts, mode) {
   let level = Z_DEFAULT_COMPRESSION;
   let memLevel = Z_DEFAULT_MEMLEVEL;
   let strategy = Z_DEFAULT_STRATEGY;
+  let parallelism = 1;
   let dictionary;
 
   if (opts) {
@@ -644,8 +772,11 @@ function Zlib(opts, mode) {
       opts.strategy, 'options.strategy',
       Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
 
+    parallelism = getParallelism(opts);
+
     dictionary = opts.dictionary;
-    if (dictionary !== undefined && !isArrayBufferView(dictionary)) {
+    if (dictionary !== undefined && !isArrayBufferView(dictionary) &&
+        !(dictionary instanceof binding.ZlibDictionary)) {
       if (isAnyArrayBuffer(dictionary)) {
         dictionary = Buffer.from(dictionary);
       } else {
@@ -669,7 +800,8 @@ function Zlib(opts, mode) {
               strategy,
               this._writeState,
               processCallback,
-              dictionary);
+              dictionary,
+              parallelism);
 
   ZlibBase.call(this, opts, mode, handle, zlibDefaultOpts);
 
@@ -705,6 +837,21 @@ Zlib.prototype.params = function params(level, strategy, callback) {
   }
 };
 
+// Returns a dictionary that can be passed as the `dictionary` option of many
+// streams. The work of setting it on a deflate stream is only done once.
+function prepareDictionary(dictionary) {
+  if (isAnyArrayBuffer(dictionary)) {
+    dictionary = Buffer.from(dictionary);
+  } else if (!isArrayBufferView(dictionary)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'dictionary',
+      ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+      dictionary
+    );
+  }
+  return new binding.ZlibDictionary(dictionary);
+}
+
 // generic zlib
 // minimal 2-byte header
 function Deflate(opts) {
@@ -811,6 +958,8 @@ function Brotli(opts, mode) {
     }
   }
 
+  const parallelism = getParallelism(opts);
+
   const handle = mode === BROTLI_DECODE ?
     new binding.BrotliDecoder(mode) : new binding.BrotliEncoder(mode);
 
@@ -820,7 +969,8 @@ function Brotli(opts, mode) {
   // the current bindings setup, though.
   if (!handle.init(brotliInitParamsArray,
                    this._writeState,
-                   processCallback)) {
+                   processCallback,
+                   parallelism)) {
     throw new ERR_ZLIB_INITIALIZATION_FAILED();
   }
 
@@ -874,6 +1024,8 @@ module.exports = {
   BrotliCompress,
   BrotliDecompress,
 
+  prepareDictionary,
+
   // Convenience methods.
   // compress/decompress a string or buffer in one step.
   deflate: createConvenienceMethod(Deflate, false),
@@ -180,6 +180,7 @@
       'lib/internal/main/run_main_module.js',
       'lib/internal/main/worker_thread.js',
       'lib/internal/modules/run_main.js',
+      'lib/internal/modules/compile_cache.js',
       'lib/internal/modules/package_json_reader.js',
       'lib/internal/modules/cjs/helpers.js',
       'lib/internal/modules/cjs/loader.js',
@@ -627,6 +628,7 @@
         'src/node_http2.cc',
         'src/node_i18n.cc',
         'src/node_main_instance.cc',
+        'src/node_mem_pool.cc',
         'src/node_messaging.cc',
         'src/node_metadata.cc',
         'src/node_native_module.cc',
@@ -644,6 +646,7 @@
         'src/node_report_module.cc',
         'src/node_report_utils.cc',
         'src/node_serdes.cc',
+        'src/node_simd.cc',
         'src/node_sockaddr.cc',
         'src/node_stat_watcher.cc',
         'src/node_symbols.cc',
@@ -730,6 +733,7 @@
         'src/node_main_instance.h',
         'src/node_mem.h',
         'src/node_mem-inl.h',
+        'src/node_mem_pool.h',
         'src/node_messaging.h',
         'src/node_metadata.h',
         'src/node_mutex.h',
@@ -745,6 +749,7 @@
         'src/node_report.h',
         'src/node_revert.h',
         'src/node_root_certs.h',
+        'src/node_simd.h',
         'src/node_sockaddr.h',
         'src/node_sockaddr-inl.h',
         'src/node_stat_watcher.h',
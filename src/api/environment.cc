@@ -2,6 +2,7 @@
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "node_internals.h"
+#include "node_mem_pool.h"
 #include "node_native_module_env.h"
 #include "node_platform.h"
 #include "node_v8_platform-inl.h"
@@ -77,21 +78,45 @@ MaybeLocal<Value> PrepareStackTraceCallback(Local<Context> context,
   return result;
 }
 
-void* NodeArrayBufferAllocator::Allocate(size_t size) {
-  void* ret;
-  if (zero_fill_field_ ||
-      per_process::cli_options->zero_fill_all_buffers ||
-      v8::recordreplay::IsRecordingOrReplaying())
-    ret = UncheckedCalloc(size);
+namespace {
+
+// Blocks are only reused when not recording or replaying, since otherwise
+// the contents of uninitialized buffers would depend on which thread freed
+// memory when.
+inline bool UsePool(size_t size) {
+  return mem::SizeClassPool::IsPooled(size) &&
+         !v8::recordreplay::IsRecordingOrReplaying();
+}
+
+void* AllocateBlock(size_t size, bool zero_fill) {
+  if (UsePool(size))
+    return mem::SizeClassPool::Allocate(size, zero_fill);
+  if (zero_fill)
+    return UncheckedCalloc(size);
+  return UncheckedMalloc(size);
+}
+
+void FreeBlock(void* data, size_t size) {
+  if (UsePool(size))
+    mem::SizeClassPool::Free(data, size);
   else
-    ret = UncheckedMalloc(size);
+    free(data);
+}
+
+}  // anonymous namespace
+
+void* NodeArrayBufferAllocator::Allocate(size_t size) {
+  void* ret = AllocateBlock(size,
+                            zero_fill_field_ ||
+                            per_process::cli_options->zero_fill_all_buffers ||
+                            v8::recordreplay::IsRecordingOrReplaying());
   if (LIKELY(ret != nullptr))
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
   return ret;
 }
 
 void* NodeArrayBufferAllocator::AllocateUninitialized(size_t size) {
-  void* ret = node::UncheckedMalloc(size);
+  void* ret = AllocateBlock(size, false);
   if (LIKELY(ret != nullptr))
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
   return ret;
@@ -99,7 +124,19 @@ void* NodeArrayBufferAllocator::AllocateUninitialized(size_t size) {
 
 void* NodeArrayBufferAllocator::Reallocate(
     void* data, size_t old_size, size_t size) {
-  void* ret = UncheckedRealloc<char>(static_cast<char*>(data), size);
+  void* ret;
+  if (!UsePool(old_size) && !UsePool(size)) {
+    ret = UncheckedRealloc<char>(static_cast<char*>(data), size);
+  } else if (UsePool(old_size) && UsePool(size)) {
+    ret = mem::SizeClassPool::Reallocate(data, old_size, size);
+  } else {
+    // Moving between the pool and the system allocator.
+    ret = AllocateBlock(size, false);
+    if (ret != nullptr) {
+      memcpy(ret, data, std::min(old_size, size));
+      FreeBlock(data, old_size);
+    }
+  }
   if (LIKELY(ret != nullptr) || UNLIKELY(size == 0))
     total_mem_usage_.fetch_add(size - old_size, std::memory_order_relaxed);
   return ret;
@@ -107,7 +144,7 @@ void* NodeArrayBufferAllocator::Reallocate(
 
 void NodeArrayBufferAllocator::Free(void* data, size_t size) {
   total_mem_usage_.fetch_sub(size, std::memory_order_relaxed);
-  free(data);
+  FreeBlock(data, size);
 }
 
 DebuggingArrayBufferAllocator::~DebuggingArrayBufferAllocator() {
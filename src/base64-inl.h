@@ -4,6 +4,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "base64.h"
+#include "node_simd.h"
 #include "util.h"
 
 namespace node {
@@ -55,6 +56,22 @@ bool base64_decode_group_slow(char* const dst, const size_t dstlen,
 }
 
 
+// Only one-byte input has vectorized kernels.
+inline size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                                 const size_t max_k,
+                                 const char* const src, const size_t srclen) {
+  return simd::Base64Decode(dst, dstlen, max_k, src, srclen);
+}
+
+
+template <typename TypeName>
+size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                          const size_t max_k,
+                          const TypeName* const src, const size_t srclen) {
+  return 0;
+}
+
+
 template <typename TypeName>
 size_t base64_decode_fast(char* const dst, const size_t dstlen,
                           const TypeName* const src, const size_t srclen,
@@ -62,8 +79,8 @@ size_t base64_decode_fast(char* const dst, const size_t dstlen,
   const size_t available = dstlen < decoded_size ? dstlen : decoded_size;
   const size_t max_k = available / 3 * 3;
   size_t max_i = srclen / 4 * 4;
-  size_t i = 0;
-  size_t k = 0;
+  size_t i = base64_decode_simd(dst, dstlen, max_k, src, max_i);
+  size_t k = i / 4 * 3;
   while (i < max_i && k < max_k) {
     const unsigned char txt[] = {
       static_cast<unsigned char>(unbase64(src[i + 0])),
@@ -136,8 +153,8 @@ inline size_t base64_encode(const char* src,
 
   const char* table = base64_select_table(mode);
 
-  i = 0;
-  k = 0;
+  i = simd::Base64Encode(src, slen, dst, table);
+  k = i / 3 * 4;
   n = slen / 3 * 3;
 
   while (i < n) {
@@ -1,12 +1,14 @@
 #include "crypto/crypto_cipher.h"
 #include "crypto/crypto_util.h"
 #include "allocated_buffer-inl.h"
+#include "async_wrap-inl.h"
 #include "base_object-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
 #include "node_internals.h"
 #include "node_process.h"
+#include "threadpoolwork-inl.h"
 #include "v8.h"
 
 namespace node {
@@ -16,9 +18,12 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Int32;
+using v8::Just;
 using v8::Local;
+using v8::Maybe;
 using v8::Object;
 using v8::Uint32;
+using v8::Undefined;
 using v8::Value;
 
 namespace crypto {
@@ -294,6 +299,8 @@ void CipherBase::Initialize(Environment* env, Local<Object> target) {
 
   NODE_DEFINE_CONSTANT(target, kWebCryptoCipherEncrypt);
   NODE_DEFINE_CONSTANT(target, kWebCryptoCipherDecrypt);
+
+  AeadBatchJob::Initialize(env, target);
 }
 
 void CipherBase::New(const FunctionCallbackInfo<Value>& args) {
@@ -985,5 +992,281 @@ void PublicKeyCipher::Cipher(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(result);
 }
 
+AeadBatchConfig::AeadBatchConfig(AeadBatchConfig&& other) noexcept
+    : mode(other.mode),
+      cipher_mode(other.cipher_mode),
+      cipher(other.cipher),
+      key(std::move(other.key)),
+      auth_tag_length(other.auth_tag_length),
+      storage(std::move(other.storage)),
+      iv(std::move(other.iv)),
+      aad(std::move(other.aad)),
+      in(std::move(other.in)),
+      out(other.out) {}
+
+AeadBatchConfig& AeadBatchConfig::operator=(AeadBatchConfig&& other) noexcept {
+  if (&other == this) return *this;
+  this->~AeadBatchConfig();
+  return *new (this) AeadBatchConfig(std::move(other));
+}
+
+void AeadBatchConfig::MemoryInfo(MemoryTracker* tracker) const {
+  // If the Job is sync, then the AeadBatchConfig does not own the data.
+  if (mode == kCryptoJobAsync)
+    tracker->TrackFieldWithSize("storage", storage.size());
+}
+
+void AeadBatchJob::Initialize(Environment* env, Local<Object> target) {
+  CryptoJob<AeadBatchTraits>::Initialize(New, env, target);
+}
+
+void AeadBatchJob::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+
+  AeadBatchConfig params;
+  params.mode = GetCryptoJobMode(args[0]);
+
+  CHECK(args[1]->IsUint32());  // Cipher Mode
+  uint32_t cmode = args[1].As<Uint32>()->Value();
+  CHECK_LE(cmode, WebCryptoCipherMode::kWebCryptoCipherDecrypt);
+  params.cipher_mode = static_cast<WebCryptoCipherMode>(cmode);
+  const bool encrypt = params.cipher_mode == kWebCryptoCipherEncrypt;
+
+  CHECK(args[2]->IsString());  // Cipher
+  const Utf8Value cipher_type(env->isolate(), args[2]);
+  params.cipher = EVP_get_cipherbyname(*cipher_type);
+  if (params.cipher == nullptr)
+    return THROW_ERR_CRYPTO_UNKNOWN_CIPHER(env);
+  const bool chacha20_poly1305 =
+      EVP_CIPHER_nid(params.cipher) == NID_chacha20_poly1305;
+  if (!chacha20_poly1305 &&
+      EVP_CIPHER_mode(params.cipher) != EVP_CIPH_GCM_MODE) {
+    return THROW_ERR_CRYPTO_UNSUPPORTED_OPERATION(
+        env, "Only GCM and chacha20-poly1305 ciphers are supported");
+  }
+
+  if (IsAnyByteSource(args[3])) {  // Key
+    ArrayBufferOrViewContents<char> key(args[3]);
+    params.key = KeyObjectData::CreateSecret(key.ToCopy());
+  } else {
+    KeyObjectHandle* key;
+    ASSIGN_OR_RETURN_UNWRAP(&key, args[3]);
+    params.key = key->Data();
+  }
+  CHECK_EQ(params.key->GetKeyType(), kKeyTypeSecret);
+  if (params.key->GetSymmetricKeySize() !=
+          static_cast<size_t>(EVP_CIPHER_key_length(params.cipher))) {
+    return THROW_ERR_CRYPTO_INVALID_KEYLEN(env);
+  }
+
+  CHECK(args[7]->IsUint32());  // Authentication tag length
+  params.auth_tag_length = args[7].As<Uint32>()->Value();
+  if (chacha20_poly1305
+          ? params.auth_tag_length == 0 || params.auth_tag_length > 16
+          : !IsValidGCMTagLength(params.auth_tag_length)) {
+    char msg[50];
+    snprintf(msg, sizeof(msg),
+        "Invalid authentication tag length: %u", params.auth_tag_length);
+    return THROW_ERR_CRYPTO_INVALID_AUTH_TAG(env, msg);
+  }
+
+  // The IVs, additional data and inputs of all messages, in that order.
+  CHECK(args[4]->IsArray());
+  CHECK(args[5]->IsArray());
+  CHECK(args[6]->IsArray());
+  const uint32_t count = args[4].As<Array>()->Length();
+  std::vector<ArrayBufferOrViewContents<char>> contents;
+  contents.reserve(3 * count);
+  size_t total = 0;
+  size_t out_length = 0;
+  for (int field = 4; field <= 6; field++) {
+    Local<Array> values = args[field].As<Array>();
+    CHECK_EQ(values->Length(), count);
+    for (uint32_t i = 0; i < count; i++) {
+      Local<Value> value;
+      if (!values->Get(env->context(), i).ToLocal(&value))
+        return;
+      contents.emplace_back(value);
+      ArrayBufferOrViewContents<char>& data = contents.back();
+      if (UNLIKELY(!data.CheckSizeInt32()))
+        return THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+      total += data.size();
+      if (field == 4 &&
+          (data.size() == 0 || (chacha20_poly1305 && data.size() > 12))) {
+        return THROW_ERR_CRYPTO_INVALID_IV(env);
+      } else if (field == 6) {
+        if (encrypt) {
+          out_length += data.size() + params.auth_tag_length;
+        } else {
+          CHECK_GE(data.size(), params.auth_tag_length);
+          out_length += data.size() - params.auth_tag_length;
+        }
+      }
+    }
+  }
+
+  std::vector<ByteSource>* fields[] = { &params.iv, &params.aad, &params.in };
+  for (std::vector<ByteSource>* field : fields)
+    field->reserve(count);
+  if (params.mode == kCryptoJobAsync && total > 0) {
+    char* data = MallocOpenSSL<char>(total);
+    params.storage = ByteSource::Allocated(data, total);
+    for (size_t i = 0; i < contents.size(); i++) {
+      contents[i].CopyTo(data, contents[i].size());
+      fields[i / count]->push_back(
+          ByteSource::Foreign(data, contents[i].size()));
+      data += contents[i].size();
+    }
+  } else {
+    for (size_t i = 0; i < contents.size(); i++)
+      fields[i / count]->push_back(contents[i].ToByteSource());
+  }
+
+  CHECK(IsAnyByteSource(args[8]));  // Output
+  CHECK(args[9]->IsUint32());  // Offset
+  ArrayBufferOrViewContents<unsigned char> out(args[8]);
+  const uint32_t byte_offset = args[9].As<Uint32>()->Value();
+  CHECK_LE(byte_offset, out.size());  // Bounds check.
+  CHECK_LE(out_length, out.size() - byte_offset);
+  params.out = out.data() + byte_offset;
+
+  new AeadBatchJob(env, args.This(), params.mode, std::move(params));
+}
+
+AeadBatchJob::AeadBatchJob(
+    Environment* env,
+    Local<Object> object,
+    CryptoJobMode mode,
+    AeadBatchConfig&& params)
+    : CryptoJob<AeadBatchTraits>(
+          env,
+          object,
+          AsyncWrap::PROVIDER_CIPHERREQUEST,
+          mode,
+          std::move(params)) {}
+
+void AeadBatchJob::Fail() {
+  errors()->Capture();
+  if (errors()->empty())
+    errors()->push_back(std::string("Cipher job failed."));
+}
+
+void AeadBatchJob::DoThreadPoolWork() {
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+  const AeadBatchConfig& params = *this->params();
+  const bool encrypt = params.cipher_mode == kWebCryptoCipherEncrypt;
+  const unsigned int tag_length = params.auth_tag_length;
+
+  // The key schedule is set up once. For each message, only the IV is set,
+  // which also resets the rest of the state.
+  CipherCtxPointer ctx(EVP_CIPHER_CTX_new());
+  if (!ctx ||
+      !EVP_CipherInit_ex(
+          ctx.get(),
+          params.cipher,
+          nullptr,
+          reinterpret_cast<const unsigned char*>(
+              params.key->GetSymmetricKey()),
+          nullptr,
+          encrypt)) {
+    return Fail();
+  }
+  size_t iv_length = EVP_CIPHER_iv_length(params.cipher);
+
+  unsigned char* ptr = params.out;
+  for (size_t i = 0; i < params.in.size(); i++) {
+    const ByteSource& iv = params.iv[i];
+    const ByteSource& aad = params.aad[i];
+    const ByteSource& in = params.in[i];
+    const size_t length = encrypt ? in.size() : in.size() - tag_length;
+    int out_len;
+
+    if (iv.size() != iv_length) {
+      if (!EVP_CIPHER_CTX_ctrl(
+              ctx.get(), EVP_CTRL_AEAD_SET_IVLEN, iv.size(), nullptr)) {
+        return Fail();
+      }
+      iv_length = iv.size();
+    }
+    if (!EVP_CipherInit_ex(
+            ctx.get(), nullptr, nullptr, nullptr, iv.data<unsigned char>(),
+            -1)) {
+      return Fail();
+    }
+
+    // When decrypting, the authentication tag follows the ciphertext.
+    if (!encrypt &&
+        !EVP_CIPHER_CTX_ctrl(
+            ctx.get(),
+            EVP_CTRL_AEAD_SET_TAG,
+            tag_length,
+            const_cast<unsigned char*>(in.data<unsigned char>() + length))) {
+      return Fail();
+    }
+
+    // Passing no data to these ciphers finalizes them, so empty additional
+    // data and inputs are skipped.
+    if (aad.size() > 0 &&
+        !EVP_CipherUpdate(
+            ctx.get(), nullptr, &out_len, aad.data<unsigned char>(),
+            aad.size())) {
+      return Fail();
+    }
+    if (length > 0) {
+      if (!EVP_CipherUpdate(
+              ctx.get(), ptr, &out_len, in.data<unsigned char>(), length)) {
+        return Fail();
+      }
+      CHECK_EQ(static_cast<size_t>(out_len), length);
+      ptr += length;
+    }
+
+    if (!EVP_CipherFinal_ex(ctx.get(), ptr, &out_len)) {
+      if (encrypt)
+        return Fail();
+      // None of the output may be used once a message fails to
+      // authenticate, so the plaintext written so far is not left behind.
+      OPENSSL_cleanse(params.out, ptr - params.out);
+      auth_failed_ = true;
+      failed_index_ = i;
+      errors()->push_back(
+          std::string("Unsupported state or unable to authenticate data"));
+      return;
+    }
+    CHECK_EQ(out_len, 0);
+
+    if (encrypt) {
+      if (!EVP_CIPHER_CTX_ctrl(
+              ctx.get(), EVP_CTRL_AEAD_GET_TAG, tag_length, ptr)) {
+        return Fail();
+      }
+      ptr += tag_length;
+    }
+  }
+
+  success_ = true;
+}
+
+Maybe<bool> AeadBatchJob::ToResult(
+    Local<Value>* err,
+    Local<Value>* result) {
+  Environment* env = AsyncWrap::env();
+  CryptoErrorVector* errors = this->errors();
+  if (success_) {
+    CHECK(errors->empty());
+    *err = Undefined(env->isolate());
+    *result = Undefined(env->isolate());
+    return Just(true);
+  }
+
+  CHECK(!errors->empty());
+  if (auth_failed_)
+    *result = Uint32::New(env->isolate(), failed_index_);
+  else
+    *result = Undefined(env->isolate());
+  return Just(errors->ToException(env).ToLocal(err));
+}
+
 }  // namespace crypto
 }  // namespace node
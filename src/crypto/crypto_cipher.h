@@ -12,6 +12,7 @@
 #include "v8.h"
 
 #include <string>
+#include <vector>
 
 namespace node {
 namespace crypto {
@@ -271,6 +272,69 @@ class CipherJob final : public CryptoJob<CipherTraits> {
   ByteSource out_;
 };
 
+// Encrypts or decrypts many messages at once with one key and an AEAD cipher
+// (AES-GCM or ChaCha20-Poly1305). The results are written one after the
+// other into a buffer provided by the caller. As in WebCrypto, encrypted
+// messages are followed by their authentication tags.
+struct AeadBatchConfig final : public MemoryRetainer {
+  CryptoJobMode mode;
+  WebCryptoCipherMode cipher_mode;
+  const EVP_CIPHER* cipher;
+  std::shared_ptr<KeyObjectData> key;
+  unsigned int auth_tag_length;
+  // Async jobs copy all inputs into one allocation, which `iv`, `aad` and
+  // `in` point into.
+  ByteSource storage;
+  std::vector<ByteSource> iv;
+  std::vector<ByteSource> aad;
+  std::vector<ByteSource> in;
+  unsigned char* out = nullptr;
+
+  AeadBatchConfig() = default;
+
+  explicit AeadBatchConfig(AeadBatchConfig&& other) noexcept;
+
+  AeadBatchConfig& operator=(AeadBatchConfig&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(AeadBatchConfig);
+  SET_SELF_SIZE(AeadBatchConfig);
+};
+
+struct AeadBatchTraits final {
+  using AdditionalParameters = AeadBatchConfig;
+  static constexpr const char* JobName = "AeadBatchJob";
+};
+
+class AeadBatchJob final : public CryptoJob<AeadBatchTraits> {
+ public:
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  AeadBatchJob(
+      Environment* env,
+      v8::Local<v8::Object> object,
+      CryptoJobMode mode,
+      AeadBatchConfig&& params);
+
+  void DoThreadPoolWork() override;
+
+  // If a message fails to authenticate, the result is its index.
+  v8::Maybe<bool> ToResult(
+      v8::Local<v8::Value>* err,
+      v8::Local<v8::Value>* result) override;
+
+  SET_SELF_SIZE(AeadBatchJob)
+
+ private:
+  void Fail();
+
+  bool success_ = false;
+  bool auth_failed_ = false;
+  uint32_t failed_index_ = 0;
+};
+
 }  // namespace crypto
 }  // namespace node
 
@@ -12,6 +12,7 @@
 
 namespace node {
 
+using v8::Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Just;
@@ -57,6 +58,7 @@ void Hash::Initialize(Environment* env, Local<Object> target) {
   env->SetMethodNoSideEffect(target, "getHashes", GetHashes);
 
   HashJob::Initialize(env, target);
+  HashBatchJob::Initialize(env, target);
 }
 
 void Hash::New(const FunctionCallbackInfo<Value>& args) {
@@ -304,5 +306,166 @@ bool HashTraits::DeriveBits(
   return true;
 }
 
+HashBatchConfig::HashBatchConfig(HashBatchConfig&& other) noexcept
+    : mode(other.mode),
+      storage(std::move(other.storage)),
+      in(std::move(other.in)),
+      digest(other.digest),
+      length(other.length),
+      key(std::move(other.key)) {}
+
+HashBatchConfig& HashBatchConfig::operator=(HashBatchConfig&& other) noexcept {
+  if (&other == this) return *this;
+  this->~HashBatchConfig();
+  return *new (this) HashBatchConfig(std::move(other));
+}
+
+void HashBatchConfig::MemoryInfo(MemoryTracker* tracker) const {
+  // If the Job is sync, then the HashBatchConfig does not own the data.
+  if (mode == kCryptoJobAsync)
+    tracker->TrackFieldWithSize("storage", storage.size());
+}
+
+Maybe<bool> HashBatchTraits::EncodeOutput(
+    Environment* env,
+    const HashBatchConfig& params,
+    ByteSource* out,
+    v8::Local<v8::Value>* result) {
+  *result = out->ToArrayBuffer(env);
+  return Just(!result->IsEmpty());
+}
+
+Maybe<bool> HashBatchTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    HashBatchConfig* params) {
+  Environment* env = Environment::GetCurrent(args);
+
+  params->mode = mode;
+
+  CHECK(args[offset]->IsString());  // Hash algorithm
+  Utf8Value digest(env->isolate(), args[offset]);
+  params->digest = EVP_get_digestbyname(*digest);
+  if (UNLIKELY(params->digest == nullptr)) {
+    THROW_ERR_CRYPTO_INVALID_DIGEST(env);
+    return Nothing<bool>();
+  }
+
+  CHECK(args[offset + 1]->IsArray());  // Inputs
+  Local<Array> inputs = args[offset + 1].As<Array>();
+  std::vector<ArrayBufferOrViewContents<char>> contents;
+  contents.reserve(inputs->Length());
+  size_t total = 0;
+  for (uint32_t i = 0; i < inputs->Length(); i++) {
+    Local<Value> input;
+    if (!inputs->Get(env->context(), i).ToLocal(&input))
+      return Nothing<bool>();
+    contents.emplace_back(input);
+    if (UNLIKELY(!contents.back().CheckSizeInt32())) {
+      THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+      return Nothing<bool>();
+    }
+    total += contents.back().size();
+  }
+
+  params->in.reserve(contents.size());
+  if (mode == kCryptoJobAsync && total > 0) {
+    char* data = MallocOpenSSL<char>(total);
+    params->storage = ByteSource::Allocated(data, total);
+    for (const auto& input : contents) {
+      input.CopyTo(data, input.size());
+      params->in.push_back(ByteSource::Foreign(data, input.size()));
+      data += input.size();
+    }
+  } else {
+    for (const auto& input : contents)
+      params->in.push_back(input.ToByteSource());
+  }
+
+  if (!args[offset + 2]->IsUndefined()) {  // HMAC key
+    if (IsAnyByteSource(args[offset + 2])) {
+      ArrayBufferOrViewContents<char> key(args[offset + 2]);
+      params->key = KeyObjectData::CreateSecret(key.ToCopy());
+    } else {
+      KeyObjectHandle* key;
+      ASSIGN_OR_RETURN_UNWRAP(&key, args[offset + 2], Nothing<bool>());
+      params->key = key->Data();
+    }
+  }
+
+  unsigned int expected = EVP_MD_size(params->digest);
+  params->length = expected;
+  if (UNLIKELY(args[offset + 3]->IsUint32())) {
+    // Unlike for HashJob, the length is expressed in bytes, as for Hash.
+    params->length = args[offset + 3].As<Uint32>()->Value();
+    if (params->length != expected) {
+      if (params->key ||
+          (EVP_MD_flags(params->digest) & EVP_MD_FLAG_XOF) == 0) {
+        THROW_ERR_CRYPTO_INVALID_DIGEST(env, "Digest method not supported");
+        return Nothing<bool>();
+      }
+    }
+  }
+
+  return Just(true);
+}
+
+bool HashBatchTraits::DeriveBits(
+    Environment* env,
+    const HashBatchConfig& params,
+    ByteSource* out) {
+  const size_t total = params.in.size() * params.length;
+  if (total == 0)
+    return true;
+  char* data = MallocOpenSSL<char>(total);
+  ByteSource buf = ByteSource::Allocated(data, total);
+  unsigned char* ptr = reinterpret_cast<unsigned char*>(data);
+
+  // One context is set up and then reused for all inputs, which for HMACs
+  // also saves deriving the padded keys each time.
+  if (params.key) {
+    HMACCtxPointer ctx(HMAC_CTX_new());
+    const size_t key_len = params.key->GetSymmetricKeySize();
+    const char* key = key_len > 0 ? params.key->GetSymmetricKey() : "";
+    if (!ctx ||
+        !HMAC_Init_ex(ctx.get(), key, key_len, params.digest, nullptr)) {
+      return false;
+    }
+    for (const ByteSource& in : params.in) {
+      unsigned int len;
+      // Without a key and a digest, this resets the context to the key
+      // that was set up above.
+      if (!HMAC_Init_ex(ctx.get(), nullptr, 0, nullptr, nullptr) ||
+          !HMAC_Update(ctx.get(), in.data<unsigned char>(), in.size()) ||
+          !HMAC_Final(ctx.get(), ptr, &len)) {
+        return false;
+      }
+      ptr += params.length;
+    }
+  } else {
+    EVPMDPointer ctx(EVP_MD_CTX_new());
+    if (!ctx)
+      return false;
+    const bool xof =
+        params.length != static_cast<unsigned int>(EVP_MD_size(params.digest));
+    for (const ByteSource& in : params.in) {
+      if (EVP_DigestInit_ex(ctx.get(), params.digest, nullptr) <= 0 ||
+          EVP_DigestUpdate(ctx.get(), in.get(), in.size()) <= 0) {
+        return false;
+      }
+      int ret = xof
+          ? EVP_DigestFinalXOF(ctx.get(), ptr, params.length)
+          : EVP_DigestFinal_ex(ctx.get(), ptr, nullptr);
+      if (UNLIKELY(ret != 1))
+        return false;
+      ptr += params.length;
+    }
+  }
+
+  *out = std::move(buf);
+  return true;
+}
+
 }  // namespace crypto
 }  // namespace node
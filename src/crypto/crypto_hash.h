@@ -11,6 +11,8 @@
 #include "memory_tracker.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 namespace crypto {
 class Hash final : public BaseObject {
@@ -82,6 +84,54 @@ struct HashTraits final {
 
 using HashJob = DeriveBitsJob<HashTraits>;
 
+// Digests (or, given a key, HMACs) of many inputs at once, written one
+// after the other into a single output buffer.
+struct HashBatchConfig final : public MemoryRetainer {
+  CryptoJobMode mode;
+  // Async jobs copy all inputs into one allocation, which `in` points into.
+  ByteSource storage;
+  std::vector<ByteSource> in;
+  const EVP_MD* digest;
+  unsigned int length;
+  std::shared_ptr<KeyObjectData> key;
+
+  HashBatchConfig() = default;
+
+  explicit HashBatchConfig(HashBatchConfig&& other) noexcept;
+
+  HashBatchConfig& operator=(HashBatchConfig&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(HashBatchConfig);
+  SET_SELF_SIZE(HashBatchConfig);
+};
+
+struct HashBatchTraits final {
+  using AdditionalParameters = HashBatchConfig;
+  static constexpr const char* JobName = "HashBatchJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_HASHREQUEST;
+
+  static v8::Maybe<bool> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      HashBatchConfig* params);
+
+  static bool DeriveBits(
+      Environment* env,
+      const HashBatchConfig& params,
+      ByteSource* out);
+
+  static v8::Maybe<bool> EncodeOutput(
+      Environment* env,
+      const HashBatchConfig& params,
+      ByteSource* out,
+      v8::Local<v8::Value>* result);
+};
+
+using HashBatchJob = DeriveBitsJob<HashBatchTraits>;
+
 }  // namespace crypto
 }  // namespace node
 
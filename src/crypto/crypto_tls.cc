@@ -34,6 +34,21 @@
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
+#ifdef __linux__
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+// Older libc headers predate kernel TLS.
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif  // __linux__
+
 namespace node {
 
 using v8::Array;
@@ -320,6 +335,170 @@ inline bool Set(
       OneByteString(env->isolate(), value))
           .IsNothing();
 }
+
+#ifdef __linux__
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+// linux/tls.h declares the (unused) ChaCha20-Poly1305 salt as a zero-length
+// array, which is not valid C++. This has the same layout without it.
+struct KernelTLSChaCha20Poly1305Info {
+  tls_crypto_info info;
+  unsigned char iv[TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE];
+  unsigned char key[TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE];
+  unsigned char rec_seq[TLS_CIPHER_CHACHA20_POLY1305_REC_SEQ_SIZE];
+};
+#endif
+
+union KernelTLSCryptoInfo {
+  tls_crypto_info info;
+  tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+#ifdef TLS_CIPHER_AES_GCM_256
+  tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+  KernelTLSChaCha20Poly1305Info chacha20_poly1305;
+#endif
+};
+
+// In TLS 1.2 the Finished message is the first record sent with the new
+// keys, so the first application data record has sequence number 1.
+constexpr unsigned char kFirstRecordSequence[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+template <typename Info>
+void FillKernelTLSRecordInfo(Info* info,
+                             uint16_t cipher_type,
+                             const unsigned char* key) {
+  info->info.version = TLS_1_2_VERSION;
+  info->info.cipher_type = cipher_type;
+  memcpy(info->key, key, sizeof(info->key));
+  memcpy(info->rec_seq, kFirstRecordSequence, sizeof(info->rec_seq));
+}
+
+// AES-GCM splits the nonce into the implicit salt from the key block and an
+// explicit part that only has to be unique.
+template <typename Info>
+size_t FillKernelTLSGCMInfo(Info* info,
+                            uint16_t cipher_type,
+                            const unsigned char* key,
+                            const unsigned char* salt) {
+  FillKernelTLSRecordInfo(info, cipher_type, key);
+  memcpy(info->salt, salt, sizeof(info->salt));
+  memcpy(info->iv, kFirstRecordSequence, sizeof(info->iv));
+  return sizeof(*info);
+}
+
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+// ChaCha20-Poly1305 XORs the sequence number into the full write IV.
+size_t FillKernelTLSChaCha20Info(KernelTLSChaCha20Poly1305Info* info,
+                                 const unsigned char* key,
+                                 const unsigned char* iv) {
+  FillKernelTLSRecordInfo(info, TLS_CIPHER_CHACHA20_POLY1305, key);
+  memcpy(info->iv, iv, sizeof(info->iv));
+  return sizeof(*info);
+}
+#endif
+
+// Derives this side's TLS 1.2 write key and IV from the master secret
+// (RFC 5246, section 6.3) and fills in the kernel's crypto_info for it.
+// Returns the size of the structure, or 0 if the negotiated cipher cannot
+// be offloaded.
+size_t GetKernelTLSCryptoInfo(SSL* ssl,
+                              bool is_server,
+                              KernelTLSCryptoInfo* out) {
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr)
+    return 0;
+
+  size_t key_len;
+  size_t iv_len;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      iv_len = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+      break;
+#ifdef TLS_CIPHER_AES_GCM_256
+    case NID_aes_256_gcm:
+      key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      iv_len = TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+      break;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case NID_chacha20_poly1305:
+      key_len = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+      iv_len = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+      break;
+#endif
+    default:
+      return 0;
+  }
+
+  const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+  SSL_SESSION* session = SSL_get_session(ssl);
+  if (md == nullptr || session == nullptr)
+    return 0;
+
+  unsigned char master_key[SSL_MAX_MASTER_KEY_LENGTH];
+  unsigned char client_random[SSL3_RANDOM_SIZE];
+  unsigned char server_random[SSL3_RANDOM_SIZE];
+  // AEAD ciphers have no MAC keys, so the key block is
+  // client_write_key, server_write_key, client_write_IV, server_write_IV.
+  unsigned char key_block[2 * (32 + 12)];
+  size_t key_block_len = 2 * (key_len + iv_len);
+  CHECK_LE(key_block_len, sizeof(key_block));
+
+  size_t master_key_len =
+      SSL_SESSION_get_master_key(session, master_key, sizeof(master_key));
+  if (master_key_len == 0 ||
+      SSL_get_client_random(ssl, client_random, sizeof(client_random)) !=
+          sizeof(client_random) ||
+      SSL_get_server_random(ssl, server_random, sizeof(server_random)) !=
+          sizeof(server_random)) {
+    return 0;
+  }
+
+  static const char kLabel[] = "key expansion";
+  EVPKeyCtxPointer ctx(EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr));
+  bool ok =
+      ctx &&
+      EVP_PKEY_derive_init(ctx.get()) > 0 &&
+      EVP_PKEY_CTX_set_tls1_prf_md(ctx.get(), md) > 0 &&
+      EVP_PKEY_CTX_set1_tls1_prf_secret(
+          ctx.get(), master_key, master_key_len) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          ctx.get(), kLabel, sizeof(kLabel) - 1) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          ctx.get(), server_random, sizeof(server_random)) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          ctx.get(), client_random, sizeof(client_random)) > 0 &&
+      EVP_PKEY_derive(ctx.get(), key_block, &key_block_len) > 0;
+  OPENSSL_cleanse(master_key, sizeof(master_key));
+
+  size_t len = 0;
+  if (ok) {
+    const unsigned char* key = key_block + (is_server ? key_len : 0);
+    const unsigned char* iv =
+        key_block + 2 * key_len + (is_server ? iv_len : 0);
+    switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+      case NID_aes_128_gcm:
+        len = FillKernelTLSGCMInfo(
+            &out->aes_gcm_128, TLS_CIPHER_AES_GCM_128, key, iv);
+        break;
+#ifdef TLS_CIPHER_AES_GCM_256
+      case NID_aes_256_gcm:
+        len = FillKernelTLSGCMInfo(
+            &out->aes_gcm_256, TLS_CIPHER_AES_GCM_256, key, iv);
+        break;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+      case NID_chacha20_poly1305:
+        len = FillKernelTLSChaCha20Info(&out->chacha20_poly1305, key, iv);
+        break;
+#endif
+    }
+  }
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  return len;
+}
+#endif  // __linux__
 }  // namespace
 
 TLSWrap::TLSWrap(Environment* env,
@@ -554,7 +733,7 @@ void TLSWrap::EncOut() {
   }
 
   // Write in progress
-  if (write_size_ != 0) {
+  if (write_size_ != 0 || ktls_write_pending_) {
     Debug(this, "Returning from EncOut(), write currently in progress");
     return;
   }
@@ -602,6 +781,19 @@ void TLSWrap::EncOut() {
     return;
   }
 
+  if (ktls_active_) {
+    // OpenSSL's write state went stale when the kernel took over, so any
+    // record it produces now (in practice, the answer to a renegotiation
+    // request) cannot be sent. Drop it and fail the connection.
+    Debug(this, "Discarding OpenSSL output after switching to kernel TLS");
+    NodeBIO::FromBIO(enc_out_)->Reset();
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+    Local<Value> arg = ERR_TLS_RENEGOTIATION_DISABLED(env()->isolate());
+    MakeCallback(env()->onerror_string(), 1, &arg);
+    return;
+  }
+
   char* data[kSimultaneousBufferCount];
   size_t size[arraysize(data)];
   size_t count = arraysize(data);
@@ -644,6 +836,13 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
     return;
   }
 
+  if (ktls_write_pending_) {
+    Debug(this, "Kernel TLS write finished");
+    ktls_write_pending_ = false;
+    InvokeQueued(ssl_ == nullptr ? UV_ECANCELED : status);
+    return;
+  }
+
   if (ssl_ == nullptr) {
     Debug(this, "ssl_ == nullptr, marking as cancelled");
     status = UV_ECANCELED;
@@ -866,6 +1065,8 @@ void TLSWrap::ClearIn() {
   // All written
   if (written != -1) {
     Debug(this, "Successfully wrote all data to SSL");
+    if (established_)
+      wrote_after_handshake_ = true;
     return;
   }
 
@@ -954,6 +1155,10 @@ int TLSWrap::DoWrite(WriteWrap* w,
     return UV_EPROTO;
   }
 
+  MaybeStartKernelTLS();
+  if (ktls_active_)
+    return DoKernelTLSWrite(w, bufs, count);
+
   size_t length = 0;
   size_t i;
   size_t nonempty_i = 0;
@@ -1042,6 +1247,8 @@ int TLSWrap::DoWrite(WriteWrap* w,
 
   CHECK(written == -1 || written == static_cast<int>(length));
   Debug(this, "Writing %zu bytes, written = %d", length, written);
+  if (written != -1 && established_)
+    wrote_after_handshake_ = true;
 
   if (written == -1) {
     int err;
@@ -1129,7 +1336,9 @@ int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
   Debug(this, "DoShutdown()");
   MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  if (ssl_ && SSL_shutdown(ssl_.get()) == 0)
+  if (ktls_active_)
+    SendKernelTLSCloseNotify();
+  else if (ssl_ && SSL_shutdown(ssl_.get()) == 0)
     SSL_shutdown(ssl_.get());
 
   shutdown_ = true;
@@ -1185,6 +1394,146 @@ void TLSWrap::EnableSessionCallbacks(const FunctionCallbackInfo<Value>& args) {
                             wrap);
 }
 
+void TLSWrap::EnableKernelTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+#ifdef __linux__
+  // There is no kernel socket state to hand the keys to when replaying.
+  if (v8::recordreplay::IsRecordingOrReplaying())
+    return;
+  wrap->ktls_requested_ = true;
+#endif
+}
+
+void TLSWrap::IsKernelTLSActive(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  args.GetReturnValue().Set(wrap->ktls_active_);
+}
+
+void TLSWrap::MaybeStartKernelTLS() {
+#ifdef __linux__
+  if (!ktls_requested_ || !established_)
+    return;
+  // Only one attempt is made, on the first write after the handshake. If it
+  // does not work out, OpenSSL keeps encrypting for the rest of the session.
+  ktls_requested_ = false;
+
+  // The kernel continues the record sequence where OpenSSL left off, which
+  // is only known while nothing but the handshake has been encrypted. All of
+  // that must have reached the socket, too, or the kernel would encrypt it
+  // a second time. TLS 1.3 is not supported because OpenSSL may still send
+  // session tickets or key updates after the handshake.
+  if (wrote_after_handshake_ ||
+      SSL_version(ssl_.get()) != TLS1_2_VERSION ||
+      SSL_renegotiate_pending(ssl_.get()) ||
+      BIO_pending(enc_out_) != 0 ||
+      write_size_ != 0 ||
+      pending_cleartext_input_.size() != 0) {
+    Debug(this, "Not switching to kernel TLS, connection is not idle");
+    return;
+  }
+
+  AsyncWrap* underlying = underlying_stream()->GetAsyncWrap();
+  if (underlying == nullptr ||
+      underlying->provider_type() != AsyncWrap::PROVIDER_TCPWRAP) {
+    return;
+  }
+  LibuvStreamWrap* wrap = static_cast<LibuvStreamWrap*>(underlying_stream());
+  if (wrap->has_pending_writes()) {
+    Debug(this, "Not switching to kernel TLS, handshake still queued");
+    return;
+  }
+
+  KernelTLSCryptoInfo crypto_info;
+  size_t crypto_info_len =
+      GetKernelTLSCryptoInfo(ssl_.get(), is_server(), &crypto_info);
+  if (crypto_info_len == 0) {
+    Debug(this, "Not switching to kernel TLS, unsupported cipher");
+    return;
+  }
+
+  int fd = underlying_stream()->GetFD();
+  int err = setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls"));
+  if (err == 0)
+    err = setsockopt(fd, SOL_TLS, TLS_TX, &crypto_info, crypto_info_len);
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  if (err != 0) {
+    Debug(this, "Kernel TLS is not available (%s)", strerror(errno));
+    return;
+  }
+
+  // Refuse renegotiation rather than attempt it with stale write keys.
+  SSL_set_options(ssl_.get(), SSL_OP_NO_RENEGOTIATION);
+  ktls_active_ = true;
+  Debug(this, "Switched to kernel TLS for writing");
+#endif  // __linux__
+}
+
+int TLSWrap::DoKernelTLSWrite(WriteWrap* w, uv_buf_t* bufs, size_t count) {
+  // The kernel encrypts whatever is written to the socket, so cleartext goes
+  // to the underlying stream as is.
+  CHECK(!current_write_);
+  current_write_.reset(w->GetAsyncWrap());
+  write_callback_scheduled_ = true;
+
+  StreamWriteResult res = underlying_stream()->Write(bufs, count);
+  if (res.err != 0) {
+    current_write_.reset();
+    return res.err;
+  }
+
+  ktls_write_pending_ = true;
+  if (!res.async) {
+    // Done() must not be called synchronously from DoWrite().
+    BaseObjectPtr<TLSWrap> strong_ref{this};
+    env()->SetImmediate([this, strong_ref](Environment* env) {
+      OnStreamAfterWrite(nullptr, 0);
+    });
+  }
+  return 0;
+}
+
+void TLSWrap::SendKernelTLSCloseNotify() {
+#ifdef __linux__
+  if (ssl_ == nullptr)
+    return;
+
+  // Keep OpenSSL from ever encrypting an alert of its own.
+  SSL_set_shutdown(ssl_.get(),
+                   SSL_get_shutdown(ssl_.get()) | SSL_SENT_SHUTDOWN);
+
+  // The alert must not overtake application data that libuv still holds.
+  // In that case the connection is closed without it, like a quiet shutdown.
+  LibuvStreamWrap* wrap = static_cast<LibuvStreamWrap*>(underlying_stream());
+  if (wrap->has_pending_writes())
+    return;
+
+  unsigned char alert[] = { 1 /* warning */, 0 /* close_notify */ };
+  char control[CMSG_SPACE(sizeof(unsigned char))];
+  iovec iov;
+  iov.iov_base = alert;
+  iov.iov_len = sizeof(alert);
+  msghdr msg = {};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+  *CMSG_DATA(cmsg) = SSL3_RT_ALERT;
+
+  ssize_t r;
+  do {
+    r = sendmsg(wrap->GetFD(), &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+  } while (r == -1 && errno == EINTR);
+  if (r != static_cast<ssize_t>(sizeof(alert)))
+    Debug(this, "Failed to send close_notify through kernel TLS");
+#endif  // __linux__
+}
+
 void TLSWrap::EnableKeylogCallback(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -2028,6 +2377,7 @@ void TLSWrap::Initialize(
   env->SetProtoMethod(t, "certCbDone", CertCbDone);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
+  env->SetProtoMethod(t, "enableKernelTLS", EnableKernelTLS);
   env->SetProtoMethod(t, "endParser", EndParser);
   env->SetProtoMethod(t, "enableKeylogCallback", EnableKeylogCallback);
   env->SetProtoMethod(t, "enableSessionCallbacks", EnableSessionCallbacks);
@@ -2047,6 +2397,7 @@ void TLSWrap::Initialize(
 
   env->SetProtoMethodNoSideEffect(t, "exportKeyingMaterial",
                                   ExportKeyingMaterial);
+  env->SetProtoMethodNoSideEffect(t, "isKernelTLSActive", IsKernelTLSActive);
   env->SetProtoMethodNoSideEffect(t, "isSessionReused", IsSessionReused);
   env->SetProtoMethodNoSideEffect(t, "getALPNNegotiatedProtocol",
                                   GetALPNNegotiatedProto);
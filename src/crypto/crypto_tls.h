@@ -158,6 +158,12 @@ class TLSWrap : public AsyncWrap,
   // underlying stream even if there is no clear text to read or write.
   void Cycle();
 
+  // Hand the transmit side of the record layer to the kernel (Linux kTLS)
+  // once the handshake has been flushed. See EnableKernelTLS().
+  void MaybeStartKernelTLS();
+  int DoKernelTLSWrite(WriteWrap* w, uv_buf_t* bufs, size_t count);
+  void SendKernelTLSCloseNotify();
+
   // Implement StreamListener:
   // Returns buf that points into enc_in_.
   uv_buf_t OnStreamAlloc(size_t size) override;
@@ -173,6 +179,7 @@ class TLSWrap : public AsyncWrap,
   static void CertCbDone(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableCertCb(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableKernelTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableKeylogCallback(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableSessionCallbacks(
@@ -198,6 +205,8 @@ class TLSWrap : public AsyncWrap,
   static void GetTLSTicket(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void IsKernelTLSActive(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void IsSessionReused(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void LoadSession(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void NewSessionDone(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -272,6 +281,14 @@ class TLSWrap : public AsyncWrap,
   bool established_ = false;
   bool write_callback_scheduled_ = false;
 
+  // Kernel TLS offload. Once ktls_active_ is set the kernel owns the write
+  // state of the connection: cleartext is written straight to the socket and
+  // OpenSSL must not produce any more records. Reads still go through OpenSSL.
+  bool ktls_requested_ = false;
+  bool ktls_active_ = false;
+  bool ktls_write_pending_ = false;
+  bool wrote_after_handshake_ = false;
+
   int cycle_depth_ = 0;
 
   // SSL_set_cert_cb
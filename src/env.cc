@@ -879,13 +879,19 @@ void Environment::CheckImmediate(uv_check_t* handle) {
   // We're near the top of the event loop, periodically create new
   // checkpoints so that the recording can be processed more efficiently.
   if (v8::IsMainThread()) {
-    v8::recordreplay::NewCheckpoint();
+    recordreplay::MaybeNewCheckpoint();
   }
 
   Environment* env = Environment::from_immediate_check_handle(handle);
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "CheckImmediate", env);
 
+  if (env->worker_context() != nullptr) {
+    env->worker_context()->MaybeExitNearHeapLimit();
+    if (!env->can_call_into_js())
+      return;
+  }
+
   HandleScope scope(env->isolate());
   Context::Scope context_scope(env->context());
 
@@ -4,6 +4,9 @@
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 using v8::Array;
 using v8::Boolean;
 using v8::Context;
@@ -13,7 +16,10 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
+using v8::HeapGraphEdge;
+using v8::HeapGraphNode;
 using v8::HeapSnapshot;
+using v8::Integer;
 using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
@@ -365,6 +371,288 @@ void CreateHeapSnapshotStream(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(stream->object());
 }
 
+namespace {
+class StringOutputStream : public v8::OutputStream {
+ public:
+  explicit StringOutputStream(std::string* out) : out_(out) {}
+
+  int GetChunkSize() override {
+    return 65536;  // big chunks == faster
+  }
+
+  void EndOfStream() override {}
+
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    out_->append(data, size);
+    return kContinue;
+  }
+
+ private:
+  std::string* out_;
+};
+
+// Dominator tree and retained sizes for a heap snapshot, computed with the
+// iterative algorithm from Cooper, Harvey and Kennedy, "A Simple, Fast
+// Dominance Algorithm". Weak edges are ignored, as they don't retain anything.
+class HeapSnapshotDominators {
+ public:
+  explicit HeapSnapshotDominators(const HeapSnapshot* snapshot) {
+    ComputePostOrder(snapshot->GetRoot());
+    ComputeDominators();
+    ComputeRetainedSizes();
+  }
+
+  size_t node_count() const { return nodes_.size(); }
+  const HeapGraphNode* node(uint32_t index) const { return nodes_[index]; }
+  size_t retained_size(uint32_t index) const { return retained_[index]; }
+
+ private:
+  static constexpr uint32_t kNone = static_cast<uint32_t>(-1);
+
+  static bool IsRetainingEdge(const HeapGraphEdge* edge) {
+    return edge->GetType() != HeapGraphEdge::kWeak;
+  }
+
+  // Nodes are indexed in post order, so the root has the highest index.
+  void ComputePostOrder(const HeapGraphNode* root) {
+    std::unordered_map<const HeapGraphNode*, uint32_t> visited;
+    std::vector<std::pair<const HeapGraphNode*, int>> stack;
+    visited[root] = kNone;
+    stack.emplace_back(root, 0);
+    while (!stack.empty()) {
+      const HeapGraphNode* node = stack.back().first;
+      int child = stack.back().second;
+      if (child < node->GetChildrenCount()) {
+        stack.back().second++;
+        const HeapGraphEdge* edge = node->GetChild(child);
+        if (!IsRetainingEdge(edge)) continue;
+        const HeapGraphNode* to = edge->GetToNode();
+        if (visited.emplace(to, kNone).second)
+          stack.emplace_back(to, 0);
+        continue;
+      }
+      visited[node] = static_cast<uint32_t>(nodes_.size());
+      nodes_.push_back(node);
+      stack.pop_back();
+    }
+
+    predecessors_.resize(nodes_.size());
+    for (uint32_t i = 0; i < nodes_.size(); i++) {
+      const HeapGraphNode* node = nodes_[i];
+      for (int j = 0; j < node->GetChildrenCount(); j++) {
+        const HeapGraphEdge* edge = node->GetChild(j);
+        if (!IsRetainingEdge(edge)) continue;
+        predecessors_[visited[edge->GetToNode()]].push_back(i);
+      }
+    }
+  }
+
+  uint32_t Intersect(uint32_t a, uint32_t b) const {
+    while (a != b) {
+      while (a < b) a = dominators_[a];
+      while (b < a) b = dominators_[b];
+    }
+    return a;
+  }
+
+  void ComputeDominators() {
+    const uint32_t root = static_cast<uint32_t>(nodes_.size() - 1);
+    dominators_.assign(nodes_.size(), kNone);
+    dominators_[root] = root;
+
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      // Visit nodes in reverse post order, skipping the root.
+      for (uint32_t i = root; i-- > 0;) {
+        uint32_t dominator = kNone;
+        for (uint32_t pred : predecessors_[i]) {
+          if (dominators_[pred] == kNone) continue;
+          dominator = dominator == kNone ? pred : Intersect(pred, dominator);
+        }
+        if (dominator != dominators_[i]) {
+          dominators_[i] = dominator;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  void ComputeRetainedSizes() {
+    retained_.resize(nodes_.size());
+    for (uint32_t i = 0; i < nodes_.size(); i++)
+      retained_[i] = nodes_[i]->GetShallowSize();
+    // Every node has a lower index than its dominator.
+    for (uint32_t i = 0; i + 1 < nodes_.size(); i++)
+      retained_[dominators_[i]] += retained_[i];
+  }
+
+  std::vector<const HeapGraphNode*> nodes_;
+  std::vector<std::vector<uint32_t>> predecessors_;
+  std::vector<uint32_t> dominators_;
+  std::vector<size_t> retained_;
+};
+
+// Serialized contents of the last heap snapshot taken when replaying, which
+// the driver fetches in chunks. It is kept until the next snapshot is taken
+// or it is released with ReleaseRecordReplayHeapSnapshot(), so that chunks can
+// be fetched again.
+std::string* record_replay_heap_snapshot = nullptr;
+constexpr size_t kRecordReplayHeapSnapshotChunkSize = 1024 * 1024;
+constexpr size_t kRecordReplayHeapSnapshotSummaryCount = 50;
+
+Local<Object> CreateHeapSnapshotSummary(Environment* env,
+                                        const HeapSnapshot* snapshot) {
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  HeapSnapshotDominators dominators(snapshot);
+
+  struct ConstructorStats {
+    size_t count = 0;
+    size_t self_size = 0;
+    size_t retained_size = 0;
+  };
+  std::unordered_map<std::string, ConstructorStats> constructors;
+  std::vector<uint32_t> largest;
+  size_t total_size = 0;
+  for (uint32_t i = 0; i < dominators.node_count(); i++) {
+    const HeapGraphNode* node = dominators.node(i);
+    total_size += node->GetShallowSize();
+    if (node->GetType() == HeapGraphNode::kSynthetic) continue;
+    largest.push_back(i);
+    if (node->GetType() == HeapGraphNode::kObject ||
+        node->GetType() == HeapGraphNode::kClosure) {
+      String::Utf8Value name(isolate, node->GetName());
+      ConstructorStats& stats = constructors[*name];
+      stats.count++;
+      stats.self_size += node->GetShallowSize();
+      stats.retained_size = std::max(stats.retained_size,
+                                     dominators.retained_size(i));
+    }
+  }
+
+  size_t count = std::min(largest.size(), kRecordReplayHeapSnapshotSummaryCount);
+  std::partial_sort(largest.begin(), largest.begin() + count, largest.end(),
+                    [&](uint32_t a, uint32_t b) {
+    return dominators.retained_size(a) > dominators.retained_size(b);
+  });
+
+  Local<Array> largest_array = Array::New(isolate, count);
+  for (size_t i = 0; i < count; i++) {
+    const HeapGraphNode* node = dominators.node(largest[i]);
+    Local<Object> entry = Object::New(isolate);
+    entry->Set(context, env->name_string(), node->GetName()).Check();
+    entry->Set(context, FIXED_ONE_BYTE_STRING(isolate, "id"),
+               Number::New(isolate, node->GetId())).Check();
+    entry->Set(context, FIXED_ONE_BYTE_STRING(isolate, "selfSize"),
+               Number::New(isolate, node->GetShallowSize())).Check();
+    entry->Set(context, FIXED_ONE_BYTE_STRING(isolate, "retainedSize"),
+               Number::New(isolate, dominators.retained_size(largest[i])))
+        .Check();
+    largest_array->Set(context, i, entry).Check();
+  }
+
+  std::vector<std::pair<std::string, ConstructorStats>> sorted(
+      constructors.begin(), constructors.end());
+  count = std::min(sorted.size(), kRecordReplayHeapSnapshotSummaryCount);
+  std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(),
+                    [](const auto& a, const auto& b) {
+    return a.second.self_size > b.second.self_size;
+  });
+
+  Local<Array> constructors_array = Array::New(isolate, count);
+  for (size_t i = 0; i < count; i++) {
+    Local<Object> entry = Object::New(isolate);
+    entry->Set(context, env->name_string(),
+               String::NewFromUtf8(isolate, sorted[i].first.c_str())
+                   .ToLocalChecked()).Check();
+    entry->Set(context, FIXED_ONE_BYTE_STRING(isolate, "count"),
+               Number::New(isolate, sorted[i].second.count)).Check();
+    entry->Set(context, FIXED_ONE_BYTE_STRING(isolate, "selfSize"),
+               Number::New(isolate, sorted[i].second.self_size)).Check();
+    entry->Set(context, FIXED_ONE_BYTE_STRING(isolate, "maxRetainedSize"),
+               Number::New(isolate, sorted[i].second.retained_size)).Check();
+    constructors_array->Set(context, i, entry).Check();
+  }
+
+  Local<Object> summary = Object::New(isolate);
+  summary->Set(context, FIXED_ONE_BYTE_STRING(isolate, "nodeCount"),
+               Number::New(isolate, dominators.node_count())).Check();
+  summary->Set(context, FIXED_ONE_BYTE_STRING(isolate, "totalSize"),
+               Number::New(isolate, total_size)).Check();
+  summary->Set(context, FIXED_ONE_BYTE_STRING(isolate, "largestRetainers"),
+               largest_array).Check();
+  summary->Set(context, FIXED_ONE_BYTE_STRING(isolate, "constructors"),
+               constructors_array).Check();
+  return summary;
+}
+}  // namespace
+
+// Take a heap snapshot while replaying, after diverging from the recording.
+// Its chunks are fetched with GetRecordReplayHeapSnapshotChunk(). This
+// replaces the previous snapshot.
+void TakeRecordReplayHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = args.GetIsolate();
+
+  if (!v8::recordreplay::IsReplaying() ||
+      !v8::recordreplay::HasDivergedFromRecording()) {
+    return;
+  }
+
+  HeapSnapshotPointer snapshot {
+      isolate->GetHeapProfiler()->TakeHeapSnapshot() };
+  CHECK(snapshot);
+
+  delete record_replay_heap_snapshot;
+  record_replay_heap_snapshot = new std::string();
+  StringOutputStream stream(record_replay_heap_snapshot);
+  snapshot->Serialize(&stream, HeapSnapshot::kJSON);
+
+  size_t size = record_replay_heap_snapshot->size();
+  size_t chunks = (size + kRecordReplayHeapSnapshotChunkSize - 1) /
+                  kRecordReplayHeapSnapshotChunkSize;
+
+  Local<Object> rv = Object::New(isolate);
+  rv->Set(env->context(), env->size_string(),
+          Number::New(isolate, size)).Check();
+  rv->Set(env->context(), FIXED_ONE_BYTE_STRING(isolate, "chunkCount"),
+          Number::New(isolate, chunks)).Check();
+  rv->Set(env->context(), FIXED_ONE_BYTE_STRING(isolate, "summary"),
+          CreateHeapSnapshotSummary(env, snapshot.get())).Check();
+  args.GetReturnValue().Set(rv);
+}
+
+void GetRecordReplayHeapSnapshotChunk(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  CHECK(args[0]->IsUint32());
+
+  if (record_replay_heap_snapshot == nullptr)
+    return;
+
+  size_t offset = args[0].As<Integer>()->Value() *
+                  kRecordReplayHeapSnapshotChunkSize;
+  size_t size = record_replay_heap_snapshot->size();
+  if (offset >= size)
+    return;
+
+  size_t length = std::min(size - offset, kRecordReplayHeapSnapshotChunkSize);
+  Local<String> chunk;
+  if (String::NewFromOneByte(
+          isolate,
+          reinterpret_cast<const uint8_t*>(
+              record_replay_heap_snapshot->data() + offset),
+          v8::NewStringType::kNormal,
+          length).ToLocal(&chunk)) {
+    args.GetReturnValue().Set(chunk);
+  }
+}
+
+void ReleaseRecordReplayHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
+  delete record_replay_heap_snapshot;
+  record_replay_heap_snapshot = nullptr;
+}
+
 void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = args.GetIsolate();
@@ -397,6 +685,12 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "buildEmbedderGraph", BuildEmbedderGraph);
   env->SetMethod(target, "triggerHeapSnapshot", TriggerHeapSnapshot);
   env->SetMethod(target, "createHeapSnapshotStream", CreateHeapSnapshotStream);
+  env->SetMethod(target, "takeRecordReplayHeapSnapshot",
+                 TakeRecordReplayHeapSnapshot);
+  env->SetMethod(target, "getRecordReplayHeapSnapshotChunk",
+                 GetRecordReplayHeapSnapshotChunk);
+  env->SetMethod(target, "releaseRecordReplayHeapSnapshot",
+                 ReleaseRecordReplayHeapSnapshot);
 }
 
 }  // namespace heap
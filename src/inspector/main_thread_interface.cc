@@ -200,7 +200,8 @@ class ThreadSafeDelegate : public InspectorSessionDelegate {
 }  // namespace
 
 
-MainThreadInterface::MainThreadInterface(Agent* agent) : agent_(agent) {}
+MainThreadInterface::MainThreadInterface(Agent* agent)
+    : requests_lock_(/* ordered */ true), agent_(agent) {}
 
 MainThreadInterface::~MainThreadInterface() {
   if (handle_)
@@ -210,12 +211,26 @@ MainThreadInterface::~MainThreadInterface() {
 void MainThreadInterface::Post(std::unique_ptr<Request> request) {
   CHECK_NOT_NULL(agent_);
 
-  // When recording/replaying this is single threaded, and we don't want to
-  // interrupt V8 because that will invalidate the recording.
+  // When recording/replaying we don't want to interrupt V8 because that will
+  // invalidate the recording. Requests posted on the main thread are handled
+  // immediately, and requests from worker threads are handled from the main
+  // thread's event loop, in the order established by requests_lock_.
   if (v8::recordreplay::IsRecordingOrReplaying()) {
-    CHECK(v8::IsMainThread());
-    requests_.push_back(std::move(request));
-    DispatchMessages();
+    bool needs_notify;
+    {
+      Mutex::ScopedLock scoped_lock(requests_lock_);
+      needs_notify = requests_.empty();
+      requests_.push_back(std::move(request));
+      incoming_message_cond_.Broadcast(scoped_lock);
+    }
+    if (v8::IsMainThread()) {
+      DispatchMessages();
+    } else if (needs_notify) {
+      std::weak_ptr<MainThreadInterface> weak_self {shared_from_this()};
+      agent_->env()->SetImmediateThreadsafe([weak_self](Environment*) {
+        if (auto iface = weak_self.lock()) iface->DispatchMessages();
+      });
+    }
     return;
   }
 
@@ -19,6 +19,8 @@
 #include "v8-inspector.h"
 #include "v8-platform.h"
 
+#include "inspector/Runtime.h"  // V8's exported protocol types
+
 #include "libplatform/libplatform.h"
 
 #ifdef __POSIX__
@@ -265,6 +267,28 @@ class ChannelImpl final : public v8_inspector::V8Inspector::Channel,
     session_->schedulePauseOnNextStatement(buffer->string(), buffer->string());
   }
 
+  std::string wrapObject(Local<Context> context, Local<Value> value) {
+    std::unique_ptr<v8_inspector::protocol::Runtime::API::RemoteObject>
+        remote_object = session_->wrapObject(context, value, StringView(),
+                                             false);
+    if (!remote_object)
+      return std::string();
+    std::vector<uint8_t> cbor;
+    remote_object->AppendSerialized(&cbor);
+    std::unique_ptr<protocol::Value> parsed =
+        protocol::Value::parseBinary(cbor.data(), cbor.size());
+    if (!parsed)
+      return std::string();
+    return parsed->toJSONString();
+  }
+
+  bool unwrapObject(const std::string& object_id, Local<Value>* value) {
+    std::unique_ptr<StringBuffer> id = Utf8ToStringView(object_id);
+    Local<Context> context;
+    return session_->unwrapObject(nullptr, id->string(), value, &context,
+                                  nullptr);
+  }
+
   bool preventShutdown() {
     return prevent_shutdown_;
   }
@@ -335,6 +359,9 @@ class SameThreadInspectorSession : public InspectorSession {
       : session_id_(session_id), client_(client) {}
   ~SameThreadInspectorSession() override;
   void Dispatch(const v8_inspector::StringView& message) override;
+  std::string WrapObject(Local<Context> context, Local<Value> value) override;
+  bool UnwrapObject(const std::string& object_id,
+                    Local<Value>* value) override;
 
  private:
   int session_id_;
@@ -480,6 +507,18 @@ class NodeInspectorClient : public V8InspectorClient {
     channels_[session_id]->dispatchProtocolMessage(message);
   }
 
+  std::string wrapObject(int session_id,
+                         Local<Context> context,
+                         Local<Value> value) {
+    return channels_[session_id]->wrapObject(context, value);
+  }
+
+  bool unwrapObject(int session_id,
+                    const std::string& object_id,
+                    Local<Value>* value) {
+    return channels_[session_id]->unwrapObject(object_id, value);
+  }
+
   Local<Context> ensureDefaultContextInGroup(int contextGroupId) override {
     return env_->context();
   }
@@ -955,5 +994,21 @@ void SameThreadInspectorSession::Dispatch(
     client->dispatchMessageFromFrontend(session_id_, message);
 }
 
+std::string SameThreadInspectorSession::WrapObject(Local<Context> context,
+                                                   Local<Value> value) {
+  auto client = client_.lock();
+  if (!client)
+    return std::string();
+  return client->wrapObject(session_id_, context, value);
+}
+
+bool SameThreadInspectorSession::UnwrapObject(const std::string& object_id,
+                                              Local<Value>* value) {
+  auto client = client_.lock();
+  if (!client)
+    return false;
+  return client->unwrapObject(session_id_, object_id, value);
+}
+
 }  // namespace inspector
 }  // namespace node
@@ -11,6 +11,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
 
 namespace v8_inspector {
 class StringView;
@@ -31,6 +32,18 @@ class InspectorSession {
  public:
   virtual ~InspectorSession() = default;
   virtual void Dispatch(const v8_inspector::StringView& message) = 0;
+  // Returns the JSON for a Runtime.RemoteObject that refers to value in this
+  // session, or an empty string if the value could not be wrapped.
+  virtual std::string WrapObject(v8::Local<v8::Context> context,
+                                 v8::Local<v8::Value> value) {
+    return std::string();
+  }
+  // Looks up the value that a RemoteObject's objectId refers to in this
+  // session. Returns false if there is no such object.
+  virtual bool UnwrapObject(const std::string& object_id,
+                            v8::Local<v8::Value>* value) {
+    return false;
+  }
 };
 
 class InspectorSessionDelegate {
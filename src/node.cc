@@ -453,7 +453,7 @@ MaybeLocal<Value> StartExecution(Environment* env, const char* main_script_id) {
 
 MaybeLocal<Value> StartExecution(Environment* env, StartExecutionCallback cb) {
   if (v8::IsMainThread()) {
-    v8::recordreplay::NewCheckpoint();
+    recordreplay::NewCheckpoint();
   }
 
   InternalCallbackScope callback_scope(
@@ -986,10 +986,112 @@ void EndCallbackRegion() {
   }
 }
 
+// Checkpoint policy. Checkpoints are only considered where
+// MaybeNewCheckpoint() is called, which is once per iteration of the main
+// thread's event loop, from its check phase. By default a checkpoint is
+// created every time. With --record-replay-checkpoint-progress or
+// --record-replay-checkpoint-interval, or the RECORD_REPLAY_CHECKPOINT_PROGRESS
+// and RECORD_REPLAY_CHECKPOINT_INTERVAL_MS environment variables they
+// override, a checkpoint is only created once the progress counter has
+// advanced by the given amount or the given number of milliseconds have
+// elapsed since the last checkpoint. These are lower bounds: a long loop
+// iteration still gets at most one checkpoint.
+static uint64_t gCheckpointMinProgress;
+static uint64_t gCheckpointMinIntervalNs;
+
+static uint64_t gLastCheckpointProgress;
+static uint64_t gLastCheckpointTime;
+
+static size_t gCheckpointCandidates;
+static size_t gCheckpointsCreated;
+
+static uint64_t GetCheckpointSetting(int64_t option, const char* name) {
+  if (option >= 0)
+    return option;
+  const char* env = getenv(name);
+  return env ? strtoull(env, nullptr, 10) : 0;
+}
+
+static void InitializeCheckpointPolicy() {
+  uint64_t min_progress = GetCheckpointSetting(
+      per_process::cli_options->record_replay_checkpoint_progress,
+      "RECORD_REPLAY_CHECKPOINT_PROGRESS");
+  uint64_t min_interval_ms = GetCheckpointSetting(
+      per_process::cli_options->record_replay_checkpoint_interval,
+      "RECORD_REPLAY_CHECKPOINT_INTERVAL_MS");
+
+  // The configuration decides whether MaybeNewCheckpoint() records a value,
+  // so use the recorded configuration when replaying, whatever the
+  // command line and environment are then.
+  gCheckpointMinProgress =
+      v8::recordreplay::RecordReplayValue("CheckpointMinProgress",
+                                          min_progress);
+  gCheckpointMinIntervalNs =
+      v8::recordreplay::RecordReplayValue("CheckpointMinIntervalMs",
+                                          min_interval_ms) * 1000 * 1000;
+}
+
+CheckpointStats GetCheckpointStats() {
+  CheckpointStats stats;
+  stats.min_progress = gCheckpointMinProgress;
+  stats.min_interval_ms = gCheckpointMinIntervalNs / (1000 * 1000);
+  stats.candidates = gCheckpointCandidates;
+  stats.created = gCheckpointsCreated;
+  stats.progress = v8::recordreplay::ProgressCounter();
+  return stats;
+}
+
+static void PrintCheckpointStats() {
+  v8::recordreplay::Diagnostic(
+      "CheckpointStats Created %zu Candidates %zu Progress %llu",
+      gCheckpointsCreated, gCheckpointCandidates,
+      (unsigned long long)v8::recordreplay::ProgressCounter());
+}
+
+void NewCheckpoint() {
+  if (!v8::recordreplay::IsRecordingOrReplaying()) {
+    return;
+  }
+
+  v8::recordreplay::NewCheckpoint();
+  gCheckpointsCreated++;
+  gLastCheckpointProgress = v8::recordreplay::ProgressCounter();
+  if (v8::recordreplay::IsRecording()) {
+    gLastCheckpointTime = uv_hrtime();
+  }
+}
+
+void MaybeNewCheckpoint() {
+  if (!v8::recordreplay::IsRecordingOrReplaying()) {
+    return;
+  }
+
+  gCheckpointCandidates++;
+
+  bool create = true;
+  if (gCheckpointMinProgress || gCheckpointMinIntervalNs) {
+    // Elapsed time isn't reproducible, so the decision is only made when
+    // recording. The recorded decision is used when replaying.
+    if (v8::recordreplay::IsRecording()) {
+      uint64_t progress =
+          v8::recordreplay::ProgressCounter() - gLastCheckpointProgress;
+      uint64_t elapsed = uv_hrtime() - gLastCheckpointTime;
+      create = (gCheckpointMinProgress && progress >= gCheckpointMinProgress) ||
+               (gCheckpointMinIntervalNs && elapsed >= gCheckpointMinIntervalNs);
+    }
+    create = v8::recordreplay::RecordReplayValue("MaybeNewCheckpoint", create);
+  }
+
+  if (create) {
+    NewCheckpoint();
+  }
+}
+
 } // namespace recordreplay
 
 void RecordReplayFinishRecording() {
   if (gRecordReplayFinishRecording) {
+    recordreplay::PrintCheckpointStats();
     gRecordReplayFinishRecording();
     recordreplay::gRecordingFinished = true;
 
@@ -1180,6 +1282,10 @@ InitializationResult InitializeOncePerProcess(int* pargc, char*** pargv) {
     }
   }
 
+  // This needs the command line options, and must run before the event loop
+  // starts considering checkpoints.
+  recordreplay::InitializeCheckpointPolicy();
+
   if (per_process::cli_options->use_largepages == "on" ||
       per_process::cli_options->use_largepages == "silent") {
     int result = node::MapStaticCodeToLargePages();
@@ -684,7 +684,6 @@ inline void NODE_SET_PROTOTYPE_METHOD(v8::Local<v8::FunctionTemplate> recv,
 #define NODE_SET_PROTOTYPE_METHOD node::NODE_SET_PROTOTYPE_METHOD
 
 // BINARY is a deprecated alias of LATIN1.
-// BASE64URL is not currently exposed to the JavaScript side.
 enum encoding {
   ASCII,
   UTF8,
@@ -1099,6 +1098,25 @@ bool IsRecordingFinished();
 void BeginCallbackRegion();
 void EndCallbackRegion();
 
+// Create a checkpoint unconditionally. This must be called when there are no
+// JS frames on the stack.
+void NewCheckpoint();
+
+// Create a checkpoint if the checkpoint policy wants one at this point.
+// This must be called when there are no JS frames on the stack.
+void MaybeNewCheckpoint();
+
+// The checkpoint policy's settings, and how it has been applied so far.
+struct CheckpointStats {
+  uint64_t min_progress;
+  uint64_t min_interval_ms;
+  size_t candidates;
+  size_t created;
+  uint64_t progress;
+};
+
+CheckpointStats GetCheckpointStats();
+
 struct AutoCallbackRegion {
   AutoCallbackRegion() { BeginCallbackRegion(); }
   ~AutoCallbackRegion() { EndCallbackRegion(); }
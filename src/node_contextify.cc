@@ -30,6 +30,10 @@
 #include "module_wrap.h"
 #include "util-inl.h"
 
+#if HAVE_OPENSSL
+#include <openssl/evp.h>
+#endif
+
 namespace node {
 namespace contextify {
 
@@ -1174,6 +1178,15 @@ void ContextifyContext::CompileFunction(
           .IsNothing())
     return;
 
+  if (options == ScriptCompiler::kConsumeCodeCache) {
+    if (result
+            ->Set(parsing_context,
+                  env->cached_data_rejected_string(),
+                  Boolean::New(isolate, source.GetCachedData()->rejected))
+            .IsNothing())
+      return;
+  }
+
   if (produce_cached_data) {
     const std::unique_ptr<ScriptCompiler::CachedData> cached_data(
         ScriptCompiler::CreateCodeCacheForFunction(fn));
@@ -1201,6 +1214,51 @@ void ContextifyContext::CompileFunction(
   args.GetReturnValue().Set(result);
 }
 
+// Unlike the cache produced by compileFunction(), this one also covers the
+// inner functions that have been compiled lazily since, so it is best
+// created once the function has been run for a while.
+static void CreateCachedDataForFunction(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsFunction());
+  const std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      ScriptCompiler::CreateCodeCacheForFunction(args[0].As<Function>()));
+  if (cached_data == nullptr)
+    return;
+  Local<Object> buf;
+  if (Buffer::Copy(env,
+                   reinterpret_cast<const char*>(cached_data->data),
+                   cached_data->length).ToLocal(&buf)) {
+    args.GetReturnValue().Set(buf);
+  }
+}
+
+// Returns the SHA-256 digest of a source text as a hex string, which the
+// compile cache uses to name and check its entries. V8 only compares the
+// length of the source when it uses cache data, so the digest must be
+// collision-resistant. It is computed over UTF-16 code units, so that it does
+// not depend on how V8 stores the string. Returns undefined if Node.js was
+// built without OpenSSL, which disables the cache.
+static void HashSource(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsString());
+#if HAVE_OPENSSL
+  Isolate* isolate = args.GetIsolate();
+  TwoByteValue source(isolate, args[0]);
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_length;
+  CHECK_EQ(EVP_Digest(*source,
+                      source.length() * sizeof(**source),
+                      digest,
+                      &digest_length,
+                      EVP_sha256(),
+                      nullptr), 1);
+  char hex[2 * EVP_MAX_MD_SIZE + 1];
+  for (unsigned int i = 0; i < digest_length; i++)
+    snprintf(hex + 2 * i, 3, "%02x", digest[i]);
+  args.GetReturnValue().Set(OneByteString(isolate, hex, 2 * digest_length));
+#endif  // HAVE_OPENSSL
+}
+
 void CompiledFnEntry::WeakCallback(
     const WeakCallbackInfo<CompiledFnEntry>& data) {
   CompiledFnEntry* entry = data.GetParameter();
@@ -1348,6 +1406,10 @@ void Initialize(Local<Object> target,
   target->Set(context, env->constants_string(), constants).Check();
 
   env->SetMethod(target, "measureMemory", MeasureMemory);
+
+  env->SetMethod(
+      target, "createCachedDataForFunction", CreateCachedDataForFunction);
+  env->SetMethodNoSideEffect(target, "hashSource", HashSource);
 }
 
 }  // namespace contextify
@@ -21,8 +21,10 @@
 #include "node_file.h"  // NOLINT(build/include_inline)
 #include "node_file-inl.h"
 #include "aliased_buffer.h"
+#include "debug_utils-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_errors.h"
 #include "node_process.h"
 #include "node_stat_watcher.h"
 #include "util-inl.h"
@@ -32,6 +34,7 @@
 #include "req_wrap-inl.h"
 #include "stream_base-inl.h"
 #include "string_bytes.h"
+#include "threadpoolwork-inl.h"
 
 #include <fcntl.h>
 #include <sys/types.h>
@@ -51,6 +54,8 @@ namespace node {
 namespace fs {
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
@@ -1771,6 +1776,238 @@ static void OpenFileHandle(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Reads a whole file on a single thread pool task: open, fstat, read until
+// EOF and close.  The contents end up in one exactly sized buffer that is
+// handed to JS without copying.  fs.readFile() would otherwise need a JS
+// round trip, a new FSReqCallback and a thread pool hop for every chunk.
+class ReadFileJob final : public ThreadPoolWork {
+ public:
+  ReadFileJob(FSReqBase* req_wrap,
+              std::string&& path,
+              int flags,
+              enum encoding encoding)
+      : ThreadPoolWork(req_wrap->env()),
+        req_wrap_(req_wrap),
+        path_(std::move(path)),
+        flags_(flags),
+        encoding_(encoding) {}
+
+  ~ReadFileJob() override { free(data_); }
+
+  void DoThreadPoolWork() override;
+  void AfterThreadPoolWork(int status) override;
+
+  ReadFileJob(const ReadFileJob&) = delete;
+  ReadFileJob& operator=(const ReadFileJob&) = delete;
+
+ private:
+  // Same as kIoMaxLength in lib/internal/fs/utils.js.
+  static constexpr uint64_t kMaxLength = INT32_MAX;
+  // Buffer size to start with when the file size is not known up front.
+  static constexpr size_t kUnknownSizeLength = 64 * 1024;
+
+  void ReadAll(uv_file fd);
+  void SetError(int err, const char* syscall) {
+    if (err_ == 0) {
+      err_ = err;
+      syscall_ = syscall;
+    }
+  }
+
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  const std::string path_;
+  const int flags_;
+  const enum encoding encoding_;
+
+  // Results, written on the thread pool and read back on the loop thread.
+  int err_ = 0;
+  const char* syscall_ = nullptr;
+  bool too_large_ = false;
+  uint64_t size_ = 0;
+  char* data_ = nullptr;
+  size_t length_ = 0;
+  bool is_ascii_ = false;
+};
+
+void ReadFileJob::DoThreadPoolWork() {
+  // Passing no loop and no callback runs each request synchronously on this
+  // thread.
+  uv_fs_t req;
+  const int fd = uv_fs_open(nullptr, &req, path_.c_str(), flags_, 0666,
+                            nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0) {
+    SetError(fd, "open");
+    return;
+  }
+
+  ReadAll(fd);
+
+  const int err = uv_fs_close(nullptr, &req, fd, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err < 0)
+    SetError(err, "close");
+
+  // UTF-8 decoding is the common case and can be skipped altogether when
+  // the contents are plain ASCII, find that out while we're off the loop.
+  if (err_ == 0 && !too_large_ && encoding_ == UTF8) {
+    is_ascii_ = true;
+    for (size_t i = 0; i < length_; i++) {
+      if (static_cast<uint8_t>(data_[i]) >= 0x80) {
+        is_ascii_ = false;
+        break;
+      }
+    }
+  }
+}
+
+void ReadFileJob::ReadAll(uv_file fd) {
+  uv_fs_t req;
+  int err = uv_fs_fstat(nullptr, &req, fd, nullptr);
+  if (err < 0) {
+    uv_fs_req_cleanup(&req);
+    SetError(err, "fstat");
+    return;
+  }
+  // Pipes, character devices and files in /proc report a size of zero,
+  // those are read until EOF instead.
+  if ((req.statbuf.st_mode & S_IFMT) == S_IFREG)
+    size_ = req.statbuf.st_size;
+  uv_fs_req_cleanup(&req);
+
+  if (size_ > kMaxLength) {
+    too_large_ = true;
+    return;
+  }
+
+  size_t capacity = size_ > 0 ? size_ : kUnknownSizeLength;
+  data_ = UncheckedMalloc(capacity);
+  if (data_ == nullptr) {
+    SetError(UV_ENOMEM, "read");
+    return;
+  }
+
+  for (;;) {
+    if (length_ == capacity) {
+      // Like the JS implementation, don't read past the size reported by
+      // fstat() if the file grows while we're reading it.
+      if (size_ > 0)
+        break;
+      if (capacity >= kMaxLength) {
+        too_large_ = true;
+        size_ = capacity;
+        return;
+      }
+      capacity = std::min<size_t>(capacity * 2, kMaxLength);
+      char* data = UncheckedRealloc(data_, capacity);
+      if (data == nullptr) {
+        SetError(UV_ENOMEM, "read");
+        return;
+      }
+      data_ = data;
+    }
+
+    uv_buf_t buf = uv_buf_init(data_ + length_, capacity - length_);
+    err = uv_fs_read(nullptr, &req, fd, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err < 0) {
+      SetError(err, "read");
+      return;
+    }
+    if (err == 0)
+      break;
+    length_ += err;
+  }
+
+  // Give back what was over-allocated for files of unknown size, or that
+  // shrank since fstat().
+  if (length_ > 0 && length_ < capacity) {
+    char* data = UncheckedRealloc(data_, length_);
+    if (data != nullptr)
+      data_ = data;
+  }
+}
+
+void ReadFileJob::AfterThreadPoolWork(int status) {
+  std::unique_ptr<ReadFileJob> self(this);
+  Environment* env = this->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+  req_wrap->Detach();
+
+  if (status < 0)
+    SetError(status, "read");
+
+  if (err_ < 0) {
+    // Only open() errors carry the path, as with fs.open() and fs.read().
+    const char* path = strcmp(syscall_, "open") == 0 ? path_.c_str() : nullptr;
+    return req_wrap->Reject(UVException(isolate, err_, syscall_, nullptr, path));
+  }
+
+  if (too_large_) {
+    std::string message =
+        SPrintF("File size (%d) is greater than 2 GB", size_);
+    return req_wrap->Reject(ERR_FS_FILE_TOO_LARGE(isolate, message.c_str()));
+  }
+
+  Local<Value> result;
+  if (encoding_ == BUFFER) {
+    std::unique_ptr<BackingStore> backing_store =
+        ArrayBuffer::NewBackingStore(
+            data_,
+            length_,
+            [](void* data, size_t length, void* deleter_data) { free(data); },
+            nullptr);
+    data_ = nullptr;
+    Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(backing_store));
+    Local<Object> buffer;
+    if (!Buffer::New(env, ab, 0, length_).ToLocal(&buffer))
+      return;
+    result = buffer;
+  } else {
+    Local<Value> error;
+    if (!StringBytes::Encode(isolate,
+                             data_,
+                             length_,
+                             is_ascii_ ? LATIN1 : encoding_,
+                             &error).ToLocal(&result)) {
+      CHECK(!error.IsEmpty());
+      return req_wrap->Reject(error);
+    }
+  }
+
+  req_wrap->Resolve(result);
+}
+
+// readFile(path, flags, encoding, req)
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 4);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  const enum encoding encoding = ParseEncoding(isolate, args[2], BUFFER);
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 3);
+  CHECK_NOT_NULL(req_wrap_async);
+  ReadFileJob* job = new ReadFileJob(req_wrap_async,
+                                     std::string(*path, path.length()),
+                                     flags,
+                                     encoding);
+  job->ScheduleWork();
+  req_wrap_async->SetReturnValue(args);
+}
+
 static void CopyFile(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -2410,6 +2647,7 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "close", Close);
   env->SetMethod(target, "open", Open);
   env->SetMethod(target, "openFileHandle", OpenFileHandle);
+  env->SetMethod(target, "readFile", ReadFile);
   env->SetMethod(target, "read", Read);
   env->SetMethod(target, "readBuffers", ReadBuffers);
   env->SetMethod(target, "fdatasync", Fdatasync);
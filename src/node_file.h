@@ -244,6 +244,11 @@ class FileHandle final : public AsyncWrap, public StreamBase {
 
   int GetFD() override { return fd_; }
 
+  // Position and number of bytes that ReadStart() reads from. Negative
+  // values mean the current file position and until EOF, respectively.
+  int64_t read_offset() const { return read_offset_; }
+  int64_t read_length() const { return read_length_; }
+
   // Will asynchronously close the FD and return a Promise that will
   // be resolved once closing is complete.
   static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
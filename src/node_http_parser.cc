@@ -23,6 +23,7 @@
 #include "node_buffer.h"
 #include "util.h"
 
+#include "allocated_buffer-inl.h"
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
@@ -59,10 +60,13 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Global;
 using v8::Int32;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Number;
 using v8::Object;
 using v8::String;
@@ -84,6 +88,70 @@ inline bool IsOWS(char c) {
   return c == ' ' || c == '\t';
 }
 
+struct KnownHeaderName {
+  const char* name;
+  size_t length;
+};
+
+#define V(name) { name, sizeof(name) - 1 }
+// Header names common enough to be kept around as internalized strings, so
+// that parsing them does not allocate. Both the canonical and the lower case
+// spelling are listed, since clients send either.
+const KnownHeaderName kKnownHeaderNames[] = {
+  V("Accept"), V("accept"),
+  V("Accept-Encoding"), V("accept-encoding"),
+  V("Accept-Language"), V("accept-language"),
+  V("Accept-Ranges"), V("accept-ranges"),
+  V("Age"), V("age"),
+  V("Authorization"), V("authorization"),
+  V("Cache-Control"), V("cache-control"),
+  V("Connection"), V("connection"),
+  V("Content-Encoding"), V("content-encoding"),
+  V("Content-Length"), V("content-length"),
+  V("Content-Type"), V("content-type"),
+  V("Cookie"), V("cookie"),
+  V("Date"), V("date"),
+  V("ETag"), V("etag"),
+  V("Expect"), V("expect"),
+  V("Expires"), V("expires"),
+  V("Host"), V("host"),
+  V("If-Modified-Since"), V("if-modified-since"),
+  V("If-None-Match"), V("if-none-match"),
+  V("Keep-Alive"), V("keep-alive"),
+  V("Last-Modified"), V("last-modified"),
+  V("Location"), V("location"),
+  V("Origin"), V("origin"),
+  V("Pragma"), V("pragma"),
+  V("Referer"), V("referer"),
+  V("Server"), V("server"),
+  V("Set-Cookie"), V("set-cookie"),
+  V("Transfer-Encoding"), V("transfer-encoding"),
+  V("Upgrade"), V("upgrade"),
+  V("User-Agent"), V("user-agent"),
+  V("Vary"), V("vary"),
+  V("Via"), V("via"),
+  V("X-Forwarded-For"), V("x-forwarded-for"),
+  V("X-Forwarded-Host"), V("x-forwarded-host"),
+  V("X-Forwarded-Proto"), V("x-forwarded-proto"),
+  V("X-Requested-With"), V("x-requested-with"),
+};
+#undef V
+
+// Returns the index of |str| in kKnownHeaderNames, or -1.
+int FindKnownHeaderName(const char* str, size_t size) {
+  if (size == 0)
+    return -1;
+  for (size_t i = 0; i < arraysize(kKnownHeaderNames); i++) {
+    const KnownHeaderName& known = kKnownHeaderNames[i];
+    if (known.length == size &&
+        known.name[0] == str[0] &&
+        memcmp(known.name, str, size) == 0) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
 class BindingData : public BaseObject {
  public:
   BindingData(Environment* env, Local<Object> obj)
@@ -94,11 +162,30 @@ class BindingData : public BaseObject {
   std::vector<char> parser_buffer;
   bool parser_buffer_in_use = false;
 
+  // Created on first use.
+  Local<String> known_header_name(size_t index) {
+    Isolate* isolate = env()->isolate();
+    Global<String>& name = known_header_names_[index];
+    if (name.IsEmpty()) {
+      const KnownHeaderName& known = kKnownHeaderNames[index];
+      name.Reset(isolate,
+                 String::NewFromOneByte(
+                     isolate,
+                     reinterpret_cast<const uint8_t*>(known.name),
+                     NewStringType::kInternalized,
+                     known.length).ToLocalChecked());
+    }
+    return name.Get(isolate);
+  }
+
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackField("parser_buffer", parser_buffer);
   }
   SET_SELF_SIZE(BindingData)
   SET_MEMORY_INFO_NAME(BindingData)
+
+ private:
+  Global<String> known_header_names_[arraysize(kKnownHeaderNames)];
 };
 
 // TODO(addaleax): Remove once we're on C++17.
@@ -170,11 +257,26 @@ struct StringPtr {
   }
 
 
+  // Like ToString(), but returns a shared internalized string for
+  // well-known header names instead of allocating a new one.
+  Local<String> ToHeaderName(BindingData* binding_data) const {
+    int index = FindKnownHeaderName(str_, size_);
+    if (index != -1)
+      return binding_data->known_header_name(index);
+    return ToString(binding_data->env());
+  }
+
+
   // Strip trailing OWS (SPC or HTAB) from string.
-  Local<String> ToTrimmedString(Environment* env) {
+  void Trim() {
     while (size_ > 0 && IsOWS(str_[size_ - 1])) {
       size_--;
     }
+  }
+
+
+  Local<String> ToTrimmedString(Environment* env) {
+    Trim();
     return ToString(env);
   }
 
@@ -312,6 +414,7 @@ class Parser : public AsyncWrap, public StreamListener {
       A_STATUS_MESSAGE,
       A_UPGRADE,
       A_SHOULD_KEEP_ALIVE,
+      A_HEADER_VALUES,
       A_MAX
     };
 
@@ -332,7 +435,17 @@ class Parser : public AsyncWrap, public StreamListener {
       Flush();
     } else {
       // Fast case, pass headers and URL to JS land.
-      argv[A_HEADERS] = CreateHeaders();
+      if (lazy_headers_) {
+        Local<Object> values;
+        if (!CreateHeaderValues().ToLocal(&values)) {
+          got_exception_ = true;
+          return -1;
+        }
+        argv[A_HEADERS] = CreateHeaderNames();
+        argv[A_HEADER_VALUES] = values;
+      } else {
+        argv[A_HEADERS] = CreateHeaders();
+      }
       if (parser_.type == HTTP_REQUEST)
         argv[A_URL] = url_.ToString(env());
     }
@@ -543,6 +656,7 @@ class Parser : public AsyncWrap, public StreamListener {
   static void Initialize(const FunctionCallbackInfo<Value>& args) {
     Environment* env = Environment::GetCurrent(args);
     bool lenient = args[3]->IsTrue();
+    bool lazy_headers = args[5]->IsTrue();
 
     uint64_t max_http_header_size = 0;
     uint64_t headers_timeout = 0;
@@ -579,7 +693,8 @@ class Parser : public AsyncWrap, public StreamListener {
 
     parser->set_provider_type(provider);
     parser->AsyncReset(args[1].As<Object>());
-    parser->Init(type, max_http_header_size, lenient, headers_timeout);
+    parser->Init(type, max_http_header_size, lenient, headers_timeout,
+                 lazy_headers);
   }
 
   template <bool should_pause>
@@ -809,7 +924,7 @@ class Parser : public AsyncWrap, public StreamListener {
     Local<Value> headers_v[kMaxHeaderFieldsCount * 2];
 
     for (size_t i = 0; i < num_values_; ++i) {
-      headers_v[i * 2] = fields_[i].ToString(env());
+      headers_v[i * 2] = fields_[i].ToHeaderName(binding_data_.get());
       headers_v[i * 2 + 1] = values_[i].ToTrimmedString(env());
     }
 
@@ -817,6 +932,47 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  // With lazy headers, the names are passed on their own...
+  Local<Array> CreateHeaderNames() {
+    Local<Value> names_v[kMaxHeaderFieldsCount];
+
+    for (size_t i = 0; i < num_values_; ++i)
+      names_v[i] = fields_[i].ToHeaderName(binding_data_.get());
+
+    return Array::New(env()->isolate(), names_v, num_values_);
+  }
+
+
+  // ...and the values are copied into a single Buffer, from which JS land
+  // only creates strings for the values it reads. The Buffer starts with
+  // num_values_ + 1 uint32_t offsets; value i spans the bytes from
+  // offsets[i] up to offsets[i + 1].
+  MaybeLocal<Object> CreateHeaderValues() {
+    size_t offsets_size = (num_values_ + 1) * sizeof(uint32_t);
+    size_t total = offsets_size;
+    for (size_t i = 0; i < num_values_; ++i) {
+      values_[i].Trim();
+      total += values_[i].size_;
+    }
+
+    Local<Object> buf;
+    if (!Buffer::New(env()->isolate(), total).ToLocal(&buf))
+      return MaybeLocal<Object>();
+
+    char* data = Buffer::Data(buf);
+    uint32_t offset = offsets_size;
+    for (size_t i = 0; i < num_values_; ++i) {
+      memcpy(data + i * sizeof(offset), &offset, sizeof(offset));
+      if (values_[i].size_ > 0)
+        memcpy(data + offset, values_[i].str_, values_[i].size_);
+      offset += values_[i].size_;
+    }
+    memcpy(data + num_values_ * sizeof(offset), &offset, sizeof(offset));
+
+    return buf;
+  }
+
+
   // spill headers and request path to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
@@ -845,7 +1001,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
 
   void Init(llhttp_type_t type, uint64_t max_http_header_size,
-            bool lenient, uint64_t headers_timeout) {
+            bool lenient, uint64_t headers_timeout, bool lazy_headers) {
     llhttp_init(&parser_, type, &settings);
     llhttp_set_lenient(&parser_, lenient);
     header_nread_ = 0;
@@ -858,6 +1014,7 @@ class Parser : public AsyncWrap, public StreamListener {
     max_http_header_size_ = max_http_header_size;
     header_parsing_start_time_ = 0;
     headers_timeout_ = headers_timeout;
+    lazy_headers_ = lazy_headers;
   }
 
 
@@ -900,6 +1057,7 @@ class Parser : public AsyncWrap, public StreamListener {
   size_t num_fields_;
   size_t num_values_;
   bool have_flushed_;
+  bool lazy_headers_ = false;
   bool got_exception_;
   Local<Object> current_buffer_;
   size_t current_buffer_len_;
@@ -948,6 +1106,103 @@ const llhttp_settings_t Parser::settings = {
 };
 
 
+inline bool IsTokenChar(uint8_t c) {
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9')) {
+    return true;
+  }
+  switch (c) {
+    case '!': case '#': case '$': case '%': case '&': case '\'': case '*':
+    case '+': case '-': case '.': case '^': case '_': case '`': case '|':
+    case '~':
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+// serializeHead(firstLine, fields) writes an HTTP/1 message head, i.e.
+// `firstLine` followed by `name: value\r\n` for each pair in the flat
+// `fields` array and a final CRLF, into a single Buffer, validating names and
+// values on the way the same way _http_outgoing.js does.
+// Returns the index of the first pair with an invalid name or value instead,
+// or undefined if the head contains characters outside of US-ASCII, which
+// JS land keeps sending as a string for compatibility.
+void SerializeHead(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsArray());
+  Local<String> first_line = args[0].As<String>();
+  Local<Array> fields = args[1].As<Array>();
+  const uint32_t count = fields->Length();
+  CHECK_EQ(count % 2, 0);
+
+  if (!first_line->ContainsOnlyOneByte())
+    return;
+
+  MaybeStackBuffer<Local<String>, 64> strings(count);
+  // First line, ": " and CRLF per field, final CRLF.
+  size_t size = first_line->Length() + count * 2 + 2;
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> field;
+    if (!fields->Get(env->context(), i).ToLocal(&field))
+      return;
+    if (!field->IsString() || !field.As<String>()->ContainsOnlyOneByte()) {
+      args.GetReturnValue().Set(i / 2);
+      return;
+    }
+    strings[i] = field.As<String>();
+    size += strings[i]->Length();
+  }
+
+  AllocatedBuffer head = AllocatedBuffer::AllocateManaged(env, size);
+  uint8_t* const start = reinterpret_cast<uint8_t*>(head.data());
+  uint8_t* p = start;
+  const int flags = String::NO_NULL_TERMINATION;
+  bool ascii = true;
+
+  p += first_line->WriteOneByte(isolate, p, 0, -1, flags);
+  for (uint8_t* c = start; c < p; c++)
+    ascii = ascii && *c < 0x80;
+
+  for (uint32_t i = 0; i < count; i += 2) {
+    uint8_t* name = p;
+    p += strings[i]->WriteOneByte(isolate, p, 0, -1, flags);
+    bool valid = p != name;
+    for (uint8_t* c = name; valid && c < p; c++)
+      valid = IsTokenChar(*c);
+    *p++ = ':';
+    *p++ = ' ';
+
+    uint8_t* value = p;
+    p += strings[i + 1]->WriteOneByte(isolate, p, 0, -1, flags);
+    for (uint8_t* c = value; valid && c < p; c++) {
+      valid = *c == '\t' || (*c >= 0x20 && *c != 0x7f);
+      ascii = ascii && *c < 0x80;
+    }
+    if (!valid) {
+      args.GetReturnValue().Set(i / 2);
+      return;
+    }
+    *p++ = '\r';
+    *p++ = '\n';
+  }
+  *p++ = '\r';
+  *p++ = '\n';
+  CHECK_EQ(static_cast<size_t>(p - start), size);
+
+  if (!ascii)
+    return;
+
+  Local<Object> buf;
+  if (head.ToBuffer().ToLocal(&buf))
+    args.GetReturnValue().Set(buf);
+}
+
+
 void InitializeHttpParser(Local<Object> target,
                           Local<Value> unused,
                           Local<Context> context,
@@ -1005,6 +1260,8 @@ void InitializeHttpParser(Local<Object> target,
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "HTTPParser"),
               t->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  env->SetMethod(target, "serializeHead", SerializeHead);
 }
 
 }  // anonymous namespace
@@ -50,6 +50,7 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "node_internals.h"
+#include "string_bytes.h"
 #include "util-inl.h"
 #include "v8.h"
 
@@ -432,9 +433,6 @@ void ConverterObject::Decode(const FunctionCallbackInfo<Value>& args) {
   UErrorCode status = U_ZERO_ERROR;
   MaybeStackBuffer<UChar> result;
   MaybeLocal<Object> ret;
-  size_t limit = converter->min_char_size() * input.length();
-  if (limit > 0)
-    result.AllocateSufficientStorage(limit);
 
   UBool flush = (flags & CONVERTER_FLAGS_FLUSH) == CONVERTER_FLAGS_FLUSH;
   auto cleanup = OnScopeLeave([&]() {
@@ -445,6 +443,40 @@ void ConverterObject::Decode(const FunctionCallbackInfo<Value>& args) {
     }
   });
 
+  // A final chunk of UTF-8 with nothing pending from earlier chunks can be
+  // turned into a string directly, unless it is invalid and ICU needs to
+  // replace or reject it.
+  if (flush &&
+      ucnv_getType(converter->conv()) == UCNV_UTF8 &&
+      ucnv_toUCountPending(converter->conv(), &status) == 0 &&
+      U_SUCCESS(status)) {
+    const char* data = input.data();
+    size_t length = input.length();
+    if (!converter->ignore_bom() &&
+        !converter->bom_seen() &&
+        length >= 3 &&
+        memcmp(data, "\xef\xbb\xbf", 3) == 0) {
+      data += 3;
+      length -= 3;
+    }
+    Local<Value> error;
+    Local<Value> str;
+    if (StringBytes::EncodeValidUtf8(env->isolate(), data, length, &error)
+            .ToLocal(&str)) {
+      args.GetReturnValue().Set(str);
+      return;
+    }
+    if (!error.IsEmpty()) {
+      env->isolate()->ThrowException(error);
+      return;
+    }
+  }
+  status = U_ZERO_ERROR;
+
+  size_t limit = converter->min_char_size() * input.length();
+  if (limit > 0)
+    result.AllocateSufficientStorage(limit);
+
   const char* source = input.data();
   size_t source_length = input.length();
 
@@ -0,0 +1,183 @@
+#include "node_mem_pool.h"
+#include "node_mutex.h"
+#include "util-inl.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace node {
+namespace mem {
+
+namespace {
+
+constexpr size_t kClassesPerDoubling = 4;
+// 16 KiB to 1 MiB are six doublings, plus the class for exactly 1 MiB.
+constexpr size_t kNumClasses = 6 * kClassesPerDoubling + 1;
+
+constexpr size_t kThreadCacheLimit = 2 * 1024 * 1024;
+constexpr size_t kCentralCacheLimit = 16 * 1024 * 1024;
+
+std::atomic<uint64_t> cached_bytes {0};
+std::atomic<uint64_t> hits {0};
+std::atomic<uint64_t> misses {0};
+
+inline size_t ClassSize(size_t index) {
+  const size_t base = SizeClassPool::kMinSize << (index / kClassesPerDoubling);
+  return base + (index % kClassesPerDoubling) * (base / kClassesPerDoubling);
+}
+
+// Returns the smallest class that `size` fits into.
+inline size_t ClassIndex(size_t size) {
+  size_t doubling = 0;
+  while ((SizeClassPool::kMinSize << (doubling + 1)) < size)
+    doubling++;
+  const size_t base = SizeClassPool::kMinSize << doubling;
+  const size_t step = base / kClassesPerDoubling;
+  return doubling * kClassesPerDoubling + (size - base + step - 1) / step;
+}
+
+// Free blocks are linked through their first bytes, so keeping them around
+// does not need any memory of its own.
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+class FreeLists {
+ public:
+  inline void* Take(size_t index) {
+    FreeBlock* block = heads_[index];
+    if (block == nullptr) return nullptr;
+    heads_[index] = block->next;
+    bytes_ -= ClassSize(index);
+    return block;
+  }
+
+  inline bool Put(size_t index, void* data, size_t limit) {
+    if (bytes_ + ClassSize(index) > limit) return false;
+    FreeBlock* block = static_cast<FreeBlock*>(data);
+    block->next = heads_[index];
+    heads_[index] = block;
+    bytes_ += ClassSize(index);
+    return true;
+  }
+
+ private:
+  FreeBlock* heads_[kNumClasses] = {};
+  size_t bytes_ = 0;
+};
+
+struct CentralCache {
+  Mutex mutex;
+  FreeLists lists;
+};
+
+// Never destroyed, so that threads that exit late can still return their
+// blocks.
+CentralCache* GetCentralCache() {
+  static CentralCache* cache = new CentralCache();
+  return cache;
+}
+
+void* TakeFromCentral(size_t index) {
+  CentralCache* central = GetCentralCache();
+  Mutex::ScopedLock lock(central->mutex);
+  return central->lists.Take(index);
+}
+
+void PutToCentral(size_t index, void* data) {
+  CentralCache* central = GetCentralCache();
+  {
+    Mutex::ScopedLock lock(central->mutex);
+    if (central->lists.Put(index, data, kCentralCacheLimit)) return;
+  }
+  cached_bytes.fetch_sub(ClassSize(index), std::memory_order_relaxed);
+  free(data);
+}
+
+thread_local bool thread_cache_destroyed = false;
+
+class ThreadCache {
+ public:
+  ~ThreadCache() {
+    for (size_t index = 0; index < kNumClasses; index++) {
+      while (void* data = lists_.Take(index))
+        PutToCentral(index, data);
+    }
+    thread_cache_destroyed = true;
+  }
+
+  inline void* Take(size_t index) {
+    allocates_ = true;
+    return lists_.Take(index);
+  }
+
+  // Threads that only ever free memory, such as V8's background sweeper,
+  // pass it on to the central cache right away.
+  inline bool Put(size_t index, void* data) {
+    return allocates_ && lists_.Put(index, data, kThreadCacheLimit);
+  }
+
+ private:
+  FreeLists lists_;
+  bool allocates_ = false;
+};
+
+// Returns nullptr while the thread is exiting, after its cache is gone.
+ThreadCache* GetThreadCache() {
+  if (thread_cache_destroyed) return nullptr;
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+}  // anonymous namespace
+
+void* SizeClassPool::Allocate(size_t size, bool zero_fill) {
+  const size_t index = ClassIndex(size);
+  ThreadCache* cache = GetThreadCache();
+  void* data = cache != nullptr ? cache->Take(index) : nullptr;
+  if (data == nullptr)
+    data = TakeFromCentral(index);
+  if (data != nullptr) {
+    cached_bytes.fetch_sub(ClassSize(index), std::memory_order_relaxed);
+    hits.fetch_add(1, std::memory_order_relaxed);
+    if (zero_fill)
+      memset(data, 0, size);
+    return data;
+  }
+
+  misses.fetch_add(1, std::memory_order_relaxed);
+  if (zero_fill)
+    return UncheckedCalloc(ClassSize(index));
+  return UncheckedMalloc(ClassSize(index));
+}
+
+void SizeClassPool::Free(void* data, size_t size) {
+  if (data == nullptr) return;
+  const size_t index = ClassIndex(size);
+  cached_bytes.fetch_add(ClassSize(index), std::memory_order_relaxed);
+  ThreadCache* cache = GetThreadCache();
+  if (cache == nullptr || !cache->Put(index, data))
+    PutToCentral(index, data);
+}
+
+void* SizeClassPool::Reallocate(void* data, size_t old_size, size_t size) {
+  if (ClassIndex(old_size) == ClassIndex(size))
+    return data;
+  void* ret = Allocate(size, false);
+  if (ret == nullptr) return nullptr;
+  memcpy(ret, data, std::min(old_size, size));
+  Free(data, old_size);
+  return ret;
+}
+
+SizeClassPool::Stats SizeClassPool::GetStats() {
+  return Stats {
+    cached_bytes.load(std::memory_order_relaxed),
+    hits.load(std::memory_order_relaxed),
+    misses.load(std::memory_order_relaxed)
+  };
+}
+
+}  // namespace mem
+}  // namespace node
@@ -0,0 +1,55 @@
+#ifndef SRC_NODE_MEM_POOL_H_
+#define SRC_NODE_MEM_POOL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <cstdint>
+
+namespace node {
+namespace mem {
+
+// A process-wide cache for ArrayBuffer backing stores of 16 KiB to 1 MiB,
+// which stream reads, Buffer.allocUnsafe() beyond the JS pool and
+// AllocatedBuffers tend to allocate and free at a high rate.
+//
+// Requests are rounded up to one of four size classes per power of two, and
+// freed blocks are kept on a free list for their class: first in a small
+// cache owned by the freeing thread, then in a central cache shared by all
+// threads. Both caches are bounded; blocks that do not fit are returned to
+// the system allocator.
+//
+// The class of a block is derived from the size passed to Free(), so that
+// has to be the size passed to Allocate().
+class SizeClassPool {
+ public:
+  static constexpr size_t kMinSize = 16 * 1024;
+  static constexpr size_t kMaxSize = 1024 * 1024;
+
+  static inline bool IsPooled(size_t size) {
+    return size >= kMinSize && size <= kMaxSize;
+  }
+
+  // Returns nullptr if the system is out of memory.
+  static void* Allocate(size_t size, bool zero_fill);
+  static void Free(void* data, size_t size);
+  // Returns `data` if `size` falls into the same class as `old_size`.
+  // Both sizes need to be pooled.
+  static void* Reallocate(void* data, size_t old_size, size_t size);
+
+  struct Stats {
+    // Bytes held in the caches, ready to be reused.
+    uint64_t cached;
+    // Allocations served from the caches and from the system allocator.
+    uint64_t hits;
+    uint64_t misses;
+  };
+  static Stats GetStats();
+};
+
+}  // namespace mem
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_MEM_POOL_H_
@@ -518,7 +518,7 @@ void Message::MemoryInfo(MemoryTracker* tracker) const {
 }
 
 MessagePortData::MessagePortData(MessagePort* owner)
-  : mutex_(/* ordered */ true), owner_(owner) { }
+  : owner_(owner) { }
 
 MessagePortData::~MessagePortData() {
   CHECK_NULL(owner_);
@@ -554,7 +554,7 @@ void MessagePortData::Disentangle() {
   // has its own sibling_mutex_ now.
   std::shared_ptr<Mutex> sibling_mutex = sibling_mutex_;
   Mutex::ScopedLock sibling_lock(*sibling_mutex);
-  sibling_mutex_ = std::make_shared<Mutex>();
+  sibling_mutex_ = std::make_shared<Mutex>(/* ordered */ true);
 
   MessagePortData* sibling = sibling_;
   if (sibling_ != nullptr) {
@@ -723,7 +723,7 @@ void MessagePort::OnMessage() {
 
   size_t processing_limit;
   {
-    Mutex::ScopedLock(data_->mutex_);
+    Mutex::ScopedLock lock(data_->mutex_);
     processing_limit = std::max(data_->incoming_messages_.size(),
                                 static_cast<size_t>(1000));
   }
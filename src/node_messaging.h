@@ -143,7 +143,7 @@ class MessagePortData : public TransferData {
  private:
   // This mutex protects all fields below it, with the exception of
   // sibling_.
-  mutable Mutex mutex_;
+  mutable Mutex mutex_ {/* ordered */ true};
   std::list<Message> incoming_messages_;
   MessagePort* owner_ = nullptr;
   // This mutex protects the sibling_ field and is shared between two entangled
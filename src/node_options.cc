@@ -65,6 +65,11 @@ void PerProcessOptions::CheckOptions(std::vector<std::string>* errors) {
                       "used, not both");
   }
 #endif
+  if (record_replay_checkpoint_progress < -1 ||
+      record_replay_checkpoint_interval < -1) {
+    errors->push_back("record/replay checkpoint options must not be "
+                      "negative");
+  }
   if (use_largepages != "off" &&
       use_largepages != "on" &&
       use_largepages != "silent") {
@@ -653,6 +658,16 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "set V8's thread pool size",
             &PerProcessOptions::v8_thread_pool_size,
             kAllowedInEnvironment);
+  AddOption("--record-replay-checkpoint-progress",
+            "when recording, only create a checkpoint once the progress "
+            "counter has advanced this much since the last one",
+            &PerProcessOptions::record_replay_checkpoint_progress,
+            kAllowedInEnvironment);
+  AddOption("--record-replay-checkpoint-interval",
+            "when recording, only create a checkpoint once this many "
+            "milliseconds have passed since the last one",
+            &PerProcessOptions::record_replay_checkpoint_interval,
+            kAllowedInEnvironment);
   AddOption("--zero-fill-buffers",
             "automatically zero-fill all newly allocated Buffer and "
             "SlowBuffer instances",
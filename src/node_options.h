@@ -217,6 +217,10 @@ class PerProcessOptions : public Options {
   std::string trace_event_categories;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
   int64_t v8_thread_pool_size = 4;
+  // -1 leaves the checkpoint policy to the RECORD_REPLAY_CHECKPOINT_*
+  // environment variables.
+  int64_t record_replay_checkpoint_progress = -1;
+  int64_t record_replay_checkpoint_interval = -1;
   bool zero_fill_all_buffers = false;
   bool debug_arraybuffer_allocations = false;
   std::string disable_proto;
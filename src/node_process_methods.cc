@@ -6,6 +6,7 @@
 #include "node_errors.h"
 #include "node_external_reference.h"
 #include "node_internals.h"
+#include "node_mem_pool.h"
 #include "node_process.h"
 #include "util-inl.h"
 #include "uv.h"
@@ -42,6 +43,7 @@ extern void FunctionCallbackRecordReplaySetClearPauseDataCallback(const Function
 extern void FunctionCallbackRecordReplayIgnoreScript(const FunctionCallbackInfo<Value>& args);
 extern void FunctionCallbackRecordReplayAssert(const FunctionCallbackInfo<Value>& args);
 extern void FunctionCallbackRecordReplayGetCurrentError(const FunctionCallbackInfo<Value>& args);
+extern void FunctionCallbackRecordReplayGetCurrentConsoleArguments(const FunctionCallbackInfo<Value>& args);
 
 }
 
@@ -194,7 +196,7 @@ static void MemoryUsage(const FunctionCallbackInfo<Value>& args) {
       env->isolate_data()->node_allocator();
 
   // Get the double array pointer from the Float64Array argument.
-  Local<ArrayBuffer> ab = get_fields_array_buffer(args, 0, 5);
+  Local<ArrayBuffer> ab = get_fields_array_buffer(args, 0, 8);
   double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
 
   fields[0] = rss;
@@ -204,8 +206,18 @@ static void MemoryUsage(const FunctionCallbackInfo<Value>& args) {
   fields[4] = array_buffer_allocator == nullptr ?
       0 : array_buffer_allocator->total_mem_usage();
 
-  // Ensure memory usage measurements are consistent when replaying.
-  v8::recordreplay::RecordReplayBytes("MemoryUsage", fields, 5 * sizeof(double));
+  // The pool is shared by all threads in the process.
+  mem::SizeClassPool::Stats pool_stats = mem::SizeClassPool::GetStats();
+  fields[5] = pool_stats.cached;
+  fields[6] = pool_stats.hits;
+  fields[7] = pool_stats.misses;
+
+  // Ensure memory usage measurements are consistent when replaying, until the
+  // replay diverges from the recording.
+  if (!v8::recordreplay::HasDivergedFromRecording()) {
+    v8::recordreplay::RecordReplayBytes("MemoryUsage", fields,
+                                        8 * sizeof(double));
+  }
 }
 
 void RawDebug(const FunctionCallbackInfo<Value>& args) {
@@ -304,6 +316,56 @@ static void ResourceUsage(const FunctionCallbackInfo<Value>& args) {
   fields[15] = rusage.ru_nivcsw;
 }
 
+static void ThreadpoolUsage(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  uv_threadpool_stats_t stats;
+  int err = uv_threadpool_stats(&stats);
+  if (err)
+    return env->ThrowUVException(err, "uv_threadpool_stats");
+
+  Local<ArrayBuffer> ab = get_fields_array_buffer(args, 0, 19);
+  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
+
+  fields[0] = stats.threads;
+  fields[1] = stats.idle_threads;
+  fields[2] = stats.min_threads;
+  fields[3] = stats.max_threads;
+
+  const uv_threadpool_queue_stats_t* queues[] = {
+    &stats.cpu, &stats.fast_io, &stats.slow_io
+  };
+  for (size_t i = 0; i < arraysize(queues); i++) {
+    double* queue_fields = fields + 4 + i * 5;
+    queue_fields[0] = queues[i]->queued;
+    queue_fields[1] = queues[i]->running;
+    queue_fields[2] = queues[i]->completed;
+    queue_fields[3] = queues[i]->wait_time / 1000;
+    queue_fields[4] = queues[i]->run_time / 1000;
+  }
+
+  // The threadpool is shared with other threads, so keep the values
+  // consistent when replaying, until the replay diverges from the recording.
+  if (!v8::recordreplay::HasDivergedFromRecording()) {
+    v8::recordreplay::RecordReplayBytes("ThreadpoolUsage", fields,
+                                        19 * sizeof(double));
+  }
+}
+
+static void RecordReplayCheckpointStats(
+    const FunctionCallbackInfo<Value>& args) {
+  recordreplay::CheckpointStats stats = recordreplay::GetCheckpointStats();
+
+  Local<ArrayBuffer> ab = get_fields_array_buffer(args, 0, 5);
+  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
+
+  fields[0] = stats.min_progress;
+  fields[1] = stats.min_interval_ms;
+  fields[2] = stats.candidates;
+  fields[3] = stats.created;
+  fields[4] = stats.progress;
+}
+
 #ifdef __POSIX__
 static void DebugProcess(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -579,23 +641,63 @@ class RecordReplaySessionDelegate : public inspector::InspectorSessionDelegate {
   }
 };
 
-static void RecordReplaySendCDPMessage(const FunctionCallbackInfo<Value>& args) {
-  CHECK(args.Length() == 1 && args[0]->IsString() &&
-        "must be called with a single string");
-  Utf8Value message(args.GetIsolate(), args[0]);
-
+static inspector::InspectorSession* GetRecordReplayInspectorSession(
+    Environment* env) {
   if (!gRecordReplayInspectorSession) {
-    Environment* env = Environment::GetCurrent(args);
     inspector::Agent* agent = env->inspector_agent();
 
     auto delegate = std::make_unique<RecordReplaySessionDelegate>();
     gRecordReplayInspectorSession = agent->Connect(std::move(delegate),
                                                    /* prevent_shutdown */ false);
   }
+  return gRecordReplayInspectorSession.get();
+}
+
+static void RecordReplaySendCDPMessage(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.Length() == 1 && args[0]->IsString() &&
+        "must be called with a single string");
+  Utf8Value message(args.GetIsolate(), args[0]);
+  Environment* env = Environment::GetCurrent(args);
 
   std::string nmessage(message.ToString());
   v8_inspector::StringView messageView((const uint8_t*)nmessage.c_str(), nmessage.length());
-  gRecordReplayInspectorSession->Dispatch(messageView);
+  GetRecordReplayInspectorSession(env)->Dispatch(messageView);
+}
+
+// Create a Runtime.RemoteObject for a value in the same inspector session
+// that CDP messages are sent to, without exposing the value to user code.
+static void RecordReplayValueToRemoteObject(
+    const FunctionCallbackInfo<Value>& args) {
+  CHECK_EQ(args.Length(), 1);
+  Environment* env = Environment::GetCurrent(args);
+
+  std::string json =
+      GetRecordReplayInspectorSession(env)->WrapObject(env->context(), args[0]);
+  if (json.empty())
+    return;
+
+  Local<v8::String> source;
+  Local<Value> remote_object;
+  if (v8::String::NewFromUtf8(env->isolate(), json.c_str(),
+                              NewStringType::kNormal, json.length())
+          .ToLocal(&source) &&
+      v8::JSON::Parse(env->context(), source).ToLocal(&remote_object)) {
+    args.GetReturnValue().Set(remote_object);
+  }
+}
+
+// Get the value that a RemoteObject's objectId refers to, or undefined.
+static void RecordReplayRemoteObjectIdToValue(
+    const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.Length() == 1 && args[0]->IsString());
+  Environment* env = Environment::GetCurrent(args);
+  Utf8Value object_id(env->isolate(), args[0]);
+
+  Local<Value> value;
+  if (GetRecordReplayInspectorSession(env)->UnwrapObject(object_id.ToString(),
+                                                         &value)) {
+    args.GetReturnValue().Set(value);
+  }
 }
 
 static void InitializeProcessMethods(Local<Object> target,
@@ -618,6 +720,9 @@ static void InitializeProcessMethods(Local<Object> target,
   env->SetMethod(target, "memoryUsage", MemoryUsage);
   env->SetMethod(target, "cpuUsage", CPUUsage);
   env->SetMethod(target, "resourceUsage", ResourceUsage);
+  env->SetMethod(target, "threadpoolUsage", ThreadpoolUsage);
+  env->SetMethod(target, "recordReplayCheckpointStats",
+                 RecordReplayCheckpointStats);
 
   env->SetMethod(target, "_getActiveRequests", GetActiveRequests);
   env->SetMethod(target, "_getActiveHandles", GetActiveHandles);
@@ -645,10 +750,16 @@ static void InitializeProcessMethods(Local<Object> target,
                  v8::FunctionCallbackRecordReplayAssert);
   env->SetMethod(target, "recordReplayGetCurrentError",
                  v8::FunctionCallbackRecordReplayGetCurrentError);
+  env->SetMethod(target, "recordReplayGetCurrentConsoleArguments",
+                 v8::FunctionCallbackRecordReplayGetCurrentConsoleArguments);
   env->SetMethod(target, "recordReplaySetCDPMessageCallback",
                  RecordReplaySetCDPMessageCallback);
   env->SetMethod(target, "recordReplaySendCDPMessage",
                  RecordReplaySendCDPMessage);
+  env->SetMethod(target, "recordReplayValueToRemoteObject",
+                 RecordReplayValueToRemoteObject);
+  env->SetMethod(target, "recordReplayRemoteObjectIdToValue",
+                 RecordReplayRemoteObjectIdToValue);
 }
 
 void RegisterProcessMethodsExternalReferences(
@@ -664,6 +775,8 @@ void RegisterProcessMethodsExternalReferences(
   registry->Register(MemoryUsage);
   registry->Register(CPUUsage);
   registry->Register(ResourceUsage);
+  registry->Register(ThreadpoolUsage);
+  registry->Register(RecordReplayCheckpointStats);
 
   registry->Register(GetActiveRequests);
   registry->Register(GetActiveHandles);
@@ -684,8 +797,11 @@ void RegisterProcessMethodsExternalReferences(
   registry->Register(v8::FunctionCallbackRecordReplayIgnoreScript);
   registry->Register(v8::FunctionCallbackRecordReplayAssert);
   registry->Register(v8::FunctionCallbackRecordReplayGetCurrentError);
+  registry->Register(v8::FunctionCallbackRecordReplayGetCurrentConsoleArguments);
   registry->Register(RecordReplaySetCDPMessageCallback);
   registry->Register(RecordReplaySendCDPMessage);
+  registry->Register(RecordReplayValueToRemoteObject);
+  registry->Register(RecordReplayRemoteObjectIdToValue);
 }
 
 }  // namespace node
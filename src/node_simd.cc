@@ -0,0 +1,1190 @@
+#include "node_simd.h"
+
+#include <cstring>
+
+#if NODE_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
+
+// Kernels are compiled for their instruction set with a target attribute
+// instead of compiler flags for the whole file, so that the rest of the
+// binary keeps running on CPUs without the extension. MSVC does not need
+// this in order to use intrinsics.
+#if defined(__GNUC__) || defined(__clang__)
+#define NODE_TARGET(arch) __attribute__((target(arch)))
+#else
+#define NODE_TARGET(arch)
+#endif
+
+namespace node {
+namespace simd {
+
+namespace {
+
+#if NODE_SIMD_X86
+Level DetectLevel() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+  __cpuid(info, 1);
+  const bool ssse3 = (info[2] & (1 << 9)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool avx2 = false;
+  // AVX2 needs the OS to preserve the YMM registers as well.
+  if (max_leaf >= 7 && osxsave && (_xgetbv(0) & 6) == 6) {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+  }
+#else
+  __builtin_cpu_init();
+  const bool ssse3 = __builtin_cpu_supports("ssse3");
+  const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+  if (avx2) return Level::kAVX2;
+  if (ssse3) return Level::kSSSE3;
+  return Level::kNone;
+}
+
+// Signed comparisons, so bytes >= 0x80 are never in range.
+NODE_TARGET("ssse3")
+inline __m128i InRange(__m128i v, char lo, char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), v));
+}
+
+NODE_TARGET("avx2")
+inline __m256i InRange(__m256i v, char lo, char hi) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v));
+}
+
+// Base64 encoding: spread 3 bytes over 4 bytes of 6 bits each, then map
+// each 6-bit value to its character by adding an offset for its range.
+NODE_TARGET("ssse3")
+inline __m128i Base64EncodeBlock(__m128i in, __m128i offsets) {
+  in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+                                         4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const __m128i indices = _mm_or_si128(t1, t3);
+
+  // 0 for 0-25 (becomes 13 below) and 26-51, 1-12 for 52-63.
+  __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+  return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+}
+
+NODE_TARGET("avx2")
+inline __m256i Base64EncodeBlock(__m256i in, __m256i offsets) {
+  in = _mm256_shuffle_epi8(in, _mm256_set_epi8(
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+  const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+  const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  const __m256i indices = _mm256_or_si256(t1, t3);
+
+  __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+  range = _mm256_or_si256(range,
+                          _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range));
+}
+
+NODE_TARGET("ssse3")
+size_t Base64EncodeSSSE3(const char* src, size_t slen, char* dst,
+                         const char* table, size_t i) {
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      table[62] - 62, table[63] - 63, 'A', 0, 0);
+  // Each block reads 16 bytes but only consumes 12.
+  for (; i + 16 <= slen; i += 12) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i / 3 * 4),
+                     Base64EncodeBlock(in, offsets));
+  }
+  return i;
+}
+
+NODE_TARGET("avx2")
+size_t Base64EncodeAVX2(const char* src, size_t slen, char* dst,
+                        const char* table) {
+  const __m256i offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      table[62] - 62, table[63] - 63, 'A', 0, 0));
+  size_t i = 0;
+  for (; i + 28 <= slen; i += 24) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+    const __m256i in =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i / 3 * 4),
+                        Base64EncodeBlock(in, offsets));
+  }
+  return i;
+}
+
+// Base64 decoding: map characters of both alphabets to their 6-bit values,
+// then pack 4 of those into 3 bytes. A block that has anything else in it
+// is left to the scalar decoder.
+NODE_TARGET("ssse3")
+inline bool Base64DecodeBlock(__m128i in, __m128i* out) {
+  const __m128i upper = InRange(in, 'A', 'Z');
+  const __m128i lower = InRange(in, 'a', 'z');
+  const __m128i digit = InRange(in, '0', '9');
+  const __m128i plus = _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('+')),
+                                    _mm_cmpeq_epi8(in, _mm_set1_epi8('-')));
+  const __m128i slash = _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')),
+                                     _mm_cmpeq_epi8(in, _mm_set1_epi8('_')));
+  const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                                     _mm_or_si128(digit,
+                                                  _mm_or_si128(plus, slash)));
+  if (_mm_movemask_epi8(valid) != 0xffff)
+    return false;
+
+  __m128i values = _mm_and_si128(plus, _mm_set1_epi8(62));
+  values = _mm_or_si128(values, _mm_and_si128(slash, _mm_set1_epi8(63)));
+  values = _mm_or_si128(values, _mm_and_si128(
+      upper, _mm_sub_epi8(in, _mm_set1_epi8('A'))));
+  values = _mm_or_si128(values, _mm_and_si128(
+      lower, _mm_sub_epi8(in, _mm_set1_epi8('a' - 26))));
+  values = _mm_or_si128(values, _mm_and_si128(
+      digit, _mm_sub_epi8(in, _mm_set1_epi8('0' - 52))));
+
+  // 00aaaaaa 00bbbbbb 00cccccc 00dddddd -> aaaaaabb bbbbcccc ccdddddd
+  const __m128i pairs =
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  *out = _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                               14, 13, 12, -1, -1, -1, -1));
+  return true;
+}
+
+NODE_TARGET("avx2")
+inline bool Base64DecodeBlock(__m256i in, __m256i* out) {
+  const __m256i upper = InRange(in, 'A', 'Z');
+  const __m256i lower = InRange(in, 'a', 'z');
+  const __m256i digit = InRange(in, '0', '9');
+  const __m256i plus =
+      _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('+')),
+                      _mm256_cmpeq_epi8(in, _mm256_set1_epi8('-')));
+  const __m256i slash =
+      _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('/')),
+                      _mm256_cmpeq_epi8(in, _mm256_set1_epi8('_')));
+  const __m256i valid =
+      _mm256_or_si256(_mm256_or_si256(upper, lower),
+                      _mm256_or_si256(digit, _mm256_or_si256(plus, slash)));
+  if (_mm256_movemask_epi8(valid) != -1)
+    return false;
+
+  __m256i values = _mm256_and_si256(plus, _mm256_set1_epi8(62));
+  values = _mm256_or_si256(values,
+                           _mm256_and_si256(slash, _mm256_set1_epi8(63)));
+  values = _mm256_or_si256(values, _mm256_and_si256(
+      upper, _mm256_sub_epi8(in, _mm256_set1_epi8('A'))));
+  values = _mm256_or_si256(values, _mm256_and_si256(
+      lower, _mm256_sub_epi8(in, _mm256_set1_epi8('a' - 26))));
+  values = _mm256_or_si256(values, _mm256_and_si256(
+      digit, _mm256_sub_epi8(in, _mm256_set1_epi8('0' - 52))));
+
+  const __m256i pairs =
+      _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+  const __m256i words =
+      _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+  const __m256i packed = _mm256_shuffle_epi8(words, _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  // Move the 12 bytes of each lane next to each other.
+  *out = _mm256_permutevar8x32_epi32(packed,
+                                     _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+  return true;
+}
+
+NODE_TARGET("ssse3")
+size_t Base64DecodeSSSE3(char* dst, size_t dstlen, size_t max_out,
+                         const char* src, size_t srclen, size_t i) {
+  // Each block writes 16 bytes but only produces 12.
+  for (; i + 16 <= srclen; i += 16) {
+    const size_t k = i / 4 * 3;
+    if (k + 12 > max_out || k + 16 > dstlen)
+      break;
+    __m128i out;
+    if (!Base64DecodeBlock(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)),
+            &out)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), out);
+  }
+  return i;
+}
+
+NODE_TARGET("avx2")
+size_t Base64DecodeAVX2(char* dst, size_t dstlen, size_t max_out,
+                        const char* src, size_t srclen) {
+  size_t i = 0;
+  for (; i + 32 <= srclen; i += 32) {
+    const size_t k = i / 4 * 3;
+    if (k + 24 > max_out || k + 32 > dstlen)
+      break;
+    __m256i out;
+    if (!Base64DecodeBlock(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)),
+            &out)) {
+      break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), out);
+  }
+  return i;
+}
+
+NODE_TARGET("ssse3")
+size_t HexEncodeSSSE3(const char* src, size_t slen, char* dst, size_t i) {
+  const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                       '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  for (; i + 16 <= slen; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi = _mm_shuffle_epi8(
+        digits, _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+    const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, nibble));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2),
+                     _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2 + 16),
+                     _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+NODE_TARGET("avx2")
+size_t HexEncodeAVX2(const char* src, size_t slen, char* dst) {
+  const __m256i digits = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'));
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= slen; i += 32) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i hi = _mm256_shuffle_epi8(
+        digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+    const __m256i lo =
+        _mm256_shuffle_epi8(digits, _mm256_and_si256(in, nibble));
+    // The unpacks work within 128-bit lanes, so put the lanes back in order.
+    const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2),
+                        _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2 + 32),
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return i;
+}
+
+// Turns 16 hex digits into 8 bytes, held in the low byte of each 16-bit lane.
+NODE_TARGET("ssse3")
+inline bool HexDecodeBlock(__m128i in, __m128i* out) {
+  const __m128i digit = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+  const __m128i letter = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)),
+                                      _mm_set1_epi8('a' - 10));
+  const __m128i is_digit = InRange(in, '0', '9');
+  const __m128i is_letter = InRange(letter, 10, 15);
+  if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff)
+    return false;
+  const __m128i values = _mm_or_si128(_mm_and_si128(is_digit, digit),
+                                      _mm_and_si128(is_letter, letter));
+  *out = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0110));
+  return true;
+}
+
+NODE_TARGET("avx2")
+inline bool HexDecodeBlock(__m256i in, __m256i* out) {
+  const __m256i digit = _mm256_sub_epi8(in, _mm256_set1_epi8('0'));
+  const __m256i letter =
+      _mm256_sub_epi8(_mm256_or_si256(in, _mm256_set1_epi8(0x20)),
+                      _mm256_set1_epi8('a' - 10));
+  const __m256i is_digit = InRange(in, '0', '9');
+  const __m256i is_letter = InRange(letter, 10, 15);
+  if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1)
+    return false;
+  const __m256i values = _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                                         _mm256_and_si256(is_letter, letter));
+  *out = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+  return true;
+}
+
+NODE_TARGET("ssse3")
+size_t HexDecodeSSSE3(char* dst, size_t dstlen, const char* src,
+                      size_t srclen, size_t k) {
+  for (; k + 16 <= dstlen && k * 2 + 32 <= srclen; k += 16) {
+    __m128i first;
+    __m128i second;
+    if (!HexDecodeBlock(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k * 2)),
+            &first) ||
+        !HexDecodeBlock(
+            _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + k * 2 + 16)),
+            &second)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                     _mm_packus_epi16(first, second));
+  }
+  return k;
+}
+
+NODE_TARGET("avx2")
+size_t HexDecodeAVX2(char* dst, size_t dstlen, const char* src,
+                     size_t srclen) {
+  size_t k = 0;
+  for (; k + 32 <= dstlen && k * 2 + 64 <= srclen; k += 32) {
+    __m256i first;
+    __m256i second;
+    if (!HexDecodeBlock(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + k * 2)),
+            &first) ||
+        !HexDecodeBlock(
+            _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(src + k * 2 + 32)),
+            &second)) {
+      break;
+    }
+    // The pack works within 128-bit lanes, so put the lanes back in order.
+    const __m256i packed = _mm256_packus_epi16(first, second);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k),
+                        _mm256_permute4x64_epi64(packed, 0xd8));
+  }
+  return k;
+}
+
+// UTF-8 validation as described in "Validating UTF-8 In Less Than One
+// Instruction Per Byte" (Keiser and Lemire, 2021). Three table lookups on
+// the nibbles of each byte and the byte before it flag every error that
+// can be seen in two bytes. Three and four byte sequences additionally
+// need their lead two or three bytes back.
+constexpr uint8_t kTooShort = 1 << 0;
+constexpr uint8_t kTooLong = 1 << 1;
+constexpr uint8_t kOverlong3 = 1 << 2;
+constexpr uint8_t kTooLarge = 1 << 3;
+constexpr uint8_t kSurrogate = 1 << 4;
+constexpr uint8_t kOverlong2 = 1 << 5;
+constexpr uint8_t kTooLarge1000 = 1 << 6;
+constexpr uint8_t kOverlong4 = 1 << 6;
+constexpr uint8_t kTwoConts = 1 << 7;
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+#define UTF8_BYTE_1_HIGH                                                      \
+  kTooLong, kTooLong, kTooLong, kTooLong,                                     \
+  kTooLong, kTooLong, kTooLong, kTooLong,                                     \
+  kTwoConts, kTwoConts, kTwoConts, kTwoConts,                                 \
+  kTooShort | kOverlong2,                                                     \
+  kTooShort,                                                                  \
+  kTooShort | kOverlong3 | kSurrogate,                                        \
+  kTooShort | kTooLarge | kTooLarge1000 | kOverlong4
+
+#define UTF8_BYTE_1_LOW                                                       \
+  kCarry | kOverlong3 | kOverlong2 | kOverlong4,                              \
+  kCarry | kOverlong2,                                                        \
+  kCarry,                                                                     \
+  kCarry,                                                                     \
+  kCarry | kTooLarge,                                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000 | kSurrogate,                            \
+  kCarry | kTooLarge | kTooLarge1000,                                         \
+  kCarry | kTooLarge | kTooLarge1000
+
+#define UTF8_BYTE_2_HIGH                                                      \
+  kTooShort, kTooShort, kTooShort, kTooShort,                                 \
+  kTooShort, kTooShort, kTooShort, kTooShort,                                 \
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,\
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,                 \
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,                 \
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,                 \
+  kTooShort, kTooShort, kTooShort, kTooShort
+
+// Flags lead bytes in the last three positions that need more bytes than
+// the block has left.
+#define UTF8_INCOMPLETE                                                       \
+  255, 255, 255, 255, 255, 255, 255, 255,                                     \
+  255, 255, 255, 255, 255, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1
+
+struct Utf8StateSSSE3 {
+  __m128i error;
+  __m128i prev_input;
+  __m128i prev_incomplete;
+  __m128i max;
+};
+
+NODE_TARGET("ssse3")
+inline __m128i Lookup16(const uint8_t (&table)[16], __m128i indices) {
+  return _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)), indices);
+}
+
+NODE_TARGET("ssse3")
+inline void ValidateUtf8Block(__m128i in, Utf8StateSSSE3* state) {
+  static const uint8_t byte_1_high[16] = { UTF8_BYTE_1_HIGH };
+  static const uint8_t byte_1_low[16] = { UTF8_BYTE_1_LOW };
+  static const uint8_t byte_2_high[16] = { UTF8_BYTE_2_HIGH };
+  static const uint8_t incomplete[16] = { UTF8_INCOMPLETE };
+
+  state->max = _mm_max_epu8(state->max, in);
+  if (_mm_movemask_epi8(in) == 0) {
+    state->error = _mm_or_si128(state->error, state->prev_incomplete);
+    state->prev_incomplete = _mm_setzero_si128();
+    state->prev_input = in;
+    return;
+  }
+
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  const __m128i prev1 = _mm_alignr_epi8(in, state->prev_input, 15);
+  const __m128i special = _mm_and_si128(
+      _mm_and_si128(
+          Lookup16(byte_1_high,
+                   _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+          Lookup16(byte_1_low, _mm_and_si128(prev1, nibble))),
+      Lookup16(byte_2_high, _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+
+  const __m128i prev2 = _mm_alignr_epi8(in, state->prev_input, 14);
+  const __m128i prev3 = _mm_alignr_epi8(in, state->prev_input, 13);
+  const __m128i must_be_continuation = _mm_and_si128(
+      _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80)),
+                   _mm_subs_epu8(prev3, _mm_set1_epi8(0xf0 - 0x80))),
+      _mm_set1_epi8(static_cast<char>(0x80)));
+
+  state->error = _mm_or_si128(state->error,
+                              _mm_xor_si128(must_be_continuation, special));
+  state->prev_incomplete = _mm_subs_epu8(
+      in, _mm_loadu_si128(reinterpret_cast<const __m128i*>(incomplete)));
+  state->prev_input = in;
+}
+
+struct Utf8StateAVX2 {
+  __m256i error;
+  __m256i prev_input;
+  __m256i prev_incomplete;
+  __m256i max;
+};
+
+NODE_TARGET("avx2")
+inline __m256i Lookup16(const uint8_t (&table)[16], __m256i indices) {
+  return _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(table))),
+      indices);
+}
+
+// The bytes N positions back, which may come from the previous block.
+template <int N>
+NODE_TARGET("avx2")
+inline __m256i Previous(__m256i in, __m256i prev_input) {
+  return _mm256_alignr_epi8(
+      in, _mm256_permute2x128_si256(prev_input, in, 0x21), 16 - N);
+}
+
+NODE_TARGET("avx2")
+inline void ValidateUtf8Block(__m256i in, Utf8StateAVX2* state) {
+  static const uint8_t byte_1_high[16] = { UTF8_BYTE_1_HIGH };
+  static const uint8_t byte_1_low[16] = { UTF8_BYTE_1_LOW };
+  static const uint8_t byte_2_high[16] = { UTF8_BYTE_2_HIGH };
+  static const uint8_t incomplete[32] = {
+    255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255,
+    UTF8_INCOMPLETE
+  };
+
+  state->max = _mm256_max_epu8(state->max, in);
+  if (_mm256_movemask_epi8(in) == 0) {
+    state->error = _mm256_or_si256(state->error, state->prev_incomplete);
+    state->prev_incomplete = _mm256_setzero_si256();
+    state->prev_input = in;
+    return;
+  }
+
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  const __m256i prev1 = Previous<1>(in, state->prev_input);
+  const __m256i special = _mm256_and_si256(
+      _mm256_and_si256(
+          Lookup16(byte_1_high,
+                   _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+          Lookup16(byte_1_low, _mm256_and_si256(prev1, nibble))),
+      Lookup16(byte_2_high,
+               _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+
+  const __m256i prev2 = Previous<2>(in, state->prev_input);
+  const __m256i prev3 = Previous<3>(in, state->prev_input);
+  const __m256i must_be_continuation = _mm256_and_si256(
+      _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80)),
+                      _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xf0 - 0x80))),
+      _mm256_set1_epi8(static_cast<char>(0x80)));
+
+  state->error = _mm256_or_si256(
+      state->error, _mm256_xor_si256(must_be_continuation, special));
+  state->prev_incomplete = _mm256_subs_epu8(
+      in, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(incomplete)));
+  state->prev_input = in;
+}
+
+#undef UTF8_BYTE_1_HIGH
+#undef UTF8_BYTE_1_LOW
+#undef UTF8_BYTE_2_HIGH
+#undef UTF8_INCOMPLETE
+
+NODE_TARGET("ssse3")
+bool ValidateUtf8SSSE3(const char* src, size_t len, uint8_t* max_byte) {
+  Utf8StateSSSE3 state = { _mm_setzero_si128(), _mm_setzero_si128(),
+                           _mm_setzero_si128(), _mm_setzero_si128() };
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    ValidateUtf8Block(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), &state);
+  }
+  if (i < len) {
+    // Pad with ASCII, which also catches a truncated last character.
+    char tail[16] = {};
+    memcpy(tail, src + i, len - i);
+    ValidateUtf8Block(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail)), &state);
+  }
+  state.error = _mm_or_si128(state.error, state.prev_incomplete);
+
+  uint8_t max[16];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(max), state.max);
+  *max_byte = 0;
+  for (uint8_t byte : max)
+    *max_byte = byte > *max_byte ? byte : *max_byte;
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(state.error,
+                                          _mm_setzero_si128())) == 0xffff;
+}
+
+NODE_TARGET("avx2")
+bool ValidateUtf8AVX2(const char* src, size_t len, uint8_t* max_byte) {
+  Utf8StateAVX2 state = { _mm256_setzero_si256(), _mm256_setzero_si256(),
+                          _mm256_setzero_si256(), _mm256_setzero_si256() };
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    ValidateUtf8Block(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)),
+        &state);
+  }
+  if (i < len) {
+    char tail[32] = {};
+    memcpy(tail, src + i, len - i);
+    ValidateUtf8Block(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail)), &state);
+  }
+  state.error = _mm256_or_si256(state.error, state.prev_incomplete);
+
+  uint8_t max[32];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(max), state.max);
+  *max_byte = 0;
+  for (uint8_t byte : max)
+    *max_byte = byte > *max_byte ? byte : *max_byte;
+  return _mm256_testz_si256(state.error, state.error) != 0;
+}
+
+// The following return how many bytes at the start of `src` form whole
+// blocks of ASCII, after copying them to `dst` unchanged or widened.
+
+NODE_TARGET("ssse3")
+size_t AsciiPrefixSSSE3(const char* src, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    if (_mm_movemask_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))) != 0)
+      break;
+  }
+  return i;
+}
+
+NODE_TARGET("avx2")
+size_t AsciiPrefixAVX2(const char* src, size_t len) {
+  size_t i = 0;
+  for (; i + 128 <= len; i += 128) {
+    const __m256i* p = reinterpret_cast<const __m256i*>(src + i);
+    const __m256i any = _mm256_or_si256(
+        _mm256_or_si256(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1)),
+        _mm256_or_si256(_mm256_loadu_si256(p + 2),
+                        _mm256_loadu_si256(p + 3)));
+    if (_mm256_movemask_epi8(any) != 0)
+      break;
+  }
+  for (; i + 32 <= len; i += 32) {
+    if (_mm256_movemask_epi8(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(src + i))) != 0)
+      break;
+  }
+  return i;
+}
+
+NODE_TARGET("ssse3")
+size_t CopyAsciiSSSE3(const char* src, size_t len, char* dst) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(in) != 0)
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), in);
+  }
+  return i;
+}
+
+NODE_TARGET("avx2")
+size_t CopyAsciiAVX2(const char* src, size_t len, char* dst) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    if (_mm256_movemask_epi8(in) != 0)
+      break;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), in);
+  }
+  return i;
+}
+
+NODE_TARGET("ssse3")
+size_t WidenAsciiSSSE3(const char* src, size_t len, uint16_t* dst) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(in) != 0)
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_unpacklo_epi8(in, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8),
+                     _mm_unpackhi_epi8(in, zero));
+  }
+  return i;
+}
+
+NODE_TARGET("avx2")
+size_t WidenAsciiAVX2(const char* src, size_t len, uint16_t* dst) {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    if (_mm256_movemask_epi8(in) != 0)
+      break;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_cvtepu8_epi16(_mm256_castsi256_si128(in)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16),
+                        _mm256_cvtepu8_epi16(
+                            _mm256_extracti128_si256(in, 1)));
+  }
+  return i;
+}
+
+NODE_TARGET("avx2")
+size_t CountHighBytesAVX2(const char* src, size_t len, size_t* count) {
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  while (i + 32 <= len) {
+    // Count per byte lane, and sum up the lanes before they can overflow.
+    __m256i lanes = zero;
+    for (int n = 0; n < 255 && i + 32 <= len; n++, i += 32) {
+      const __m256i in =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+      lanes = _mm256_sub_epi8(lanes, _mm256_cmpgt_epi8(zero, in));
+    }
+    const __m256i sums = _mm256_sad_epu8(lanes, zero);
+    *count += _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+              _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+  }
+  return i;
+}
+
+// The substring search kernels compare the first and the last byte of the
+// needle against a block of candidate positions at once, and only look at
+// the rest of the needle for positions where both match. Candidates are
+// the positions in [*pos, end) going forward, and in [0, *pos) going
+// backward. On a match *pos is set to it; otherwise it is left at the
+// first candidate that was not checked.
+
+inline unsigned LowestBit(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+inline unsigned HighestBit(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanReverse(&index, mask);
+  return index;
+#else
+  return 31 - __builtin_clz(mask);
+#endif
+}
+
+NODE_TARGET("ssse3")
+bool FindForwardSSSE3(const char* haystack, size_t end, const char* needle,
+                      size_t nlen, size_t* pos) {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[nlen - 1]);
+  size_t i = *pos;
+  for (; i + 16 <= end; i += 16) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    const __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(haystack + i + nlen - 1));
+    uint32_t mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+    for (; mask != 0; mask &= mask - 1) {
+      const size_t candidate = i + LowestBit(mask);
+      if (memcmp(haystack + candidate + 1, needle + 1, nlen - 2) == 0) {
+        *pos = candidate;
+        return true;
+      }
+    }
+  }
+  *pos = i;
+  return false;
+}
+
+NODE_TARGET("avx2")
+bool FindForwardAVX2(const char* haystack, size_t end, const char* needle,
+                     size_t nlen, size_t* pos) {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[nlen - 1]);
+  size_t i = *pos;
+  for (; i + 32 <= end; i += 32) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+    const __m256i b = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(haystack + i + nlen - 1));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+    for (; mask != 0; mask &= mask - 1) {
+      const size_t candidate = i + LowestBit(mask);
+      if (memcmp(haystack + candidate + 1, needle + 1, nlen - 2) == 0) {
+        *pos = candidate;
+        return true;
+      }
+    }
+  }
+  *pos = i;
+  return false;
+}
+
+NODE_TARGET("ssse3")
+bool FindBackwardSSSE3(const char* haystack, const char* needle, size_t nlen,
+                       size_t* pos) {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[nlen - 1]);
+  size_t i = *pos;
+  for (; i >= 16; i -= 16) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i - 16));
+    const __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(haystack + i - 16 + nlen - 1));
+    uint32_t mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+    while (mask != 0) {
+      const unsigned bit = HighestBit(mask);
+      const size_t candidate = i - 16 + bit;
+      if (memcmp(haystack + candidate + 1, needle + 1, nlen - 2) == 0) {
+        *pos = candidate;
+        return true;
+      }
+      mask &= ~(uint32_t{1} << bit);
+    }
+  }
+  *pos = i;
+  return false;
+}
+
+NODE_TARGET("avx2")
+bool FindBackwardAVX2(const char* haystack, const char* needle, size_t nlen,
+                      size_t* pos) {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[nlen - 1]);
+  size_t i = *pos;
+  for (; i >= 32; i -= 32) {
+    const __m256i a = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(haystack + i - 32));
+    const __m256i b = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(haystack + i - 32 + nlen - 1));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+    while (mask != 0) {
+      const unsigned bit = HighestBit(mask);
+      const size_t candidate = i - 32 + bit;
+      if (memcmp(haystack + candidate + 1, needle + 1, nlen - 2) == 0) {
+        *pos = candidate;
+        return true;
+      }
+      mask &= ~(uint32_t{1} << bit);
+    }
+  }
+  *pos = i;
+  return false;
+}
+#endif  // NODE_SIMD_X86
+
+// Scalar versions of the vectorized paths below, for valid input.
+
+inline size_t AsciiPrefix(const char* src, size_t len) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2: return AsciiPrefixAVX2(src, len);
+    case Level::kSSSE3: return AsciiPrefixSSSE3(src, len);
+    case Level::kNone: break;
+  }
+#endif
+  return 0;
+}
+
+inline size_t CopyAscii(const char* src, size_t len, char* dst) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2: return CopyAsciiAVX2(src, len, dst);
+    case Level::kSSSE3: return CopyAsciiSSSE3(src, len, dst);
+    case Level::kNone: break;
+  }
+#endif
+  return 0;
+}
+
+inline size_t WidenAscii(const char* src, size_t len, uint16_t* dst) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2: return WidenAsciiAVX2(src, len, dst);
+    case Level::kSSSE3: return WidenAsciiSSSE3(src, len, dst);
+    case Level::kNone: break;
+  }
+#endif
+  return 0;
+}
+
+// How many bytes to handle one at a time before checking for an ASCII block
+// again, so that text without much ASCII does not check every character.
+constexpr size_t kScalarRun = 32;
+
+bool ValidateUtf8Scalar(const char* src, size_t len, uint8_t* max_byte) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  uint8_t max = 0;
+  size_t i = 0;
+  while (i < len) {
+    const uint8_t c = s[i];
+    max = c > max ? c : max;
+    if (c < 0x80) {
+      i++;
+      continue;
+    }
+    size_t n;
+    uint8_t lo = 0x80;
+    uint8_t hi = 0xbf;
+    if (c >= 0xc2 && c <= 0xdf) {
+      n = 1;
+    } else if (c >= 0xe0 && c <= 0xef) {
+      n = 2;
+      if (c == 0xe0) lo = 0xa0;
+      if (c == 0xed) hi = 0x9f;
+    } else if (c >= 0xf0 && c <= 0xf4) {
+      n = 3;
+      if (c == 0xf0) lo = 0x90;
+      if (c == 0xf4) hi = 0x8f;
+    } else {
+      return false;
+    }
+    if (len - i <= n || s[i + 1] < lo || s[i + 1] > hi)
+      return false;
+    for (size_t j = 2; j <= n; j++) {
+      if ((s[i + j] & 0xc0) != 0x80)
+        return false;
+    }
+    // Continuation bytes are smaller than any lead byte, so they cannot
+    // raise `max`.
+    i += n + 1;
+  }
+  *max_byte = max;
+  return true;
+}
+
+// Decodes the character at `s`, which has to be valid UTF-8.
+inline size_t DecodeUtf8(const uint8_t* s, uint32_t* code_point) {
+  const uint8_t c = s[0];
+  if (c < 0x80) {
+    *code_point = c;
+    return 1;
+  }
+  if (c < 0xe0) {
+    *code_point = (c & 0x1f) << 6 | (s[1] & 0x3f);
+    return 2;
+  }
+  if (c < 0xf0) {
+    *code_point = (c & 0x0f) << 12 | (s[1] & 0x3f) << 6 | (s[2] & 0x3f);
+    return 3;
+  }
+  *code_point = (c & 0x07) << 18 | (s[1] & 0x3f) << 12 |
+                (s[2] & 0x3f) << 6 | (s[3] & 0x3f);
+  return 4;
+}
+
+}  // anonymous namespace
+
+Level GetLevel() {
+#if NODE_SIMD_X86
+  static const Level level = DetectLevel();
+  return level;
+#else
+  return Level::kNone;
+#endif
+}
+
+// The AVX2 kernels leave any remainder of at least one SSSE3 block to the
+// SSSE3 kernels, which in turn leave the rest to the caller.
+
+size_t Base64Encode(const char* src, size_t slen, char* dst,
+                    const char* table) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return Base64EncodeSSSE3(src, slen, dst, table,
+                               Base64EncodeAVX2(src, slen, dst, table));
+    case Level::kSSSE3:
+      return Base64EncodeSSSE3(src, slen, dst, table, 0);
+    case Level::kNone:
+      break;
+  }
+#endif
+  return 0;
+}
+
+size_t Base64Decode(char* dst, size_t dstlen, size_t max_out,
+                    const char* src, size_t srclen) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return Base64DecodeSSSE3(
+          dst, dstlen, max_out, src, srclen,
+          Base64DecodeAVX2(dst, dstlen, max_out, src, srclen));
+    case Level::kSSSE3:
+      return Base64DecodeSSSE3(dst, dstlen, max_out, src, srclen, 0);
+    case Level::kNone:
+      break;
+  }
+#endif
+  return 0;
+}
+
+size_t HexEncode(const char* src, size_t slen, char* dst) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return HexEncodeSSSE3(src, slen, dst, HexEncodeAVX2(src, slen, dst));
+    case Level::kSSSE3:
+      return HexEncodeSSSE3(src, slen, dst, 0);
+    case Level::kNone:
+      break;
+  }
+#endif
+  return 0;
+}
+
+size_t HexDecode(char* dst, size_t dstlen, const char* src, size_t srclen) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return HexDecodeSSSE3(dst, dstlen, src, srclen,
+                            HexDecodeAVX2(dst, dstlen, src, srclen));
+    case Level::kSSSE3:
+      return HexDecodeSSSE3(dst, dstlen, src, srclen, 0);
+    case Level::kNone:
+      break;
+  }
+#endif
+  return 0;
+}
+
+bool IsAscii(const char* src, size_t len) {
+  size_t i = AsciiPrefix(src, len);
+  for (; i < len; i++) {
+    if (src[i] & 0x80)
+      return false;
+  }
+  return true;
+}
+
+bool ValidateUtf8(const char* src, size_t len, uint8_t* max_byte) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return ValidateUtf8AVX2(src, len, max_byte);
+    case Level::kSSSE3:
+      return ValidateUtf8SSSE3(src, len, max_byte);
+    case Level::kNone:
+      break;
+  }
+#endif
+  return ValidateUtf8Scalar(src, len, max_byte);
+}
+
+size_t Utf8ToLatin1(const char* src, size_t len, char* dst) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  size_t i = 0;
+  size_t k = 0;
+  while (i < len) {
+    const size_t ascii = CopyAscii(src + i, len - i, dst + k);
+    i += ascii;
+    k += ascii;
+    for (size_t end = i + kScalarRun; i < len && i < end; k++) {
+      if (s[i] < 0x80) {
+        dst[k] = s[i];
+        i += 1;
+      } else {
+        dst[k] = (s[i] & 0x1f) << 6 | (s[i + 1] & 0x3f);
+        i += 2;
+      }
+    }
+  }
+  return k;
+}
+
+size_t Utf8ToUtf16(const char* src, size_t len, uint16_t* dst) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  size_t i = 0;
+  size_t k = 0;
+  while (i < len) {
+    const size_t ascii = WidenAscii(src + i, len - i, dst + k);
+    i += ascii;
+    k += ascii;
+    for (size_t end = i + kScalarRun; i < len && i < end;) {
+      uint32_t code_point;
+      i += DecodeUtf8(s + i, &code_point);
+      if (code_point < 0x10000) {
+        dst[k++] = code_point;
+      } else {
+        code_point -= 0x10000;
+        dst[k++] = 0xd800 | (code_point >> 10);
+        dst[k++] = 0xdc00 | (code_point & 0x3ff);
+      }
+    }
+  }
+  return k;
+}
+
+size_t Latin1Utf8Length(const char* src, size_t len) {
+  size_t count = 0;
+  size_t i = 0;
+#if NODE_SIMD_X86
+  if (GetLevel() == Level::kAVX2)
+    i = CountHighBytesAVX2(src, len, &count);
+#endif
+  for (; i < len; i++)
+    count += (src[i] & 0x80) != 0;
+  return len + count;
+}
+
+size_t Latin1ToUtf8(const char* src, size_t len, char* dst) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  size_t i = 0;
+  size_t k = 0;
+  while (i < len) {
+    const size_t ascii = CopyAscii(src + i, len - i, dst + k);
+    i += ascii;
+    k += ascii;
+    for (size_t end = i + kScalarRun; i < len && i < end; i++) {
+      if (s[i] < 0x80) {
+        dst[k++] = s[i];
+      } else {
+        dst[k++] = 0xc0 | (s[i] >> 6);
+        dst[k++] = 0x80 | (s[i] & 0x3f);
+      }
+    }
+  }
+  return k;
+}
+
+size_t Find(const char* haystack, size_t hlen, const char* needle,
+            size_t nlen, size_t start, bool is_forward) {
+  if (hlen < nlen)
+    return hlen;
+  const size_t end = hlen - nlen + 1;
+  auto matches = [&](size_t i) {
+    return haystack[i] == needle[0] &&
+           haystack[i + nlen - 1] == needle[nlen - 1] &&
+           memcmp(haystack + i + 1, needle + 1, nlen - 2) == 0;
+  };
+
+  if (is_forward) {
+    if (start >= end)
+      return hlen;
+    size_t i = start;
+#if NODE_SIMD_X86
+    bool found = false;
+    switch (GetLevel()) {
+      case Level::kAVX2:
+        found = FindForwardAVX2(haystack, end, needle, nlen, &i) ||
+                FindForwardSSSE3(haystack, end, needle, nlen, &i);
+        break;
+      case Level::kSSSE3:
+        found = FindForwardSSSE3(haystack, end, needle, nlen, &i);
+        break;
+      case Level::kNone:
+        break;
+    }
+    if (found)
+      return i;
+#endif
+    for (; i < end; i++) {
+      if (matches(i))
+        return i;
+    }
+  } else {
+    size_t i = start < end ? start + 1 : end;
+#if NODE_SIMD_X86
+    bool found = false;
+    switch (GetLevel()) {
+      case Level::kAVX2:
+        found = FindBackwardAVX2(haystack, needle, nlen, &i) ||
+                FindBackwardSSSE3(haystack, needle, nlen, &i);
+        break;
+      case Level::kSSSE3:
+        found = FindBackwardSSSE3(haystack, needle, nlen, &i);
+        break;
+      case Level::kNone:
+        break;
+    }
+    if (found)
+      return i;
+#endif
+    for (; i > 0; i--) {
+      if (matches(i - 1))
+        return i - 1;
+    }
+  }
+  return hlen;
+}
+
+}  // namespace simd
+}  // namespace node
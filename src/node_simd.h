@@ -0,0 +1,100 @@
+#ifndef SRC_NODE_SIMD_H_
+#define SRC_NODE_SIMD_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized kernels for hot byte-processing loops. The kernels are picked
+// at runtime based on what the CPU supports and only ever handle the bulk of
+// the input; callers finish the remainder (and anything unusual, such as
+// invalid characters) with their existing scalar code, which also remains
+// the fallback on CPUs and architectures without a kernel.
+
+#if defined(__x86_64__) || defined(_M_X64) || \
+    defined(__i386__) || defined(_M_IX86)
+#define NODE_SIMD_X86 1
+#else
+#define NODE_SIMD_X86 0
+#endif
+
+namespace node {
+namespace simd {
+
+enum class Level {
+  kNone,
+  kSSSE3,
+  kAVX2
+};
+
+// The best instruction set extension that is usable on this machine.
+Level GetLevel();
+
+// Each kernel returns how much of the input it consumed. That is always
+// a whole number of blocks, and may be 0 when the input is short, the CPU
+// has no suitable extension, or the first block needs the scalar path.
+
+// Encodes groups of 3 bytes from `src` into 4 characters each at `dst`,
+// using `table` as the 64 character alphabet ('+/' or '-_' for the last
+// two characters). Returns the number of input bytes consumed.
+size_t Base64Encode(const char* src, size_t slen, char* dst,
+                    const char* table);
+
+// Decodes groups of 4 characters (from either alphabet) into 3 bytes each.
+// Stops before the first block that contains padding, whitespace or other
+// characters outside of the alphabet. At most `max_out` bytes are produced,
+// but up to `dstlen` bytes of `dst` may be written to. Returns the number of
+// input characters consumed; the output length is 3/4 of that.
+size_t Base64Decode(char* dst, size_t dstlen, size_t max_out,
+                    const char* src, size_t srclen);
+
+// Writes two lowercase hex digits per input byte. Returns the number of
+// input bytes consumed.
+size_t HexEncode(const char* src, size_t slen, char* dst);
+
+// Decodes pairs of hex digits of either case into at most `dstlen` bytes.
+// Stops before the first block that contains a non-hex character. Returns
+// the number of bytes written.
+size_t HexDecode(char* dst, size_t dstlen, const char* src, size_t srclen);
+
+// The functions below handle all of their input, with a scalar fallback of
+// their own.
+
+// Returns whether all bytes are below 0x80.
+bool IsAscii(const char* src, size_t len);
+
+// Returns whether `src` is valid UTF-8, i.e. has no truncated, overlong or
+// surrogate sequences and nothing above U+10FFFF. Also reports the largest
+// byte seen: below 0x80 the input is ASCII, and below 0xC4 every character
+// fits into Latin-1.
+bool ValidateUtf8(const char* src, size_t len, uint8_t* max_byte);
+
+// Transcode input that ValidateUtf8() accepted. `dst` needs room for `len`
+// units. Return the number of units written.
+size_t Utf8ToLatin1(const char* src, size_t len, char* dst);
+size_t Utf8ToUtf16(const char* src, size_t len, uint16_t* dst);
+
+// Returns the length of the UTF-8 encoding of Latin-1 text.
+size_t Latin1Utf8Length(const char* src, size_t len);
+
+// `dst` needs room for Latin1Utf8Length() bytes. Returns the number of bytes
+// written.
+size_t Latin1ToUtf8(const char* src, size_t len, char* dst);
+
+constexpr size_t kMaxFindNeedleLength = 64;
+
+// Returns the position of the first occurrence of `needle` (at least two
+// bytes long) in `haystack` at or after `start`, or of the last occurrence
+// at or before `start` when `is_forward` is false. Returns `hlen` if there
+// is none. Vectorized kernels outpace Boyer-Moore-Horspool for needles of
+// up to kMaxFindNeedleLength bytes.
+size_t Find(const char* haystack, size_t hlen, const char* needle,
+            size_t nlen, size_t start, bool is_forward);
+
+}  // namespace simd
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_SIMD_H_
@@ -5,6 +5,7 @@
 #include "memory_tracker-inl.h"
 #include "uv.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -158,9 +159,11 @@ SocketAddress::CompareResult compare_ipv4(
   const sockaddr_in* two_in =
       reinterpret_cast<const sockaddr_in*>(two.data());
 
-  if (one_in->sin_addr.s_addr < two_in->sin_addr.s_addr)
+  uint32_t one_addr = ntohl(one_in->sin_addr.s_addr);
+  uint32_t two_addr = ntohl(two_in->sin_addr.s_addr);
+  if (one_addr < two_addr)
     return SocketAddress::CompareResult::LESS_THAN;
-  else if (one_in->sin_addr.s_addr == two_in->sin_addr.s_addr)
+  else if (one_addr == two_addr)
     return SocketAddress::CompareResult::SAME;
   else
     return SocketAddress::CompareResult::GREATER_THAN;
@@ -211,7 +214,7 @@ bool in_network_ipv4(
     const SocketAddress& ip,
     const SocketAddress& net,
     int prefix) {
-  uint32_t mask = ((1 << prefix) - 1) << (32 - prefix);
+  uint32_t mask = prefix == 0 ? 0 : ~uint32_t{0} << (32 - prefix);
 
   const sockaddr_in* ip_in =
       reinterpret_cast<const sockaddr_in*>(ip.data());
@@ -289,7 +292,7 @@ bool in_network_ipv6_ipv4(
   if (prefix == 32)
     return compare_ipv4_ipv6(net, ip) == SocketAddress::CompareResult::SAME;
 
-  uint32_t m = ((1 << prefix) - 1) << (32 - prefix);
+  uint32_t m = prefix == 0 ? 0 : ~uint32_t{0} << (32 - prefix);
 
   const sockaddr_in6* ip_in =
       reinterpret_cast<const sockaddr_in6*>(ip.data());
@@ -307,6 +310,18 @@ bool in_network_ipv6_ipv4(
 
   return (check & m) == (htonl(net_in->sin_addr.s_addr) & m);
 }
+
+// Returns the number of leading zero bits in a non-zero value.
+int LeadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(value);
+#else
+  int count = 0;
+  for (uint64_t bit = uint64_t{1} << 63; (value & bit) == 0; bit >>= 1)
+    count++;
+  return count;
+#endif
+}
 }  // namespace
 
 // TODO(@jasnell): The implementations of is_match, compare, and
@@ -395,6 +410,7 @@ void SocketAddressBlockList::AddSocketAddress(
       std::make_unique<SocketAddressRule>(address);
   rules_.emplace_front(std::move(rule));
   address_rules_[address] = rules_.begin();
+  prefixes_.Add(Key::From(address), 128);
 }
 
 void SocketAddressBlockList::RemoveSocketAddress(
@@ -403,6 +419,7 @@ void SocketAddressBlockList::RemoveSocketAddress(
   if (it != std::end(address_rules_)) {
     rules_.erase(it->second);
     address_rules_.erase(it);
+    prefixes_.Remove(Key::From(address), 128);
   }
 }
 
@@ -412,6 +429,26 @@ void SocketAddressBlockList::AddSocketAddressRange(
   std::unique_ptr<Rule> rule =
       std::make_unique<SocketAddressRangeRule>(start, end);
   rules_.emplace_front(std::move(rule));
+
+  // Keep the SocketAddress::compare() semantics: IPv4 addresses only match
+  // ranges that lie entirely within the IPv4-mapped space, and IPv6 addresses
+  // are only comparable to an IPv4 endpoint if they are IPv4-mapped.
+  Key start_key = Key::From(start);
+  Key end_key = Key::From(end);
+  if (start_key.is_ipv4_mapped() && end_key.is_ipv4_mapped()) {
+    ipv4_ranges_.Add(start_key, end_key);
+  } else if (start.family() == AF_INET || end.family() == AF_INET) {
+    Key mapped_start;
+    Key mapped_end;
+    mapped_start.lo = uint64_t{0xffff} << 32;
+    mapped_end.lo = uint64_t{0xffffffffffff};
+    if (start_key < mapped_start) start_key = mapped_start;
+    if (mapped_end < end_key) end_key = mapped_end;
+    if (start_key <= end_key)
+      ipv6_ranges_.Add(start_key, end_key);
+  } else {
+    ipv6_ranges_.Add(start_key, end_key);
+  }
 }
 
 void SocketAddressBlockList::AddSocketAddressMask(
@@ -420,16 +457,208 @@ void SocketAddressBlockList::AddSocketAddressMask(
   std::unique_ptr<Rule> rule =
       std::make_unique<SocketAddressMaskRule>(network, prefix);
   rules_.emplace_front(std::move(rule));
+  prefixes_.Add(Key::From(network),
+                network.family() == AF_INET ? 96 + prefix : prefix);
 }
 
 bool SocketAddressBlockList::Apply(const SocketAddress& address) {
-  for (const auto& rule : rules_) {
-    if (rule->Apply(address))
+  int family = address.family();
+  if (family == AF_INET || family == AF_INET6) {
+    Key key = Key::From(address);
+    if (prefixes_.Contains(key) ||
+        ipv4_ranges_.Contains(key) ||
+        (family == AF_INET6 && ipv6_ranges_.Contains(key))) {
       return true;
+    }
   }
   return parent_ ? parent_->Apply(address) : false;
 }
 
+SocketAddressBlockList::Key SocketAddressBlockList::Key::From(
+    const SocketAddress& address) {
+  Key key;
+  if (address.family() == AF_INET) {
+    const sockaddr_in* in =
+        reinterpret_cast<const sockaddr_in*>(address.data());
+    key.lo = uint64_t{0xffff} << 32 | ntohl(in->sin_addr.s_addr);
+  } else {
+    CHECK_EQ(address.family(), AF_INET6);
+    const uint8_t* ptr =
+        reinterpret_cast<const sockaddr_in6*>(address.data())->sin6_addr.s6_addr;
+    for (int i = 0; i < 8; i++) {
+      key.hi = key.hi << 8 | ptr[i];
+      key.lo = key.lo << 8 | ptr[i + 8];
+    }
+  }
+  return key;
+}
+
+bool SocketAddressBlockList::Key::operator<(const Key& other) const {
+  return hi < other.hi || (hi == other.hi && lo < other.lo);
+}
+
+bool SocketAddressBlockList::Key::operator<=(const Key& other) const {
+  return !(other < *this);
+}
+
+bool SocketAddressBlockList::Key::is_ipv4_mapped() const {
+  return hi == 0 && (lo >> 32) == 0xffff;
+}
+
+bool SocketAddressBlockList::Key::bit(int index) const {
+  if (index < 64)
+    return (hi >> (63 - index)) & 1;
+  return (lo >> (127 - index)) & 1;
+}
+
+SocketAddressBlockList::Key SocketAddressBlockList::Key::masked(
+    int prefix) const {
+  Key key;
+  if (prefix == 128) {
+    key = *this;
+  } else if (prefix >= 64) {
+    key.hi = hi;
+    key.lo = lo & ~(~uint64_t{0} >> (prefix - 64));
+  } else {
+    key.hi = hi & ~(~uint64_t{0} >> prefix);
+  }
+  return key;
+}
+
+int SocketAddressBlockList::Key::common_prefix(const Key& other) const {
+  if (hi != other.hi)
+    return LeadingZeros(hi ^ other.hi);
+  if (lo != other.lo)
+    return 64 + LeadingZeros(lo ^ other.lo);
+  return 128;
+}
+
+void SocketAddressBlockList::PrefixTrie::Add(const Key& address, int prefix) {
+  Key key = address.masked(prefix);
+  std::unique_ptr<Node>* slot = &root;
+
+  while (*slot) {
+    Node* node = slot->get();
+    int common = std::min({ key.common_prefix(node->key),
+                            node->prefix,
+                            prefix });
+    if (common == node->prefix) {
+      if (prefix == node->prefix) {
+        node->rules++;
+        return;
+      }
+      slot = &node->children[key.bit(node->prefix)];
+      continue;
+    }
+
+    // The key leaves the path to `node` early, so split that path.
+    std::unique_ptr<Node> branch = std::make_unique<Node>();
+    branch->key = key.masked(common);
+    branch->prefix = common;
+    nodes++;
+    bool node_bit = node->key.bit(common);
+    branch->children[node_bit] = std::move(*slot);
+    *slot = std::move(branch);
+    if (prefix == common) {
+      (*slot)->rules = 1;
+      return;
+    }
+    slot = &(*slot)->children[!node_bit];
+  }
+
+  *slot = std::make_unique<Node>();
+  (*slot)->key = key;
+  (*slot)->prefix = prefix;
+  (*slot)->rules = 1;
+  nodes++;
+}
+
+void SocketAddressBlockList::PrefixTrie::Remove(
+    const Key& address,
+    int prefix) {
+  Key key = address.masked(prefix);
+  std::vector<std::unique_ptr<Node>*> path;
+  std::unique_ptr<Node>* slot = &root;
+
+  while (*slot && (*slot)->prefix < prefix) {
+    if (key.common_prefix((*slot)->key) < (*slot)->prefix)
+      return;
+    path.push_back(slot);
+    slot = &(*slot)->children[key.bit((*slot)->prefix)];
+  }
+
+  if (!*slot ||
+      (*slot)->prefix != prefix ||
+      key.common_prefix((*slot)->key) < prefix ||
+      (*slot)->rules == 0) {
+    return;
+  }
+  (*slot)->rules--;
+
+  // Drop nodes that neither end a rule nor branch anymore.
+  for (;;) {
+    Node* node = slot->get();
+    if (node->rules > 0 || (node->children[0] && node->children[1]))
+      return;
+    std::unique_ptr<Node> child =
+        std::move(node->children[node->children[0] ? 0 : 1]);
+    *slot = std::move(child);
+    nodes--;
+    if (path.empty())
+      return;
+    slot = path.back();
+    path.pop_back();
+  }
+}
+
+bool SocketAddressBlockList::PrefixTrie::Contains(const Key& key) const {
+  const Node* node = root.get();
+  while (node != nullptr) {
+    if (key.common_prefix(node->key) < node->prefix)
+      return false;
+    if (node->rules > 0)
+      return true;
+    if (node->prefix == 128)
+      return false;
+    node = node->children[key.bit(node->prefix)].get();
+  }
+  return false;
+}
+
+void SocketAddressBlockList::RangeSet::Add(const Key& start, const Key& end) {
+  ranges.push_back(Range { start, end, end });
+  sorted = false;
+}
+
+bool SocketAddressBlockList::RangeSet::Contains(const Key& key) {
+  if (ranges.empty())
+    return false;
+
+  if (!sorted) {
+    std::sort(ranges.begin(), ranges.end(),
+              [](const Range& a, const Range& b) {
+                return a.start < b.start;
+              });
+    Key max_end = ranges[0].end;
+    for (Range& range : ranges) {
+      if (max_end < range.end)
+        max_end = range.end;
+      range.max_end = max_end;
+    }
+    sorted = true;
+  }
+
+  // Of all ranges that start at or before the key, check whether the one
+  // that reaches furthest also reaches the key.
+  auto it = std::upper_bound(ranges.begin(), ranges.end(), key,
+                             [](const Key& key, const Range& range) {
+                               return key < range.start;
+                             });
+  if (it == ranges.begin())
+    return false;
+  return key <= std::prev(it)->max_end;
+}
+
 SocketAddressBlockList::SocketAddressRule::SocketAddressRule(
     const SocketAddress& address_)
     : address(address_) {}
@@ -501,6 +730,12 @@ MaybeLocal<Array> SocketAddressBlockList::ListRules(Environment* env) {
 
 void SocketAddressBlockList::MemoryInfo(node::MemoryTracker* tracker) const {
   tracker->TrackField("rules", rules_);
+  tracker->TrackFieldWithSize("prefixes",
+                              prefixes_.nodes * sizeof(PrefixTrie::Node));
+  tracker->TrackFieldWithSize(
+      "ranges",
+      (ipv4_ranges_.ranges.capacity() + ipv6_ranges_.ranges.capacity()) *
+          sizeof(RangeSet::Range));
 }
 
 void SocketAddressBlockList::SocketAddressRule::MemoryInfo(
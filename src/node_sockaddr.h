@@ -14,6 +14,7 @@
 #include <string>
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 namespace node {
 
@@ -267,9 +268,64 @@ class SocketAddressBlockList : public MemoryRetainer {
   SET_SELF_SIZE(SocketAddressBlockList)
 
  private:
+  // Rules are matched on 128-bit keys. IPv4 addresses are mapped into
+  // ::ffff:0:0/96, so that they also match IPv4-mapped IPv6 addresses.
+  struct Key {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    static Key From(const SocketAddress& address);
+    bool operator<(const Key& other) const;
+    bool operator<=(const Key& other) const;
+    bool is_ipv4_mapped() const;
+    bool bit(int index) const;
+    Key masked(int prefix) const;
+    int common_prefix(const Key& other) const;
+  };
+
+  // A path-compressed binary trie of address (/128) and subnet rules. A key
+  // is blocked if any node on its path ends at least one rule.
+  struct PrefixTrie {
+    struct Node {
+      Key key;  // Only the first `prefix` bits are set.
+      int prefix = 0;
+      size_t rules = 0;
+      std::unique_ptr<Node> children[2];
+    };
+
+    void Add(const Key& key, int prefix);
+    void Remove(const Key& key, int prefix);
+    bool Contains(const Key& key) const;
+
+    std::unique_ptr<Node> root;
+    size_t nodes = 0;
+  };
+
+  // Ranges, sorted by their start when the list is first checked after a
+  // change. Each entry also knows the largest end of all ranges up to it,
+  // so a binary search finds whether any range contains a key.
+  struct RangeSet {
+    struct Range {
+      Key start;
+      Key end;
+      Key max_end;
+    };
+
+    void Add(const Key& start, const Key& end);
+    bool Contains(const Key& key);
+
+    std::vector<Range> ranges;
+    bool sorted = true;
+  };
+
   std::shared_ptr<SocketAddressBlockList> parent_;
   std::list<std::unique_ptr<Rule>> rules_;
   SocketAddress::Map<std::list<std::unique_ptr<Rule>>::iterator> address_rules_;
+  PrefixTrie prefixes_;
+  // An IPv4 address is only compared to ranges between two IPv4 (or
+  // IPv4-mapped) addresses, so those are kept apart from the others.
+  RangeSet ipv4_ranges_;
+  RangeSet ipv6_ranges_;
 };
 
 class SocketAddressBlockListWrap :
@@ -124,7 +124,10 @@ void CachedDataVersionTag(const FunctionCallbackInfo<Value>& args) {
 }
 
 static inline double RecordReplayDouble(const char* why, double d) {
-  v8::recordreplay::RecordReplayBytes("UpdateHeapStatisticsBuffer", &d, sizeof(d));
+  // After diverging from the recording the actual statistics are reported.
+  if (!v8::recordreplay::HasDivergedFromRecording()) {
+    v8::recordreplay::RecordReplayBytes("UpdateHeapStatisticsBuffer", &d, sizeof(d));
+  }
   return d;
 }
 
@@ -54,6 +54,7 @@ Worker::Worker(Environment* env,
       per_isolate_opts_(per_isolate_opts),
       exec_argv_(exec_argv),
       platform_(env->isolate_data()->platform()),
+      mutex_(/* ordered */ true),
       thread_id_(AllocateEnvironmentThreadId()),
       env_vars_(env_vars) {
   Debug(this, "Creating new worker instance with thread id %llu",
@@ -239,18 +240,31 @@ class WorkerThreadData {
 
 size_t Worker::NearHeapLimit(void* data, size_t current_heap_limit,
                              size_t initial_heap_limit) {
+  Worker* worker = static_cast<Worker*>(data);
   // We can't force workers to exit at non-deterministic points when
-  // recording/replaying.
-  if (!v8::recordreplay::IsRecordingOrReplaying()) {
-    Worker* worker = static_cast<Worker*>(data);
+  // recording/replaying. The exit is deferred to the next event loop
+  // iteration, see MaybeExitNearHeapLimit().
+  if (v8::recordreplay::IsRecordingOrReplaying())
+    worker->near_heap_limit_ = true;
+  else
     worker->Exit(1, "ERR_WORKER_OUT_OF_MEMORY", "JS heap out of memory");
-  }
   // Give the current GC some extra leeway to let it finish rather than
   // crash hard. We are not going to perform further allocations anyway.
   constexpr size_t kExtraHeapAllowance = 16 * 1024 * 1024;
   return current_heap_limit + kExtraHeapAllowance;
 }
 
+void Worker::MaybeExitNearHeapLimit() {
+  if (!v8::recordreplay::IsRecordingOrReplaying())
+    return;
+  // Whether the limit was reached depends on when the GC ran, so the
+  // decision is recorded, and the recorded one is used when replaying.
+  bool exit = v8::recordreplay::RecordReplayValue(
+      "Worker::MaybeExitNearHeapLimit", near_heap_limit_.exchange(false));
+  if (exit)
+    Exit(1, "ERR_WORKER_OUT_OF_MEMORY", "JS heap out of memory");
+}
+
 void Worker::Run() {
   std::string name = "WorkerThread ";
   name += std::to_string(thread_id_.id);
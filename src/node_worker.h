@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
 #include <unordered_map>
 #include "node_messaging.h"
 #include "uv.h"
@@ -44,6 +45,11 @@ class Worker : public AsyncWrap {
   // Wait for the worker thread to stop (in a blocking manner).
   void JoinThread();
 
+  // When recording or replaying, exit the thread if the heap limit was
+  // reached since the last call. This is only called from the worker thread,
+  // at the same point of each event loop iteration.
+  void MaybeExitNearHeapLimit();
+
   template <typename Fn>
   inline bool RequestInterrupt(Fn&& cb);
 
@@ -73,6 +79,8 @@ class Worker : public AsyncWrap {
   void CreateEnvMessagePort(Environment* env);
   static size_t NearHeapLimit(void* data, size_t current_heap_limit,
                               size_t initial_heap_limit);
+  // Set by NearHeapLimit() when it can't exit the thread immediately.
+  std::atomic<bool> near_heap_limit_ {false};
 
   std::shared_ptr<PerIsolateOptions> per_isolate_opts_;
   std::vector<std::string> exec_argv_;
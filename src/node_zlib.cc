@@ -22,6 +22,8 @@
 #include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_buffer.h"
+#include "node_errors.h"
+#include "node_mutex.h"
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
@@ -36,14 +38,18 @@
 
 #include <sys/types.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
 #include <atomic>
+#include <functional>
 
 namespace node {
 
+using v8::Array;
 using v8::ArrayBuffer;
+using v8::Boolean;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -56,6 +62,7 @@ using v8::Local;
 using v8::Object;
 using v8::String;
 using v8::Uint32Array;
+using v8::Undefined;
 using v8::Value;
 
 namespace {
@@ -124,6 +131,215 @@ struct CompressionError {
   inline bool IsError() const { return code != nullptr; }
 };
 
+// Compresses large inputs on several threads, the way pigz does: the input is
+// cut into blocks that are compressed independently of each other, up to
+// `parallelism` of them at the same time, and the results are concatenated in
+// order. The input is only cut at multiples of the block size and at flushes,
+// so the output does not depend on the number of threads.
+class ParallelCompressor : public MemoryRetainer {
+ public:
+  enum Flush { kNoFlush, kFlush, kFullFlush, kFinish };
+
+  ParallelCompressor(MultiIsolatePlatform* platform,
+                     uint32_t parallelism,
+                     size_t block_size,
+                     size_t history_size);
+  ~ParallelCompressor() override = default;
+
+  // Like deflate(), consumes all of the input and completes the flush unless
+  // the output buffer fills up first. Returns false if a block could not be
+  // compressed.
+  bool Process(Flush flush,
+               const uint8_t** next_in, size_t* avail_in,
+               uint8_t** next_out, size_t* avail_out);
+  // Whether the stream is complete and all of it has been handed out.
+  inline bool IsFinished() const { return finished_ && output_.empty(); }
+  virtual void Reset();
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("input", input_);
+    tracker->TrackField("output", output_);
+  }
+
+  ParallelCompressor(const ParallelCompressor&) = delete;
+  ParallelCompressor& operator=(const ParallelCompressor&) = delete;
+
+ protected:
+  struct Block {
+    // Up to `history_size` bytes of input directly preceding `data`, which
+    // can be used to prime the compressor.
+    const uint8_t* history;
+    size_t history_size;
+    const uint8_t* data;
+    size_t size;
+    uint64_t offset;  // Of `data` within the uncompressed stream.
+    bool last;
+    uint32_t check;  // For formats with a checksum.
+    bool ok;
+    std::vector<uint8_t> out;
+  };
+
+  // Called on several threads at once, but never twice at the same time
+  // with the same `slot`, which is less than `parallelism`.
+  virtual bool CompressBlock(size_t slot, Block* block) = 0;
+  // Called in stream order on the thread that calls Process().
+  virtual void WriteHeader(std::vector<uint8_t>* out) {}
+  virtual void AfterBlock(const Block& block) {}
+  virtual void WriteTrailer(std::vector<uint8_t>* out) {}
+
+  // Makes `data` the history of the first block, e.g. a preset dictionary.
+  void SetHistory(const uint8_t* data, size_t size);
+
+  inline uint32_t parallelism() const { return parallelism_; }
+  inline uint64_t total_in() const { return total_in_; }
+
+ private:
+  bool CompressBatch(bool last);
+
+  MultiIsolatePlatform* platform_;
+  uint32_t parallelism_;
+  size_t block_size_;
+  size_t history_size_;
+  // The input that still needs to be compressed, preceded by up to
+  // `history_size_` bytes of input that has been already.
+  std::vector<uint8_t> input_;
+  size_t input_history_ = 0;
+  std::vector<uint8_t> output_;
+  size_t output_offset_ = 0;
+  std::vector<Block> blocks_;
+  uint64_t total_in_ = 0;
+  bool started_ = false;
+  bool finished_ = false;
+};
+
+// Produces gzip, zlib and raw deflate streams from blocks of 128 KiB, each
+// primed with the 32 KiB of input before it and ended with a sync flush, so
+// that compression is close to that of a single deflate stream.
+class ParallelDeflate final : public ParallelCompressor {
+ public:
+  ParallelDeflate(MultiIsolatePlatform* platform,
+                  uint32_t parallelism,
+                  node_zlib_mode mode,
+                  int level,
+                  int window_bits,
+                  int mem_level,
+                  int strategy,
+                  const std::vector<unsigned char>& dictionary,
+                  alloc_func alloc,
+                  free_func free,
+                  void* opaque);
+  ~ParallelDeflate() override;
+
+  // Works like deflate() on the buffers of `strm`.
+  int Deflate(z_stream* strm, int flush);
+  void Reset() override;
+  void SetParams(int level, int strategy);
+
+  SET_MEMORY_INFO_NAME(ParallelDeflate)
+  SET_SELF_SIZE(ParallelDeflate)
+
+ private:
+  bool CompressBlock(size_t slot, Block* block) override;
+  void WriteHeader(std::vector<uint8_t>* out) override;
+  void AfterBlock(const Block& block) override;
+  void WriteTrailer(std::vector<uint8_t>* out) override;
+
+  struct Slot {
+    z_stream strm;
+    bool initialized = false;
+    int level = 0;
+    int strategy = 0;
+  };
+
+  node_zlib_mode mode_;
+  int level_;
+  int window_bits_;
+  int mem_level_;
+  int strategy_;
+  std::vector<unsigned char> dictionary_;
+  alloc_func alloc_;
+  free_func free_;
+  void* opaque_;
+  // Never resized, since zlib keeps pointers to the streams.
+  std::vector<Slot> slots_;
+  uLong check_ = 0;
+};
+
+// Produces brotli streams from blocks of 1 MiB. The encoder for each block
+// is told where the block starts in the stream, which lets the blocks be
+// concatenated after flushing all but the last one.
+class ParallelBrotliEncoder final : public ParallelCompressor {
+ public:
+  ParallelBrotliEncoder(MultiIsolatePlatform* platform,
+                        uint32_t parallelism,
+                        brotli_alloc_func alloc,
+                        brotli_free_func free,
+                        void* opaque);
+
+  // Works like BrotliEncoderCompressStream().
+  bool Compress(BrotliEncoderOperation op,
+                size_t* avail_in, const uint8_t** next_in,
+                size_t* avail_out, uint8_t** next_out);
+  inline void SetParameter(BrotliEncoderParameter key, uint32_t value) {
+    params_.emplace_back(key, value);
+  }
+
+  SET_MEMORY_INFO_NAME(ParallelBrotliEncoder)
+  SET_SELF_SIZE(ParallelBrotliEncoder)
+
+ private:
+  bool CompressBlock(size_t slot, Block* block) override;
+
+  brotli_alloc_func alloc_;
+  brotli_free_func free_;
+  void* opaque_;
+  std::vector<std::pair<BrotliEncoderParameter, uint32_t>> params_;
+};
+
+// A dictionary that is shared by many streams, from zlib.prepareDictionary().
+// The deflate state that deflateSetDictionary() derives from it is computed
+// once for each set of parameters, and copied into new streams with
+// deflateCopy().
+class PreparedDictionary : public MemoryRetainer {
+ public:
+  explicit PreparedDictionary(std::vector<unsigned char>&& data);
+  ~PreparedDictionary() override;
+
+  const std::vector<unsigned char>& data() const { return data_; }
+
+  // Initializes `strm` as a deflate stream that has the dictionary set,
+  // allocating through the functions set on `strm`, and keeping the buffers
+  // set on it. Returns a zlib status code.
+  int DeflateInit(z_stream* strm,
+                  int level,
+                  int window_bits,
+                  int mem_level,
+                  int strategy);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(PreparedDictionary)
+  SET_SELF_SIZE(PreparedDictionary)
+
+  PreparedDictionary(const PreparedDictionary&) = delete;
+  PreparedDictionary& operator=(const PreparedDictionary&) = delete;
+
+ private:
+  struct Template {
+    int level;
+    int window_bits;
+    int mem_level;
+    int strategy;
+    z_stream strm;
+  };
+
+  // Streams with parameters beyond these fall back to deflateSetDictionary().
+  static constexpr size_t kMaxTemplates = 4;
+
+  const std::vector<unsigned char> data_;
+  mutable Mutex mutex_;  // Protects templates_.
+  std::vector<std::unique_ptr<Template>> templates_;
+};
+
 class ZlibContext : public MemoryRetainer {
  public:
   ZlibContext() = default;
@@ -142,6 +358,10 @@ class ZlibContext : public MemoryRetainer {
   void Init(int level, int window_bits, int mem_level, int strategy,
             std::vector<unsigned char>&& dictionary);
   void SetAllocationFunctions(alloc_func alloc, free_func free, void* opaque);
+  // Needs to be called before Init(). Only affects compression.
+  void SetParallelism(MultiIsolatePlatform* platform, uint32_t parallelism);
+  // Needs to be called before Init(), which then ignores its `dictionary`.
+  void SetPreparedDictionary(std::shared_ptr<PreparedDictionary> dictionary);
   CompressionError SetParams(int level, int strategy);
 
   SET_MEMORY_INFO_NAME(ZlibContext)
@@ -149,6 +369,8 @@ class ZlibContext : public MemoryRetainer {
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackField("dictionary", dictionary_);
+    tracker->TrackField("prepared_dictionary", prepared_dictionary_);
+    tracker->TrackField("parallel", parallel_);
   }
 
   ZlibContext(const ZlibContext&) = delete;
@@ -158,6 +380,11 @@ class ZlibContext : public MemoryRetainer {
   CompressionError ErrorForMessage(const char* message) const;
   CompressionError SetDictionary();
   bool InitZlib();
+  int DeflateInit();
+
+  const std::vector<unsigned char>& dictionary() const {
+    return prepared_dictionary_ ? prepared_dictionary_->data() : dictionary_;
+  }
 
   Mutex mutex_;  // Protects zlib_init_done_.
   bool zlib_init_done_ = false;
@@ -170,6 +397,12 @@ class ZlibContext : public MemoryRetainer {
   int window_bits_ = 0;
   unsigned int gzip_id_bytes_read_ = 0;
   std::vector<unsigned char> dictionary_;
+  std::shared_ptr<PreparedDictionary> prepared_dictionary_;
+  MultiIsolatePlatform* platform_ = nullptr;
+  uint32_t parallelism_ = 1;
+  // When set, this compresses instead of strm_, which then only holds the
+  // buffers.
+  std::unique_ptr<ParallelDeflate> parallel_;
 
   z_stream strm_;
 };
@@ -184,12 +417,16 @@ class BrotliContext : public MemoryRetainer {
   void SetFlush(int flush);
   void GetAfterWriteOffsets(uint32_t* avail_in, uint32_t* avail_out) const;
   inline void SetMode(node_zlib_mode mode) { mode_ = mode; }
+  // Needs to be called before Init(). Only affects compression.
+  void SetParallelism(MultiIsolatePlatform* platform, uint32_t parallelism);
 
   BrotliContext(const BrotliContext&) = delete;
   BrotliContext& operator=(const BrotliContext&) = delete;
 
  protected:
   node_zlib_mode mode_ = NONE;
+  MultiIsolatePlatform* platform_ = nullptr;
+  uint32_t parallelism_ = 1;
   uint8_t* next_in_ = nullptr;
   uint8_t* next_out_ = nullptr;
   size_t avail_in_ = 0;
@@ -216,11 +453,18 @@ class BrotliEncoderContext final : public BrotliContext {
 
   SET_MEMORY_INFO_NAME(BrotliEncoderContext)
   SET_SELF_SIZE(BrotliEncoderContext)
-  SET_NO_MEMORY_INFO()  // state_ is covered through allocation tracking.
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    // state_ is covered through allocation tracking.
+    tracker->TrackField("parallel", parallel_);
+  }
 
  private:
   bool last_result_ = false;
   DeleteFnPtr<BrotliEncoderState, BrotliEncoderDestroyInstance> state_;
+  // When set, this compresses instead of state_, which then only validates
+  // the parameters.
+  std::unique_ptr<ParallelBrotliEncoder> parallel_;
 };
 
 class BrotliDecoderContext final : public BrotliContext {
@@ -245,6 +489,30 @@ class BrotliDecoderContext final : public BrotliContext {
   DeleteFnPtr<BrotliDecoderState, BrotliDecoderDestroyInstance> state_;
 };
 
+// A batch stops growing its output at this size, or at the chunk size if
+// that is larger, so that highly compressed input does not produce
+// unbounded amounts of output in one go.
+constexpr size_t kMaxBatchOutput = 1024 * 1024;
+
+// The state of a writeBatch() call. The output of all chunks goes into one
+// allocation that grows as needed and is handed to JS without copying.
+struct CompressionBatch {
+  ~CompressionBatch() { free(output); }
+
+  std::vector<uv_buf_t> inputs;
+  size_t index = 0;
+  uint32_t first = 0;
+  uint32_t flush = 0;
+  uint32_t last_flush = 0;
+  char* output = nullptr;
+  size_t length = 0;
+  size_t capacity = 0;
+  size_t limit = 0;
+  size_t chunk_size = 0;
+  bool ended = false;
+  bool out_of_memory = false;
+};
+
 template <typename CompressionContext>
 class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  public:
@@ -297,15 +565,7 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
 
     CHECK_EQ(false, args[0]->IsUndefined() && "must provide flush value");
     if (!args[0]->Uint32Value(context).To(&flush)) return;
-
-    if (flush != Z_NO_FLUSH &&
-        flush != Z_PARTIAL_FLUSH &&
-        flush != Z_SYNC_FLUSH &&
-        flush != Z_FULL_FLUSH &&
-        flush != Z_FINISH &&
-        flush != Z_BLOCK) {
-      CHECK(0 && "Invalid flush value");
-    }
+    CheckFlush(flush);
 
     if (args[1]->IsNull()) {
       // just a flush
@@ -368,6 +628,67 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     ScheduleWork();
   }
 
+  // writeBatch(flush, last_flush, chunks, index, in_off, chunk_size)
+  // Compresses chunks[index] starting at in_off, and the chunks after it,
+  // in a single trip to the threadpool. Only the last chunk is written with
+  // last_flush.
+  static void WriteBatch(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    Local<Context> context = env->context();
+    CHECK_EQ(args.Length(), 6);
+
+    uint32_t flush, last_flush, index, in_off, chunk_size;
+    if (!args[0]->Uint32Value(context).To(&flush)) return;
+    if (!args[1]->Uint32Value(context).To(&last_flush)) return;
+    CheckFlush(flush);
+    CheckFlush(last_flush);
+
+    CHECK(args[2]->IsArray());
+    Local<Array> chunks = args[2].As<Array>();
+    if (!args[3]->Uint32Value(context).To(&index)) return;
+    if (!args[4]->Uint32Value(context).To(&in_off)) return;
+    if (!args[5]->Uint32Value(context).To(&chunk_size)) return;
+    CHECK_LT(index, chunks->Length());
+
+    auto batch = std::make_unique<CompressionBatch>();
+    batch->first = index;
+    batch->flush = flush;
+    batch->last_flush = last_flush;
+    batch->limit = std::max<size_t>(chunk_size, kMaxBatchOutput);
+    batch->chunk_size = chunk_size;
+    for (uint32_t i = index; i < chunks->Length(); i++) {
+      Local<Value> chunk;
+      if (!chunks->Get(context, i).ToLocal(&chunk)) return;
+      CHECK(Buffer::HasInstance(chunk));
+      CHECK_LE(Buffer::Length(chunk), UINT32_MAX);
+      batch->inputs.push_back(
+          uv_buf_init(Buffer::Data(chunk), Buffer::Length(chunk)));
+    }
+    CHECK_LE(in_off, batch->inputs[0].len);
+    batch->inputs[0].base += in_off;
+    batch->inputs[0].len -= in_off;
+
+    CompressionStream* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+
+    ctx->WriteBatch(std::move(batch));
+  }
+
+  void WriteBatch(std::unique_ptr<CompressionBatch> batch) {
+    AllocScope alloc_scope(this);
+
+    CHECK(init_done_ && "write before init");
+    CHECK(!closed_ && "already finalized");
+
+    CHECK_EQ(false, write_in_progress_);
+    CHECK_EQ(false, pending_close_);
+    write_in_progress_ = true;
+    Ref();
+
+    batch_ = std::move(batch);
+    ScheduleWork();
+  }
+
   void UpdateWriteResult() {
     ctx_.GetAfterWriteOffsets(&write_result_[1], &write_result_[0]);
   }
@@ -377,7 +698,58 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
   // for a single write() call, until all of the input bytes have
   // been consumed.
   void DoThreadPoolWork() override {
-    ctx_.DoThreadPoolWork();
+    if (batch_)
+      DoBatchWork();
+    else
+      ctx_.DoThreadPoolWork();
+  }
+
+  // Runs the chunks of a writeBatch() call through the library, growing the
+  // output as needed. Stops early on errors, when the stream has ended before
+  // the input did, and once the output has reached its limit.
+  void DoBatchWork() {
+    CompressionBatch* batch = batch_.get();
+    while (batch->index < batch->inputs.size()) {
+      if (batch->length == batch->capacity) {
+        if (batch->length >= batch->limit) return;
+        size_t capacity = std::min(
+            std::max(batch->capacity * 2, batch->chunk_size), batch->limit);
+        char* output = UncheckedRealloc(batch->output, capacity);
+        if (output == nullptr) {
+          batch->out_of_memory = true;
+          return;
+        }
+        batch->output = output;
+        batch->capacity = capacity;
+      }
+
+      uv_buf_t* in = &batch->inputs[batch->index];
+      const bool last = batch->index + 1 == batch->inputs.size();
+      const uint32_t avail_out_before = static_cast<uint32_t>(
+          std::min<size_t>(batch->capacity - batch->length, UINT32_MAX));
+      ctx_.SetBuffers(in->base, in->len,
+                      batch->output + batch->length, avail_out_before);
+      ctx_.SetFlush(last ? batch->last_flush : batch->flush);
+      ctx_.DoThreadPoolWork();
+      if (ctx_.GetErrorInfo().IsError()) return;
+
+      uint32_t avail_in, avail_out;
+      ctx_.GetAfterWriteOffsets(&avail_in, &avail_out);
+      batch->length += avail_out_before - avail_out;
+      in->base += in->len - avail_in;
+      in->len = avail_in;
+
+      // Not actually done with this chunk. Need to reprocess.
+      if (avail_out == 0) continue;
+
+      if (avail_in > 0) {
+        // The library was not interested in receiving more data, i.e. the
+        // input stream has ended early.
+        batch->ended = true;
+        return;
+      }
+      batch->index++;
+    }
   }
 
 
@@ -394,6 +766,7 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     AllocScope alloc_scope(this);
     auto on_scope_leave = OnScopeLeave([&]() { Unref(); });
 
+    std::unique_ptr<CompressionBatch> batch = std::move(batch_);
     write_in_progress_ = false;
 
     if (status == UV_ECANCELED) {
@@ -407,9 +780,21 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     HandleScope handle_scope(env->isolate());
     Context::Scope context_scope(env->context());
 
+    if (batch && batch->out_of_memory) {
+      EmitError(CompressionError("Out of memory", "Z_MEM_ERROR", Z_MEM_ERROR));
+      return;
+    }
+
     if (!CheckError())
       return;
 
+    if (batch) {
+      AfterBatchWork(batch.get());
+      if (pending_close_)
+        Close();
+      return;
+    }
+
     UpdateWriteResult();
 
     // call the write() cb
@@ -421,6 +806,37 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
       Close();
   }
 
+  // Reports how far the batch got through its input, and hands the output
+  // to the oncomplete(output, ended) callback as a single Buffer.
+  void AfterBatchWork(CompressionBatch* batch) {
+    Environment* env = AsyncWrap::env();
+    const bool done = batch->index == batch->inputs.size();
+    write_result_[0] = batch->first + batch->index;
+    write_result_[1] =
+        done ? 0 : static_cast<uint32_t>(batch->inputs[batch->index].len);
+
+    Local<Value> argv[] = {
+      Undefined(env->isolate()),
+      Boolean::New(env->isolate(), batch->ended)
+    };
+    if (batch->length > 0) {
+      char* data = batch->output;
+      batch->output = nullptr;
+      if (batch->length < batch->capacity) {
+        char* shrunk = UncheckedRealloc(data, batch->length);
+        if (shrunk != nullptr) data = shrunk;
+      }
+      Local<Object> output;
+      if (!Buffer::New(env, data, batch->length).ToLocal(&output)) {
+        EmitError(
+            CompressionError("Out of memory", "Z_MEM_ERROR", Z_MEM_ERROR));
+        return;
+      }
+      argv[0] = output;
+    }
+    MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  }
+
   // TODO(addaleax): Switch to modern error system (node_errors.h).
   void EmitError(const CompressionError& err) {
     Environment* env = AsyncWrap::env();
@@ -518,6 +934,17 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
   };
 
  private:
+  static void CheckFlush(uint32_t flush) {
+    if (flush != Z_NO_FLUSH &&
+        flush != Z_PARTIAL_FLUSH &&
+        flush != Z_SYNC_FLUSH &&
+        flush != Z_FULL_FLUSH &&
+        flush != Z_FINISH &&
+        flush != Z_BLOCK) {
+      CHECK(0 && "Invalid flush value");
+    }
+  }
+
   void Ref() {
     if (++refs_ == 1) {
       ClearWeak();
@@ -541,9 +968,51 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
   std::atomic<ssize_t> unreported_allocations_{0};
   size_t zlib_memory_ = 0;
 
+  std::unique_ptr<CompressionBatch> batch_;
+
   CompressionContext ctx_;
 };
 
+// The object that zlib.prepareDictionary() returns. It can be passed to any
+// number of zlib streams, which keep the dictionary alive while they need it.
+class ZlibDictionary : public BaseObject {
+ public:
+  ZlibDictionary(Environment* env,
+                 Local<Object> wrap,
+                 std::shared_ptr<PreparedDictionary> dictionary)
+      : BaseObject(env, wrap), dictionary_(std::move(dictionary)) {
+    MakeWeak();
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args.IsConstructCall());
+    CHECK(Buffer::HasInstance(args[0]));
+    unsigned char* data =
+        reinterpret_cast<unsigned char*>(Buffer::Data(args[0]));
+    std::vector<unsigned char> dictionary(data,
+                                          data + Buffer::Length(args[0]));
+    new ZlibDictionary(
+        env,
+        args.This(),
+        std::make_shared<PreparedDictionary>(std::move(dictionary)));
+  }
+
+  const std::shared_ptr<PreparedDictionary>& dictionary() const {
+    return dictionary_;
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("dictionary", dictionary_);
+  }
+
+  SET_MEMORY_INFO_NAME(ZlibDictionary)
+  SET_SELF_SIZE(ZlibDictionary)
+
+ private:
+  std::shared_ptr<PreparedDictionary> dictionary_;
+};
+
 class ZlibStream : public CompressionStream<ZlibContext> {
  public:
   ZlibStream(Environment* env, Local<Object> wrap, node_zlib_mode mode)
@@ -571,9 +1040,9 @@ class ZlibStream : public CompressionStream<ZlibContext> {
           "a version of npm (> 5.5.1 or < 5.4.0) or node-tar (> 4.0.1) "
           "that is compatible with Node.js 9 and above.\n");
     }
-    CHECK(args.Length() == 7 &&
+    CHECK((args.Length() == 7 || args.Length() == 8) &&
       "init(windowBits, level, memLevel, strategy, writeResult, writeCallback,"
-      " dictionary)");
+      " dictionary[, parallelism])");
 
     ZlibStream* wrap;
     ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -605,19 +1074,40 @@ class ZlibStream : public CompressionStream<ZlibContext> {
     Local<Function> write_js_callback = args[5].As<Function>();
 
     std::vector<unsigned char> dictionary;
+    std::shared_ptr<PreparedDictionary> prepared_dictionary;
     if (Buffer::HasInstance(args[6])) {
       unsigned char* data =
           reinterpret_cast<unsigned char*>(Buffer::Data(args[6]));
       dictionary = std::vector<unsigned char>(
           data,
           data + Buffer::Length(args[6]));
+    } else if (args[6]->IsObject()) {
+      // lib/zlib.js checks this with instanceof, which objects that merely
+      // inherit from ZlibDictionary.prototype pass as well.
+      Environment* env = Environment::GetCurrent(args);
+      if (!env->zlib_dictionary_constructor_template()->HasInstance(args[6])) {
+        return THROW_ERR_INVALID_ARG_TYPE(env,
+            "The \"options.dictionary\" argument must be a Buffer, "
+            "TypedArray, DataView, ArrayBuffer or prepared dictionary");
+      }
+      ZlibDictionary* prepared;
+      ASSIGN_OR_RETURN_UNWRAP(&prepared, args[6].As<Object>());
+      prepared_dictionary = prepared->dictionary();
     }
 
+    uint32_t parallelism = 1;
+    if (args.Length() > 7 && !args[7]->Uint32Value(context).To(&parallelism))
+      return;
+
     wrap->InitStream(write_result, write_js_callback);
 
     AllocScope alloc_scope(wrap);
     wrap->context()->SetAllocationFunctions(
         AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
+    wrap->context()->SetParallelism(
+        Environment::GetCurrent(args)->isolate_data()->platform(),
+        parallelism);
+    wrap->context()->SetPreparedDictionary(std::move(prepared_dictionary));
     wrap->context()->Init(level, window_bits, mem_level, strategy,
                           std::move(dictionary));
   }
@@ -668,16 +1158,28 @@ class BrotliCompressionStream : public CompressionStream<CompressionContext> {
   static void Init(const FunctionCallbackInfo<Value>& args) {
     BrotliCompressionStream* wrap;
     ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
-    CHECK(args.Length() == 3 && "init(params, writeResult, writeCallback)");
+    CHECK((args.Length() == 3 || args.Length() == 4) &&
+          "init(params, writeResult, writeCallback[, parallelism])");
 
     CHECK(args[1]->IsUint32Array());
     uint32_t* write_result = reinterpret_cast<uint32_t*>(Buffer::Data(args[1]));
 
     CHECK(args[2]->IsFunction());
     Local<Function> write_js_callback = args[2].As<Function>();
+
+    uint32_t parallelism = 1;
+    if (args.Length() > 3 &&
+        !args[3]->Uint32Value(args.GetIsolate()->GetCurrentContext())
+            .To(&parallelism)) {
+      return;
+    }
+
     wrap->InitStream(write_result, write_js_callback);
 
     AllocScope alloc_scope(wrap);
+    wrap->context()->SetParallelism(
+        Environment::GetCurrent(args)->isolate_data()->platform(),
+        parallelism);
     CompressionError err =
         wrap->context()->Init(
           CompressionStream<CompressionContext>::AllocForBrotli,
@@ -726,6 +1228,8 @@ void ZlibContext::Close() {
     Mutex::ScopedLock lock(mutex_);
     if (!zlib_init_done_) {
       dictionary_.clear();
+      prepared_dictionary_.reset();
+      parallel_.reset();
       mode_ = NONE;
       return;
     }
@@ -734,7 +1238,9 @@ void ZlibContext::Close() {
   CHECK_LE(mode_, UNZIP);
 
   int status = Z_OK;
-  if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
+  if (parallel_) {
+    parallel_.reset();
+  } else if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
     status = deflateEnd(&strm_);
   } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
              mode_ == UNZIP) {
@@ -745,6 +1251,7 @@ void ZlibContext::Close() {
   mode_ = NONE;
 
   dictionary_.clear();
+  prepared_dictionary_.reset();
 }
 
 
@@ -763,7 +1270,10 @@ void ZlibContext::DoThreadPoolWork() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflate(&strm_, flush_);
+      if (parallel_)
+        err_ = parallel_->Deflate(&strm_, flush_);
+      else
+        err_ = deflate(&strm_, flush_);
       break;
     case UNZIP:
       if (strm_.avail_in > 0) {
@@ -819,11 +1329,11 @@ void ZlibContext::DoThreadPoolWork() {
       // SetDictionary, don't repeat that here)
       if (mode_ != INFLATERAW &&
           err_ == Z_NEED_DICT &&
-          !dictionary_.empty()) {
+          !dictionary().empty()) {
         // Load it
         err_ = inflateSetDictionary(&strm_,
-                                    dictionary_.data(),
-                                    dictionary_.size());
+                                    dictionary().data(),
+                                    dictionary().size());
         if (err_ == Z_OK) {
           // And try to decode again
           err_ = inflate(&strm_, flush_);
@@ -895,7 +1405,7 @@ CompressionError ZlibContext::GetErrorInfo() const {
     // normal statuses, not fatal
     break;
   case Z_NEED_DICT:
-    if (dictionary_.empty())
+    if (dictionary().empty())
       return ErrorForMessage("Missing dictionary");
     else
       return ErrorForMessage("Bad dictionary");
@@ -916,9 +1426,25 @@ CompressionError ZlibContext::ResetStream() {
 
   err_ = Z_OK;
 
+  if (parallel_) {
+    parallel_->Reset();
+    return CompressionError {};
+  }
+
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
+      if (prepared_dictionary_) {
+        // Start over from the prepared state, which already has the
+        // dictionary set.
+        deflateEnd(&strm_);
+        err_ = DeflateInit();
+        if (err_ != Z_OK)
+          mode_ = NONE;
+        break;
+      }
+      err_ = deflateReset(&strm_);
+      break;
     case GZIP:
       err_ = deflateReset(&strm_);
       break;
@@ -992,6 +1518,29 @@ void ZlibContext::Init(
   }
 
   dictionary_ = std::move(dictionary);
+
+  if (parallelism_ > 1 &&
+      (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW)) {
+    parallel_ = std::make_unique<ParallelDeflate>(
+        platform_, parallelism_, mode_, level_, window_bits, mem_level_,
+        strategy_, this->dictionary(), strm_.zalloc, strm_.zfree, strm_.opaque);
+    strm_.msg = nullptr;
+  }
+}
+
+void ZlibContext::SetParallelism(MultiIsolatePlatform* platform,
+                                 uint32_t parallelism) {
+  // Stay on the threadpool thread while recording or replaying, so that the
+  // recording does not depend on the platform's worker threads.
+  if (v8::recordreplay::IsRecordingOrReplaying() || platform == nullptr)
+    return;
+  platform_ = platform;
+  parallelism_ = parallelism;
+}
+
+void ZlibContext::SetPreparedDictionary(
+    std::shared_ptr<PreparedDictionary> dictionary) {
+  prepared_dictionary_ = std::move(dictionary);
 }
 
 bool ZlibContext::InitZlib() {
@@ -1000,16 +1549,17 @@ bool ZlibContext::InitZlib() {
     return false;
   }
 
+  if (parallel_) {
+    // The blocks are compressed with streams of their own.
+    zlib_init_done_ = true;
+    return true;
+  }
+
   switch (mode_) {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflateInit2(&strm_,
-                          level_,
-                          Z_DEFLATED,
-                          window_bits_,
-                          mem_level_,
-                          strategy_);
+      err_ = DeflateInit();
       break;
     case INFLATE:
     case GUNZIP:
@@ -1023,6 +1573,7 @@ bool ZlibContext::InitZlib() {
 
   if (err_ != Z_OK) {
     dictionary_.clear();
+    prepared_dictionary_.reset();
     mode_ = NONE;
     return true;
   }
@@ -1033,8 +1584,26 @@ bool ZlibContext::InitZlib() {
 }
 
 
+int ZlibContext::DeflateInit() {
+  // gzip streams do not support dictionaries.
+  if (prepared_dictionary_ && mode_ != GZIP) {
+    return prepared_dictionary_->DeflateInit(&strm_,
+                                             level_,
+                                             window_bits_,
+                                             mem_level_,
+                                             strategy_);
+  }
+  return deflateInit2(&strm_,
+                      level_,
+                      Z_DEFLATED,
+                      window_bits_,
+                      mem_level_,
+                      strategy_);
+}
+
+
 CompressionError ZlibContext::SetDictionary() {
-  if (dictionary_.empty())
+  if (dictionary().empty())
     return CompressionError {};
 
   err_ = Z_OK;
@@ -1042,6 +1611,9 @@ CompressionError ZlibContext::SetDictionary() {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
+      // DeflateInit() has copied the state for a prepared dictionary.
+      if (prepared_dictionary_)
+        break;
       err_ = deflateSetDictionary(&strm_,
                                   dictionary_.data(),
                                   dictionary_.size());
@@ -1050,8 +1622,8 @@ CompressionError ZlibContext::SetDictionary() {
       // The other inflate cases will have the dictionary set when inflate()
       // returns Z_NEED_DICT in Process()
       err_ = inflateSetDictionary(&strm_,
-                                  dictionary_.data(),
-                                  dictionary_.size());
+                                  dictionary().data(),
+                                  dictionary().size());
       break;
     default:
       break;
@@ -1065,6 +1637,113 @@ CompressionError ZlibContext::SetDictionary() {
 }
 
 
+PreparedDictionary::PreparedDictionary(std::vector<unsigned char>&& data)
+    : data_(std::move(data)) {}
+
+
+PreparedDictionary::~PreparedDictionary() {
+  for (const auto& tmpl : templates_)
+    deflateEnd(&tmpl->strm);
+}
+
+
+int PreparedDictionary::DeflateInit(z_stream* strm,
+                                    int level,
+                                    int window_bits,
+                                    int mem_level,
+                                    int strategy) {
+  Mutex::ScopedLock lock(mutex_);
+
+  Template* found = nullptr;
+  for (const auto& tmpl : templates_) {
+    if (tmpl->level == level &&
+        tmpl->window_bits == window_bits &&
+        tmpl->mem_level == mem_level &&
+        tmpl->strategy == strategy) {
+      found = tmpl.get();
+      break;
+    }
+  }
+
+  if (found == nullptr && templates_.size() == kMaxTemplates) {
+    int err = deflateInit2(strm,
+                           level,
+                           Z_DEFLATED,
+                           window_bits,
+                           mem_level,
+                           strategy);
+    if (err != Z_OK) return err;
+    return deflateSetDictionary(strm, data_.data(), data_.size());
+  }
+
+  if (found == nullptr) {
+    auto tmpl = std::make_unique<Template>();
+    tmpl->level = level;
+    tmpl->window_bits = window_bits;
+    tmpl->mem_level = mem_level;
+    tmpl->strategy = strategy;
+    tmpl->strm.zalloc = Z_NULL;
+    tmpl->strm.zfree = Z_NULL;
+    tmpl->strm.opaque = Z_NULL;
+    int err = deflateInit2(&tmpl->strm,
+                           level,
+                           Z_DEFLATED,
+                           window_bits,
+                           mem_level,
+                           strategy);
+    if (err != Z_OK) return err;
+    err = deflateSetDictionary(&tmpl->strm, data_.data(), data_.size());
+    if (err != Z_OK) {
+      deflateEnd(&tmpl->strm);
+      return err;
+    }
+    found = tmpl.get();
+    templates_.emplace_back(std::move(tmpl));
+  }
+
+  // deflateCopy() overwrites all of `strm`, and allocates through the
+  // functions of the stream that it copies from, so lend it those of `strm`
+  // for the duration of the copy.
+  z_stream* source = &found->strm;
+  const z_stream saved = *strm;
+  const alloc_func source_alloc = source->zalloc;
+  const free_func source_free = source->zfree;
+  void* const source_opaque = source->opaque;
+  source->zalloc = saved.zalloc;
+  source->zfree = saved.zfree;
+  source->opaque = saved.opaque;
+  const int err = deflateCopy(strm, source);
+  source->zalloc = source_alloc;
+  source->zfree = source_free;
+  source->opaque = source_opaque;
+
+  strm->next_in = saved.next_in;
+  strm->avail_in = saved.avail_in;
+  strm->next_out = saved.next_out;
+  strm->avail_out = saved.avail_out;
+  if (err != Z_OK) {
+    strm->zalloc = saved.zalloc;
+    strm->zfree = saved.zfree;
+    strm->opaque = saved.opaque;
+  }
+  return err;
+}
+
+
+void PreparedDictionary::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("data", data_);
+  Mutex::ScopedLock lock(mutex_);
+  // The memory that zlib's documentation gives for each deflate stream.
+  size_t size = 0;
+  for (const auto& tmpl : templates_) {
+    size += sizeof(*tmpl) +
+        (size_t{1} << (std::abs(tmpl->window_bits) + 2)) +
+        (size_t{1} << (tmpl->mem_level + 9));
+  }
+  tracker->TrackFieldWithSize("templates", size);
+}
+
+
 CompressionError ZlibContext::SetParams(int level, int strategy) {
   bool first_init_call = InitZlib();
   if (first_init_call && err_ != Z_OK) {
@@ -1073,10 +1752,19 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
 
   err_ = Z_OK;
 
+  if (parallel_) {
+    parallel_->SetParams(level, strategy);
+    return CompressionError {};
+  }
+
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
       err_ = deflateParams(&strm_, level, strategy);
+      // ResetStream() rebuilds the stream from these when it uses a prepared
+      // dictionary.
+      level_ = level;
+      strategy_ = strategy;
       break;
     default:
       break;
@@ -1090,6 +1778,400 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
 }
 
 
+// Runs fn(0) to fn(count - 1), the first on the calling thread and the others
+// on the platform's worker threads, and returns once all of them are done.
+void RunInParallel(MultiIsolatePlatform* platform,
+                   size_t count,
+                   const std::function<void(size_t)>& fn) {
+  struct Latch {
+    Mutex mutex;
+    ConditionVariable done;
+    size_t pending;
+  };
+
+  class BlockTask : public v8::Task {
+   public:
+    BlockTask(Latch* latch, const std::function<void(size_t)>* fn, size_t i)
+        : latch_(latch), fn_(fn), i_(i) {}
+
+    void Run() override {
+      (*fn_)(i_);
+      Mutex::ScopedLock lock(latch_->mutex);
+      if (--latch_->pending == 0)
+        latch_->done.Signal(lock);
+    }
+
+   private:
+    Latch* latch_;
+    const std::function<void(size_t)>* fn_;
+    size_t i_;
+  };
+
+  Latch latch;
+  latch.pending = count - 1;
+  for (size_t i = 1; i < count; i++)
+    platform->CallOnWorkerThread(std::make_unique<BlockTask>(&latch, &fn, i));
+  fn(0);
+
+  Mutex::ScopedLock lock(latch.mutex);
+  while (latch.pending > 0)
+    latch.done.Wait(lock);
+}
+
+
+ParallelCompressor::ParallelCompressor(MultiIsolatePlatform* platform,
+                                       uint32_t parallelism,
+                                       size_t block_size,
+                                       size_t history_size)
+    : platform_(platform),
+      // Blocks beyond what the worker threads can take on at once would only
+      // wait for a thread while holding on to their memory.
+      parallelism_(std::min<uint32_t>(
+          parallelism, platform->NumberOfWorkerThreads() + 1)),
+      block_size_(block_size),
+      history_size_(history_size) {}
+
+
+bool ParallelCompressor::Process(Flush flush,
+                                 const uint8_t** next_in, size_t* avail_in,
+                                 uint8_t** next_out, size_t* avail_out) {
+  if (finished_ && *avail_in > 0)
+    return false;
+
+  const size_t batch_size = block_size_ * parallelism_;
+  while (true) {
+    if (output_offset_ < output_.size()) {
+      const size_t n = std::min(*avail_out, output_.size() - output_offset_);
+      if (n > 0) {
+        memcpy(*next_out, output_.data() + output_offset_, n);
+        *next_out += n;
+        *avail_out -= n;
+        output_offset_ += n;
+      }
+      if (output_offset_ < output_.size())
+        return true;
+      output_.clear();
+      output_offset_ = 0;
+    }
+
+    size_t pending = input_.size() - input_history_;
+    const size_t n = std::min(*avail_in, batch_size - pending);
+    if (n > 0) {
+      input_.insert(input_.end(), *next_in, *next_in + n);
+      *next_in += n;
+      *avail_in -= n;
+      pending += n;
+    }
+
+    // A full batch is only compressed once it is known whether it is the
+    // last one, so that the final block does not depend on the batch size.
+    bool ok;
+    const bool more_input = *avail_in > 0;
+    if (pending == batch_size &&
+        (more_input || (flush != kNoFlush && flush != kFinish)))
+      ok = CompressBatch(false);
+    else if (pending == batch_size && flush == kNoFlush)
+      break;
+    else if (flush == kFinish && !finished_)
+      ok = CompressBatch(true);
+    else if (flush != kNoFlush && pending > 0)
+      ok = CompressBatch(false);
+    else
+      break;
+    if (!ok)
+      return false;
+  }
+
+  if (flush == kFullFlush) {
+    // Like Z_FULL_FLUSH, keep later blocks from referring to earlier input.
+    input_.clear();
+    input_history_ = 0;
+  }
+  return true;
+}
+
+
+bool ParallelCompressor::CompressBatch(bool last) {
+  const size_t pending = input_.size() - input_history_;
+  size_t count = (pending + block_size_ - 1) / block_size_;
+  if (last && count == 0)
+    count = 1;
+  CHECK_LE(count, parallelism_);
+
+  blocks_.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    Block* block = &blocks_[i];
+    const size_t start = input_history_ + i * block_size_;
+    block->data = input_.data() + start;
+    block->size = std::min(block_size_, input_.size() - start);
+    block->history_size = std::min(history_size_, start);
+    block->history = block->data - block->history_size;
+    block->offset = total_in_ + i * block_size_;
+    block->last = last && i + 1 == count;
+    block->check = 0;
+    block->ok = false;
+    block->out.clear();
+  }
+
+  RunInParallel(platform_, count, [this](size_t i) {
+    blocks_[i].ok = CompressBlock(i, &blocks_[i]);
+  });
+
+  if (!started_) {
+    WriteHeader(&output_);
+    started_ = true;
+  }
+  for (size_t i = 0; i < count; i++) {
+    const Block& block = blocks_[i];
+    if (!block.ok)
+      return false;
+    output_.insert(output_.end(), block.out.begin(), block.out.end());
+    AfterBlock(block);
+  }
+  total_in_ += pending;
+  if (last) {
+    WriteTrailer(&output_);
+    finished_ = true;
+  }
+
+  const size_t keep = std::min(history_size_, input_.size());
+  input_.erase(input_.begin(), input_.end() - keep);
+  input_history_ = keep;
+  return true;
+}
+
+
+void ParallelCompressor::SetHistory(const uint8_t* data, size_t size) {
+  CHECK(!started_);
+  const size_t keep = std::min(history_size_, size);
+  input_.assign(data + size - keep, data + size);
+  input_history_ = keep;
+}
+
+
+void ParallelCompressor::Reset() {
+  input_.clear();
+  input_history_ = 0;
+  output_.clear();
+  output_offset_ = 0;
+  total_in_ = 0;
+  started_ = false;
+  finished_ = false;
+}
+
+
+// The operating system byte that zlib itself writes into gzip headers.
+#ifdef _WIN32
+constexpr uint8_t kGzipOsCode = 10;
+#else
+constexpr uint8_t kGzipOsCode = 3;
+#endif
+
+constexpr size_t kDeflateBlockSize = 128 * 1024;
+
+ParallelDeflate::ParallelDeflate(MultiIsolatePlatform* platform,
+                                 uint32_t parallelism,
+                                 node_zlib_mode mode,
+                                 int level,
+                                 int window_bits,
+                                 int mem_level,
+                                 int strategy,
+                                 const std::vector<unsigned char>& dictionary,
+                                 alloc_func alloc,
+                                 free_func free,
+                                 void* opaque)
+    : ParallelCompressor(platform, parallelism, kDeflateBlockSize,
+                         size_t{1} << window_bits),
+      mode_(mode),
+      level_(level),
+      // zlib does the same, see deflateInit2().
+      window_bits_(window_bits == 8 ? 9 : window_bits),
+      mem_level_(mem_level),
+      strategy_(strategy),
+      alloc_(alloc),
+      free_(free),
+      opaque_(opaque),
+      slots_(ParallelCompressor::parallelism()) {
+  // zlib does not support preset dictionaries for gzip streams.
+  if (mode_ != GZIP)
+    dictionary_ = dictionary;
+  Reset();
+}
+
+
+ParallelDeflate::~ParallelDeflate() {
+  for (Slot& slot : slots_) {
+    if (slot.initialized)
+      deflateEnd(&slot.strm);
+  }
+}
+
+
+int ParallelDeflate::Deflate(z_stream* strm, int flush) {
+  Flush kind;
+  switch (flush) {
+    case Z_NO_FLUSH:
+      kind = kNoFlush;
+      break;
+    case Z_FULL_FLUSH:
+      kind = kFullFlush;
+      break;
+    case Z_FINISH:
+      kind = kFinish;
+      break;
+    default:
+      // Every block ends with a sync flush anyway.
+      kind = kFlush;
+      break;
+  }
+
+  const uint8_t* next_in = strm->next_in;
+  size_t avail_in = strm->avail_in;
+  uint8_t* next_out = strm->next_out;
+  size_t avail_out = strm->avail_out;
+  const bool ok = Process(kind, &next_in, &avail_in, &next_out, &avail_out);
+  strm->next_in = const_cast<Bytef*>(next_in);
+  strm->avail_in = avail_in;
+  strm->next_out = next_out;
+  strm->avail_out = avail_out;
+
+  if (!ok)
+    return Z_STREAM_ERROR;
+  return IsFinished() ? Z_STREAM_END : Z_OK;
+}
+
+
+void ParallelDeflate::Reset() {
+  ParallelCompressor::Reset();
+  check_ = mode_ == GZIP ? crc32(0, nullptr, 0) : adler32(0, nullptr, 0);
+  if (!dictionary_.empty())
+    SetHistory(dictionary_.data(), dictionary_.size());
+}
+
+
+void ParallelDeflate::SetParams(int level, int strategy) {
+  level_ = level;
+  strategy_ = strategy;
+}
+
+
+bool ParallelDeflate::CompressBlock(size_t slot_index, Block* block) {
+  Slot* slot = &slots_[slot_index];
+  z_stream* strm = &slot->strm;
+
+  if (slot->initialized &&
+      (slot->level != level_ || slot->strategy != strategy_)) {
+    deflateEnd(strm);
+    slot->initialized = false;
+  }
+  if (!slot->initialized) {
+    strm->zalloc = alloc_;
+    strm->zfree = free_;
+    strm->opaque = opaque_;
+    if (deflateInit2(strm, level_, Z_DEFLATED, -window_bits_, mem_level_,
+                     strategy_) != Z_OK) {
+      return false;
+    }
+    slot->initialized = true;
+    slot->level = level_;
+    slot->strategy = strategy_;
+  } else if (deflateReset(strm) != Z_OK) {
+    return false;
+  }
+
+  if (block->history_size > 0 &&
+      deflateSetDictionary(strm, block->history, block->history_size) != Z_OK) {
+    return false;
+  }
+
+  strm->next_in = const_cast<Bytef*>(block->data);
+  strm->avail_in = block->size;
+  // Leave room for the sync flush marker, so that one call is enough.
+  block->out.resize(deflateBound(strm, block->size) + 16);
+  const int flush = block->last ? Z_FINISH : Z_SYNC_FLUSH;
+  size_t used = 0;
+  do {
+    if (used == block->out.size())
+      block->out.resize(2 * used);
+    strm->next_out = block->out.data() + used;
+    strm->avail_out = block->out.size() - used;
+    const int err = deflate(strm, flush);
+    if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR)
+      return false;
+    used = block->out.size() - strm->avail_out;
+  } while (strm->avail_out == 0);
+  block->out.resize(used);
+
+  if (mode_ == GZIP)
+    block->check = crc32(0, block->data, block->size);
+  else if (mode_ == DEFLATE)
+    block->check = adler32(1, block->data, block->size);
+  return true;
+}
+
+
+void ParallelDeflate::WriteHeader(std::vector<uint8_t>* out) {
+  // This matches what deflate() writes for the same parameters.
+  const int level = level_ == Z_DEFAULT_COMPRESSION ? 6 : level_;
+  if (mode_ == GZIP) {
+    const uint8_t xfl =
+        level == 9 ? 2 : (strategy_ >= Z_HUFFMAN_ONLY || level < 2 ? 4 : 0);
+    out->insert(out->end(), {
+      GZIP_HEADER_ID1, GZIP_HEADER_ID2, Z_DEFLATED,
+      0,  // FLG
+      0, 0, 0, 0,  // MTIME
+      xfl, kGzipOsCode
+    });
+  } else if (mode_ == DEFLATE) {
+    unsigned int level_flags;
+    if (strategy_ >= Z_HUFFMAN_ONLY || level < 2)
+      level_flags = 0;
+    else if (level < 6)
+      level_flags = 1;
+    else if (level == 6)
+      level_flags = 2;
+    else
+      level_flags = 3;
+    unsigned int header = (Z_DEFLATED + ((window_bits_ - 8) << 4)) << 8;
+    header |= level_flags << 6;
+    if (!dictionary_.empty())
+      header |= 0x20;  // FDICT
+    header += 31 - (header % 31);
+    out->push_back(header >> 8);
+    out->push_back(header & 0xff);
+    if (!dictionary_.empty()) {
+      const uLong id = adler32(1, dictionary_.data(), dictionary_.size());
+      for (int shift = 24; shift >= 0; shift -= 8)
+        out->push_back((id >> shift) & 0xff);
+    }
+  }
+}
+
+
+void ParallelDeflate::AfterBlock(const Block& block) {
+  if (mode_ == GZIP)
+    check_ = crc32_combine(check_, block.check, block.size);
+  else if (mode_ == DEFLATE)
+    check_ = adler32_combine(check_, block.check, block.size);
+}
+
+
+void ParallelDeflate::WriteTrailer(std::vector<uint8_t>* out) {
+  if (mode_ == GZIP) {
+    // CRC-32 and the input size modulo 2^32, both little-endian.
+    const uint32_t size = static_cast<uint32_t>(total_in());
+    for (int shift = 0; shift < 32; shift += 8)
+      out->push_back((check_ >> shift) & 0xff);
+    for (int shift = 0; shift < 32; shift += 8)
+      out->push_back((size >> shift) & 0xff);
+  } else if (mode_ == DEFLATE) {
+    // Adler-32, big-endian.
+    for (int shift = 24; shift >= 0; shift -= 8)
+      out->push_back((check_ >> shift) & 0xff);
+  }
+}
+
+
 void BrotliContext::SetBuffers(char* in, uint32_t in_len,
                                char* out, uint32_t out_len) {
   next_in_ = reinterpret_cast<uint8_t*>(in);
@@ -1104,6 +2186,17 @@ void BrotliContext::SetFlush(int flush) {
 }
 
 
+void BrotliContext::SetParallelism(MultiIsolatePlatform* platform,
+                                   uint32_t parallelism) {
+  // Stay on the threadpool thread while recording or replaying, so that the
+  // recording does not depend on the platform's worker threads.
+  if (v8::recordreplay::IsRecordingOrReplaying() || platform == nullptr)
+    return;
+  platform_ = platform;
+  parallelism_ = parallelism;
+}
+
+
 void BrotliContext::GetAfterWriteOffsets(uint32_t* avail_in,
                                          uint32_t* avail_out) const {
   *avail_in = avail_in_;
@@ -1115,18 +2208,27 @@ void BrotliEncoderContext::DoThreadPoolWork() {
   CHECK_EQ(mode_, BROTLI_ENCODE);
   CHECK(state_);
   const uint8_t* next_in = next_in_;
-  last_result_ = BrotliEncoderCompressStream(state_.get(),
-                                             flush_,
-                                             &avail_in_,
-                                             &next_in,
-                                             &avail_out_,
-                                             &next_out_,
-                                             nullptr);
+  if (parallel_) {
+    last_result_ = parallel_->Compress(flush_,
+                                       &avail_in_,
+                                       &next_in,
+                                       &avail_out_,
+                                       &next_out_);
+  } else {
+    last_result_ = BrotliEncoderCompressStream(state_.get(),
+                                               flush_,
+                                               &avail_in_,
+                                               &next_in,
+                                               &avail_out_,
+                                               &next_out_,
+                                               nullptr);
+  }
   next_in_ += next_in - next_in_;
 }
 
 
 void BrotliEncoderContext::Close() {
+  parallel_.reset();
   state_.reset();
   mode_ = NONE;
 }
@@ -1142,9 +2244,13 @@ CompressionError BrotliEncoderContext::Init(brotli_alloc_func alloc,
     return CompressionError("Could not initialize Brotli instance",
                             "ERR_ZLIB_INITIALIZATION_FAILED",
                             -1);
-  } else {
-    return CompressionError {};
   }
+
+  if (parallelism_ > 1) {
+    parallel_ = std::make_unique<ParallelBrotliEncoder>(
+        platform_, parallelism_, alloc, free, opaque);
+  }
+  return CompressionError {};
 }
 
 CompressionError BrotliEncoderContext::ResetStream() {
@@ -1159,6 +2265,10 @@ CompressionError BrotliEncoderContext::SetParams(int key, uint32_t value) {
                             "ERR_BROTLI_PARAM_SET_FAILED",
                             -1);
   } else {
+    if (parallel_) {
+      parallel_->SetParameter(static_cast<BrotliEncoderParameter>(key),
+                              value);
+    }
     return CompressionError {};
   }
 }
@@ -1174,6 +2284,89 @@ CompressionError BrotliEncoderContext::GetErrorInfo() const {
 }
 
 
+constexpr size_t kBrotliBlockSize = 1024 * 1024;
+
+ParallelBrotliEncoder::ParallelBrotliEncoder(MultiIsolatePlatform* platform,
+                                             uint32_t parallelism,
+                                             brotli_alloc_func alloc,
+                                             brotli_free_func free,
+                                             void* opaque)
+    : ParallelCompressor(platform, parallelism, kBrotliBlockSize, 0),
+      alloc_(alloc),
+      free_(free),
+      opaque_(opaque) {}
+
+
+bool ParallelBrotliEncoder::Compress(BrotliEncoderOperation op,
+                                     size_t* avail_in,
+                                     const uint8_t** next_in,
+                                     size_t* avail_out,
+                                     uint8_t** next_out) {
+  Flush flush;
+  switch (op) {
+    case BROTLI_OPERATION_PROCESS:
+      flush = kNoFlush;
+      break;
+    case BROTLI_OPERATION_FLUSH:
+      flush = kFlush;
+      break;
+    case BROTLI_OPERATION_FINISH:
+      flush = kFinish;
+      break;
+    default:
+      // Metadata would have to go in between two blocks.
+      return false;
+  }
+  return Process(flush, next_in, avail_in, next_out, avail_out);
+}
+
+
+bool ParallelBrotliEncoder::CompressBlock(size_t slot, Block* block) {
+  DeleteFnPtr<BrotliEncoderState, BrotliEncoderDestroyInstance> state(
+      BrotliEncoderCreateInstance(alloc_, free_, opaque_));
+  if (!state)
+    return false;
+  for (const auto& param : params_) {
+    if (!BrotliEncoderSetParameter(state.get(), param.first, param.second))
+      return false;
+  }
+  // Past the first block, this leaves out the stream header and keeps the
+  // encoder from using distances that would reach before the stream start.
+  // Larger offsets than 2^30 are not allowed, but all have the same effect.
+  const uint32_t offset =
+      static_cast<uint32_t>(std::min<uint64_t>(block->offset, 1 << 30));
+  if (!BrotliEncoderSetParameter(state.get(),
+                                 BROTLI_PARAM_STREAM_OFFSET,
+                                 offset)) {
+    return false;
+  }
+
+  const BrotliEncoderOperation op =
+      block->last ? BROTLI_OPERATION_FINISH : BROTLI_OPERATION_FLUSH;
+  const uint8_t* next_in = block->data;
+  size_t avail_in = block->size;
+  // The encoder needs some room for output before it has consumed the whole
+  // block, so use an output buffer rather than BrotliEncoderTakeOutput().
+  block->out.resize(std::max<size_t>(
+      BrotliEncoderMaxCompressedSize(block->size), 64 * 1024));
+  size_t used = 0;
+  do {
+    if (used == block->out.size())
+      block->out.resize(2 * used);
+    uint8_t* next_out = block->out.data() + used;
+    size_t avail_out = block->out.size() - used;
+    if (!BrotliEncoderCompressStream(state.get(), op, &avail_in, &next_in,
+                                     &avail_out, &next_out, nullptr)) {
+      return false;
+    }
+    used = block->out.size() - avail_out;
+  } while (avail_in > 0 || BrotliEncoderHasMoreOutput(state.get()) ||
+           (block->last && !BrotliEncoderIsFinished(state.get())));
+  block->out.resize(used);
+  return true;
+}
+
+
 void BrotliDecoderContext::Close() {
   state_.reset();
   mode_ = NONE;
@@ -1256,6 +2449,7 @@ struct MakeClass {
 
     env->SetProtoMethod(z, "write", Stream::template Write<true>);
     env->SetProtoMethod(z, "writeSync", Stream::template Write<false>);
+    env->SetProtoMethod(z, "writeBatch", Stream::WriteBatch);
     env->SetProtoMethod(z, "close", Stream::Close);
 
     env->SetProtoMethod(z, "init", Stream::Init);
@@ -1280,6 +2474,20 @@ void Initialize(Local<Object> target,
   MakeClass<BrotliEncoderStream>::Make(env, target, "BrotliEncoder");
   MakeClass<BrotliDecoderStream>::Make(env, target, "BrotliDecoder");
 
+  Local<FunctionTemplate> dictionary =
+      env->NewFunctionTemplate(ZlibDictionary::New);
+  dictionary->InstanceTemplate()->SetInternalFieldCount(
+      ZlibDictionary::kInternalFieldCount);
+  dictionary->Inherit(BaseObject::GetConstructorTemplate(env));
+  Local<String> dictionary_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "ZlibDictionary");
+  dictionary->SetClassName(dictionary_string);
+  env->set_zlib_dictionary_constructor_template(dictionary);
+  target->Set(env->context(),
+              dictionary_string,
+              dictionary->GetFunction(env->context()).ToLocalChecked())
+      .Check();
+
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
               FIXED_ONE_BYTE_STRING(env->isolate(), ZLIB_VERSION)).Check();
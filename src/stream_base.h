@@ -270,6 +270,10 @@ class StreamResource {
   // transfer ownership back to the previous listener.
   inline void RemoveStreamListener(StreamListener* listener);
 
+  // Count data that was written to the underlying resource without going
+  // through DoWrite(), e.g. with sendfile(2).
+  void AddBytesWritten(uint64_t bytes) { bytes_written_ += bytes; }
+
  protected:
   // Call the current listener's OnStreamAlloc() method.
   inline uv_buf_t EmitAlloc(size_t suggested_size);
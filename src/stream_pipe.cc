@@ -1,9 +1,17 @@
 #include "stream_pipe.h"
 #include "allocated_buffer-inl.h"
 #include "stream_base-inl.h"
+#include "stream_wrap.h"
 #include "node_buffer.h"
+#include "node_file.h"
 #include "util-inl.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
 namespace node {
 
 using v8::Context;
@@ -60,6 +68,10 @@ void StreamPipe::Unpipe(bool is_in_deletion) {
   if (is_closed_)
     return;
 
+#ifdef __linux__
+  StopSendfile();
+#endif
+
   // Note that we possibly cannot use virtual methods on `source` and `sink`
   // here, because this function can be called from their destructors via
   // `OnStreamDestroy()`.
@@ -139,7 +151,8 @@ void StreamPipe::ReadableListener::OnStreamRead(ssize_t nread,
     // If we’re not writing, close now. Otherwise, we’ll do that in
     // `OnStreamAfterWrite()`.
     if (pipe->pending_writes_ == 0) {
-      sink->Shutdown();
+      if (pipe->shutdown_sink_on_eof_)
+        sink->Shutdown();
       pipe->Unpipe();
     }
     return;
@@ -153,6 +166,7 @@ void StreamPipe::ProcessData(size_t nread, AllocatedBuffer&& buf) {
   uv_buf_t buffer = uv_buf_init(buf.data(), nread);
   StreamWriteResult res = sink()->Write(&buffer, 1);
   pending_writes_++;
+  bytes_piped_ += nread;
   if (!res.async) {
     writable_listener_.OnStreamAfterWrite(nullptr, res.err);
   } else {
@@ -163,6 +177,176 @@ void StreamPipe::ProcessData(size_t nread, AllocatedBuffer&& buf) {
   }
 }
 
+#ifdef __linux__
+class StreamPipe::SendfilePoll {
+ public:
+  SendfilePoll(StreamPipe* pipe, int fd) : pipe_(pipe), fd_(fd) {}
+
+  int Start(uv_loop_t* loop) {
+    int err = uv_poll_init(loop, &handle_, fd_);
+    if (err != 0)
+      return err;
+    return uv_poll_start(&handle_, UV_WRITABLE, OnPoll);
+  }
+
+  // Closes the poll handle and the duplicated fd, then deletes this object.
+  void Close(Environment* env) {
+    pipe_ = nullptr;
+    env->CloseHandle(&handle_, [](uv_poll_t* handle) {
+      SendfilePoll* self = ContainerOf(&SendfilePoll::handle_, handle);
+      CHECK_EQ(close(self->fd_), 0);
+      delete self;
+    });
+  }
+
+ private:
+  static void OnPoll(uv_poll_t* handle, int status, int events) {
+    SendfilePoll* self = ContainerOf(&SendfilePoll::handle_, handle);
+    StreamPipe* pipe = self->pipe_;
+    if (pipe == nullptr)
+      return;
+
+    Environment* env = pipe->env();
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    InternalCallbackScope callback_scope(pipe);
+    if (status < 0) {
+      pipe->StopSendfile();
+      pipe->readable_listener_.OnStreamRead(status, uv_buf_init(nullptr, 0));
+      return;
+    }
+    pipe->PumpSendfile();
+  }
+
+  StreamPipe* pipe_;
+  int fd_;
+  uv_poll_t handle_;
+};
+
+bool StreamPipe::CanSendfile() {
+  // Data moved by the kernel is invisible to the recorder.
+  if (v8::recordreplay::IsRecordingOrReplaying())
+    return false;
+  if (source()->GetAsyncWrap()->provider_type() !=
+          AsyncWrap::PROVIDER_FILEHANDLE) {
+    return false;
+  }
+  AsyncWrap::ProviderType sink_type = sink()->GetAsyncWrap()->provider_type();
+  if (sink_type != AsyncWrap::PROVIDER_TCPWRAP &&
+      sink_type != AsyncWrap::PROVIDER_PIPEWRAP) {
+    return false;
+  }
+  // Writes that are still queued have to go out first.
+  return !static_cast<LibuvStreamWrap*>(sink())->has_pending_writes();
+}
+
+void StreamPipe::StartSendfile() {
+  fs::FileHandle* file = static_cast<fs::FileHandle*>(source());
+  LibuvStreamWrap* stream = static_cast<LibuvStreamWrap*>(sink());
+
+  uv_os_fd_t out_fd;
+  int poll_fd = -1;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(stream->stream()),
+                &out_fd) == 0) {
+    poll_fd = fcntl(out_fd, F_DUPFD_CLOEXEC, 0);
+  }
+  if (poll_fd < 0) {
+    writable_listener_.OnStreamWantsWrite(65536);
+    return;
+  }
+
+  sendfile_poll_ = new SendfilePoll(this, poll_fd);
+  if (sendfile_poll_->Start(env()->event_loop()) != 0) {
+    delete sendfile_poll_;
+    sendfile_poll_ = nullptr;
+    CHECK_EQ(close(poll_fd), 0);
+    writable_listener_.OnStreamWantsWrite(65536);
+    return;
+  }
+
+  // The first PumpSendfile() call happens from the poll callback, so that
+  // nothing is reported back to JS synchronously from start().
+  sendfile_in_fd_ = file->GetFD();
+  sendfile_out_fd_ = out_fd;
+  sendfile_offset_ = file->read_offset();
+  sendfile_remaining_ = file->read_length();
+  is_reading_ = true;
+}
+
+void StreamPipe::PumpSendfile() {
+  // Bound the work done per loop iteration so that a fast consumer does not
+  // starve other handles. The poll handle fires again right away if the
+  // socket still has room.
+  static constexpr size_t kChunkSize = 1024 * 1024;
+  static constexpr int kMaxChunksPerPump = 8;
+
+  bool eof = sendfile_remaining_ == 0;
+  for (int i = 0; i < kMaxChunksPerPump && !eof; i++) {
+    size_t count = kChunkSize;
+    if (sendfile_remaining_ > 0 &&
+        static_cast<uint64_t>(sendfile_remaining_) < count) {
+      count = sendfile_remaining_;
+    }
+
+    off_t offset = sendfile_offset_;
+    ssize_t sent;
+    do {
+      sent = sendfile(sendfile_out_fd_,
+                      sendfile_in_fd_,
+                      sendfile_offset_ >= 0 ? &offset : nullptr,
+                      count);
+    } while (sent == -1 && errno == EINTR);
+
+    if (sent == 0) {
+      eof = true;
+      break;
+    }
+
+    if (sent < 0) {
+      int err = errno;
+      if (err == EAGAIN || err == EWOULDBLOCK)
+        return;
+
+      StopSendfile();
+      if (!sendfile_has_sent_ && (err == EINVAL || err == ENOSYS)) {
+        // The file does not support sendfile(), e.g. because it is not a
+        // regular file. Fall back to reading it into buffers.
+        writable_listener_.OnStreamWantsWrite(65536);
+        return;
+      }
+      readable_listener_.OnStreamRead(-err, uv_buf_init(nullptr, 0));
+      return;
+    }
+
+    sendfile_has_sent_ = true;
+    bytes_piped_ += sent;
+    sink()->AddBytesWritten(sent);
+    if (sendfile_offset_ >= 0)
+      sendfile_offset_ += sent;
+    if (sendfile_remaining_ > 0) {
+      sendfile_remaining_ -= sent;
+      eof = sendfile_remaining_ == 0;
+    }
+  }
+
+  if (!eof)
+    return;
+
+  StopSendfile();
+  readable_listener_.OnStreamRead(UV_EOF, uv_buf_init(nullptr, 0));
+}
+
+void StreamPipe::StopSendfile() {
+  if (sendfile_poll_ == nullptr)
+    return;
+  sendfile_poll_->Close(env());
+  sendfile_poll_ = nullptr;
+  sendfile_in_fd_ = -1;
+  sendfile_out_fd_ = -1;
+  is_reading_ = false;
+}
+#endif  // __linux__
+
 void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
                                                       int status) {
   v8::recordreplay::Assert("StreamPipe::WritableListener::OnStreamAfterWrite");
@@ -184,7 +368,8 @@ void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
     HandleScope handle_scope(pipe->env()->isolate());
     InternalCallbackScope callback_scope(pipe,
         InternalCallbackScope::kSkipTaskQueues);
-    pipe->sink()->Shutdown();
+    if (pipe->shutdown_sink_on_eof_)
+      pipe->sink()->Shutdown();
     pipe->Unpipe();
     return;
   }
@@ -264,6 +449,14 @@ void StreamPipe::Start(const FunctionCallbackInfo<Value>& args) {
   StreamPipe* pipe;
   ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
   pipe->is_closed_ = false;
+  if (args[0]->IsFalse())
+    pipe->shutdown_sink_on_eof_ = false;
+#ifdef __linux__
+  if (pipe->CanSendfile()) {
+    pipe->StartSendfile();
+    return;
+  }
+#endif
   pipe->writable_listener_.OnStreamWantsWrite(65536);
 }
 
@@ -285,6 +478,12 @@ void StreamPipe::PendingWrites(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(pipe->pending_writes_);
 }
 
+void StreamPipe::BytesPiped(const FunctionCallbackInfo<Value>& args) {
+  StreamPipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(pipe->bytes_piped_));
+}
+
 namespace {
 
 void InitializeStreamPipe(Local<Object> target,
@@ -301,6 +500,7 @@ void InitializeStreamPipe(Local<Object> target,
   env->SetProtoMethod(pipe, "start", StreamPipe::Start);
   env->SetProtoMethod(pipe, "isClosed", StreamPipe::IsClosed);
   env->SetProtoMethod(pipe, "pendingWrites", StreamPipe::PendingWrites);
+  env->SetProtoMethod(pipe, "bytesPiped", StreamPipe::BytesPiped);
   pipe->Inherit(AsyncWrap::GetConstructorTemplate(env));
   pipe->SetClassName(stream_pipe_string);
   pipe->InstanceTemplate()->SetInternalFieldCount(
@@ -20,6 +20,7 @@ class StreamPipe : public AsyncWrap {
   static void Unpipe(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void IsClosed(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void PendingWrites(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void BytesPiped(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(StreamPipe)
@@ -30,12 +31,17 @@ class StreamPipe : public AsyncWrap {
   inline StreamBase* sink();
 
   int pending_writes_ = 0;
+  // The number of bytes that were handed to the sink so far.
+  uint64_t bytes_piped_ = 0;
   bool is_reading_ = false;
   bool is_eof_ = false;
   bool is_closed_ = true;
   bool sink_destroyed_ = false;
   bool source_destroyed_ = false;
   bool uses_wants_write_ = false;
+  // Whether the sink is shut down once the source has ended. JS callers that
+  // end the sink themselves turn this off.
+  bool shutdown_sink_on_eof_ = true;
 
   // Set a default value so that when we’re coming from Start(), we know
   // that we don’t want to read just yet.
@@ -45,6 +51,26 @@ class StreamPipe : public AsyncWrap {
 
   void ProcessData(size_t nread, AllocatedBuffer&& buf);
 
+#ifdef __linux__
+  // When a FileHandle is piped into a TCP or pipe handle, the data is moved
+  // with sendfile(2) on the event loop and never copied into a buffer. A
+  // dup() of the socket is polled for writability whenever sendfile()
+  // returns EAGAIN, because the sink's own fd is already watched by libuv.
+  class SendfilePoll;
+
+  bool CanSendfile();
+  void StartSendfile();
+  void PumpSendfile();
+  void StopSendfile();
+
+  int sendfile_in_fd_ = -1;
+  int sendfile_out_fd_ = -1;
+  int64_t sendfile_offset_ = -1;
+  int64_t sendfile_remaining_ = -1;
+  bool sendfile_has_sent_ = false;
+  SendfilePoll* sendfile_poll_ = nullptr;
+#endif
+
   class ReadableListener : public StreamListener {
    public:
     uv_buf_t OnStreamAlloc(size_t suggested_size) override;
@@ -33,6 +33,8 @@
 
 #include <cstring>  // memcpy()
 #include <climits>  // INT_MAX
+#include <deque>
+#include <vector>
 
 
 namespace node {
@@ -150,6 +152,7 @@ Local<FunctionTemplate> LibuvStreamWrap::GetConstructorTemplate(
         Local<FunctionTemplate>(),
         static_cast<PropertyAttribute>(ReadOnly | DontDelete));
     env->SetProtoMethod(tmpl, "setBlocking", SetBlocking);
+    env->SetProtoMethod(tmpl, "setWriteCoalescing", SetWriteCoalescing);
     StreamBase::AddMethods(env, tmpl);
     env->set_libuv_stream_wrap_ctor_template(tmpl);
   }
@@ -294,7 +297,8 @@ void LibuvStreamWrap::GetWriteQueueSize(
     return;
   }
 
-  uint32_t write_queue_size = wrap->stream()->write_queue_size;
+  uint32_t write_queue_size =
+      wrap->stream()->write_queue_size + wrap->coalesced_bytes_;
   info.GetReturnValue().Set(write_queue_size);
 }
 
@@ -311,6 +315,24 @@ void LibuvStreamWrap::SetBlocking(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(uv_stream_set_blocking(wrap->stream(), enable));
 }
 
+
+void LibuvStreamWrap::SetWriteCoalescing(
+    const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK_GT(args.Length(), 0);
+  wrap->SetWriteCoalescing(args[0]->IsTrue());
+}
+
+
+void LibuvStreamWrap::SetWriteCoalescing(bool enable) {
+  coalesce_writes_ = enable;
+  // Writes that are already held back must not be overtaken by new ones.
+  if (!enable)
+    FlushCoalescedWrites();
+}
+
 typedef SimpleShutdownWrap<ReqWrap<uv_shutdown_t>> LibuvShutdownWrap;
 typedef SimpleWriteWrap<ReqWrap<uv_write_t>> LibuvWriteWrap;
 
@@ -325,6 +347,8 @@ WriteWrap* LibuvStreamWrap::CreateWriteWrap(Local<Object> object) {
 
 int LibuvStreamWrap::DoShutdown(ShutdownWrap* req_wrap_) {
   LibuvShutdownWrap* req_wrap = static_cast<LibuvShutdownWrap*>(req_wrap_);
+  // libuv only shuts the stream down after the writes it already knows of.
+  FlushCoalescedWrites();
   return req_wrap->Dispatch(uv_shutdown, stream(), AfterUvShutdown);
 }
 
@@ -349,6 +373,10 @@ int LibuvStreamWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
   uv_buf_t* vbufs = *bufs;
   size_t vcount = *count;
 
+  // Leave the data untouched so that DoWrite() adds it to the next batch.
+  if (coalesce_writes_)
+    return 0;
+
   err = uv_try_write(stream(), vbufs, vcount);
   if (err == UV_ENOSYS || err == UV_EAGAIN)
     return 0;
@@ -383,6 +411,20 @@ int LibuvStreamWrap::DoWrite(WriteWrap* req_wrap,
                              uv_buf_t* bufs,
                              size_t count,
                              uv_stream_t* send_handle) {
+  if (coalesce_writes_ && send_handle == nullptr) {
+    // The data stays owned by the write request until it is done, so only
+    // the buffer descriptors need to be kept.
+    for (size_t i = 0; i < count; i++) {
+      coalesced_bufs_.push_back(bufs[i]);
+      coalesced_bytes_ += bufs[i].len;
+    }
+    coalesced_writes_.push_back(req_wrap);
+    ScheduleCoalescedWrite();
+    return 0;
+  }
+
+  FlushCoalescedWrites();
+
   LibuvWriteWrap* w = static_cast<LibuvWriteWrap*>(req_wrap);
   return w->Dispatch(uv_write2,
                      stream(),
@@ -403,6 +445,93 @@ void LibuvStreamWrap::AfterUvWrite(uv_write_t* req, int status) {
   req_wrap->Done(status);
 }
 
+
+void LibuvStreamWrap::ScheduleCoalescedWrite() {
+  if (coalesced_write_scheduled_)
+    return;
+  coalesced_write_scheduled_ = true;
+
+  BaseObjectPtr<LibuvStreamWrap> strong_ref{this};
+  env()->SetImmediate([this, strong_ref](Environment* env) {
+    coalesced_write_scheduled_ = false;
+    FlushCoalescedWrites();
+  });
+}
+
+
+void LibuvStreamWrap::FlushCoalescedWrites() {
+  // A closing stream cancels the held back writes in OnClose().
+  if (coalesced_writes_.empty() || !IsAlive() || IsClosing())
+    return;
+
+  std::vector<WriteWrap*> writes;
+  std::vector<uv_buf_t> bufs;
+  writes.swap(coalesced_writes_);
+  bufs.swap(coalesced_bufs_);
+  coalesced_bytes_ = 0;
+
+  // The first write request carries the uv_write() for the whole batch.
+  // libuv copies the buffer descriptors, the data itself stays owned by the
+  // individual requests.
+  LibuvWriteWrap* w = static_cast<LibuvWriteWrap*>(writes[0]);
+  int err = w->Dispatch(uv_write,
+                        stream(),
+                        bufs.data(),
+                        bufs.size(),
+                        AfterCoalescedUvWrite);
+  if (err == 0) {
+    coalesced_writes_in_flight_.emplace_back(std::move(writes));
+    return;
+  }
+
+  // The write requests were reported as started, so they fail
+  // asynchronously, like a uv_write() that fails later on. This may be
+  // called from DoWrite() or DoShutdown(), where Done() must not be called.
+  BaseObjectPtr<LibuvStreamWrap> strong_ref{this};
+  env()->SetImmediate(
+      [writes = std::move(writes), err, strong_ref](Environment* env) {
+        HandleScope scope(env->isolate());
+        Context::Scope context_scope(env->context());
+        for (WriteWrap* req_wrap : writes)
+          req_wrap->Done(err);
+      });
+}
+
+
+void LibuvStreamWrap::AfterCoalescedUvWrite(uv_write_t* req, int status) {
+  LibuvWriteWrap* req_wrap = static_cast<LibuvWriteWrap*>(
+      LibuvWriteWrap::from_req(req));
+  CHECK_NOT_NULL(req_wrap);
+  LibuvStreamWrap* wrap = static_cast<LibuvStreamWrap*>(req_wrap->stream());
+  // libuv completes the writes of a stream in order.
+  std::vector<WriteWrap*> writes =
+      std::move(wrap->coalesced_writes_in_flight_.front());
+  wrap->coalesced_writes_in_flight_.pop_front();
+  CHECK_EQ(writes[0], req_wrap);
+
+  HandleScope scope(req_wrap->env()->isolate());
+  Context::Scope context_scope(req_wrap->env()->context());
+  for (WriteWrap* w : writes)
+    w->Done(status);
+}
+
+
+void LibuvStreamWrap::CancelCoalescedWrites(int status) {
+  std::vector<WriteWrap*> writes;
+  writes.swap(coalesced_writes_);
+  coalesced_bufs_.clear();
+  coalesced_bytes_ = 0;
+  for (WriteWrap* req_wrap : writes)
+    req_wrap->Done(status);
+}
+
+
+void LibuvStreamWrap::OnClose() {
+  // libuv cancels the writes it holds before the close callback runs; do
+  // the same for the ones that never reached it.
+  CancelCoalescedWrites(UV_ECANCELED);
+}
+
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(stream_wrap,
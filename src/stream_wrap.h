@@ -28,6 +28,9 @@
 #include "handle_wrap.h"
 #include "v8.h"
 
+#include <deque>
+#include <vector>
+
 namespace node {
 
 class Environment;
@@ -73,6 +76,18 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
     return stream()->type == UV_TCP;
   }
 
+  // True if libuv still holds data for this stream, or if writes are being
+  // held back for coalescing.
+  inline bool has_pending_writes() const {
+    return stream()->write_queue_size != 0 || !coalesced_writes_.empty();
+  }
+
+  // While write coalescing is enabled, writes are not passed to libuv
+  // right away. They are collected until the current turn of the event loop
+  // is done with JavaScript and then written out with a single uv_write().
+  // Each write request still completes individually.
+  void SetWriteCoalescing(bool enable);
+
   ShutdownWrap* CreateShutdownWrap(v8::Local<v8::Object> object) override;
   WriteWrap* CreateWriteWrap(v8::Local<v8::Object> object) override;
 
@@ -85,6 +100,7 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
                   AsyncWrap::ProviderType provider);
 
   AsyncWrap* GetAsyncWrap() override;
+  void OnClose() override;
 
   static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
       Environment* env);
@@ -101,6 +117,12 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
   static void SetBlocking(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetWriteCoalescing(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  void ScheduleCoalescedWrite();
+  void FlushCoalescedWrites();
+  void CancelCoalescedWrites(int status);
 
   // Callbacks for libuv
   void OnUvAlloc(size_t suggested_size, uv_buf_t* buf);
@@ -108,9 +130,19 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
 
   static void AfterUvWrite(uv_write_t* req, int status);
   static void AfterUvShutdown(uv_shutdown_t* req, int status);
+  static void AfterCoalescedUvWrite(uv_write_t* req, int status);
 
   uv_stream_t* const stream_;
 
+  bool coalesce_writes_ = false;
+  bool coalesced_write_scheduled_ = false;
+  size_t coalesced_bytes_ = 0;
+  std::vector<WriteWrap*> coalesced_writes_;
+  std::vector<uv_buf_t> coalesced_bufs_;
+  // The write requests of each uv_write() that carries a batch, oldest
+  // first.
+  std::deque<std::vector<WriteWrap*>> coalesced_writes_in_flight_;
+
 #ifdef _WIN32
   // We don't always have an FD that we could look up on the stream_
   // object itself on Windows. However, for some cases, we open handles
@@ -22,6 +22,7 @@
 #include "string_bytes.h"
 
 #include "base64-inl.h"
+#include "node_simd.h"
 #include "env-inl.h"
 #include "node_buffer.h"
 #include "node_errors.h"
@@ -243,13 +244,31 @@ static inline unsigned unhex(uint8_t x) {
   return unhex_table[x];
 }
 
+// Only one-byte input has vectorized kernels.
+static inline size_t hex_decode_simd(char* buf,
+                                     size_t len,
+                                     const char* src,
+                                     const size_t srcLen) {
+  return simd::HexDecode(buf, len, src, srcLen);
+}
+
+template <typename TypeName>
+static inline size_t hex_decode_simd(char* buf,
+                                     size_t len,
+                                     const TypeName* src,
+                                     const size_t srcLen) {
+  return 0;
+}
+
 template <typename TypeName>
 static size_t hex_decode(char* buf,
                          size_t len,
                          const TypeName* src,
                          const size_t srcLen) {
   size_t i;
-  for (i = 0; i < len && i * 2 + 1 < srcLen; ++i) {
+  for (i = hex_decode_simd(buf, len, src, srcLen);
+       i < len && i * 2 + 1 < srcLen;
+       ++i) {
     unsigned a = unhex(src[i * 2 + 0]);
     unsigned b = unhex(src[i * 2 + 1]);
     if (!~a || !~b)
@@ -303,6 +322,53 @@ size_t StringBytes::WriteUCS2(Isolate* isolate,
 }
 
 
+// One-byte strings are Latin-1, which only needs V8's UTF-8 encoder for
+// partial writes.
+size_t StringBytes::WriteUtf8(Isolate* isolate,
+                              char* buf,
+                              size_t buflen,
+                              Local<String> str,
+                              int flags,
+                              int* chars_written) {
+  if (str->IsOneByte()) {
+    const char* data;
+    size_t length;
+    MaybeStackBuffer<char> latin1;
+    if (str->IsExternalOneByte()) {
+      auto ext = str->GetExternalOneByteStringResource();
+      data = ext->data();
+      length = ext->length();
+    } else {
+      // Most strings are ASCII, which is the same in UTF-8, so try to write
+      // them to the destination right away.
+      length = str->WriteOneByte(isolate,
+                                 reinterpret_cast<uint8_t*>(buf),
+                                 0,
+                                 buflen,
+                                 flags);
+      if (simd::IsAscii(buf, length)) {
+        *chars_written = length;
+        return length;
+      }
+      if (length == static_cast<size_t>(str->Length())) {
+        latin1.AllocateSufficientStorage(length);
+        memcpy(latin1.out(), buf, length);
+        data = latin1.out();
+      } else {
+        data = nullptr;
+      }
+    }
+
+    if (data != nullptr && simd::Latin1Utf8Length(data, length) <= buflen) {
+      *chars_written = length;
+      return simd::Latin1ToUtf8(data, length, buf);
+    }
+  }
+
+  return str->WriteUtf8(isolate, buf, buflen, chars_written, flags);
+}
+
+
 size_t StringBytes::Write(Isolate* isolate,
                           char* buf,
                           size_t buflen,
@@ -339,7 +405,7 @@ size_t StringBytes::Write(Isolate* isolate,
 
     case BUFFER:
     case UTF8:
-      nbytes = str->WriteUtf8(isolate, buf, buflen, chars_written, flags);
+      nbytes = WriteUtf8(isolate, buf, buflen, str, flags, chars_written);
       break;
 
     case UCS2: {
@@ -364,6 +430,14 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = base64_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        MaybeStackBuffer<char> value(str->Length());
+        str->WriteOneByte(isolate,
+                          reinterpret_cast<uint8_t*>(value.out()),
+                          0,
+                          value.length(),
+                          flags);
+        nbytes = base64_decode(buf, buflen, value.out(), value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = base64_decode(buf, buflen, *value, value.length());
@@ -375,6 +449,14 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = hex_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        MaybeStackBuffer<char> value(str->Length());
+        str->WriteOneByte(isolate,
+                          reinterpret_cast<uint8_t*>(value.out()),
+                          0,
+                          value.length(),
+                          flags);
+        nbytes = hex_decode(buf, buflen, value.out(), value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = hex_decode(buf, buflen, *value, value.length());
@@ -487,54 +569,8 @@ Maybe<size_t> StringBytes::Size(Isolate* isolate,
 
 
 
-static bool contains_non_ascii_slow(const char* buf, size_t len) {
-  for (size_t i = 0; i < len; ++i) {
-    if (buf[i] & 0x80)
-      return true;
-  }
-  return false;
-}
-
-
 static bool contains_non_ascii(const char* src, size_t len) {
-  if (len < 16) {
-    return contains_non_ascii_slow(src, len);
-  }
-
-  const unsigned bytes_per_word = sizeof(uintptr_t);
-  const unsigned align_mask = bytes_per_word - 1;
-  const unsigned unaligned = reinterpret_cast<uintptr_t>(src) & align_mask;
-
-  if (unaligned > 0) {
-    const unsigned n = bytes_per_word - unaligned;
-    if (contains_non_ascii_slow(src, n))
-      return true;
-    src += n;
-    len -= n;
-  }
-
-
-#if defined(_WIN64) || defined(_LP64)
-  const uintptr_t mask = 0x8080808080808080ll;
-#else
-  const uintptr_t mask = 0x80808080l;
-#endif
-
-  const uintptr_t* srcw = reinterpret_cast<const uintptr_t*>(src);
-
-  for (size_t i = 0, n = len / bytes_per_word; i < n; ++i) {
-    if (srcw[i] & mask)
-      return true;
-  }
-
-  const unsigned remainder = len & align_mask;
-  if (remainder > 0) {
-    const size_t offset = len - remainder;
-    if (contains_non_ascii_slow(src + offset, remainder))
-      return true;
-  }
-
-  return false;
+  return !simd::IsAscii(src, len);
 }
 
 
@@ -600,7 +636,8 @@ size_t StringBytes::hex_encode(
       "not enough space provided for hex encode");
 
   dlen = slen * 2;
-  for (uint32_t i = 0, k = 0; k < dlen; i += 1, k += 2) {
+  const size_t done = simd::HexEncode(src, slen, dst);
+  for (size_t i = done, k = done * 2; k < dlen; i += 1, k += 2) {
     static const char hex[] = "0123456789abcdef";
     uint8_t val = static_cast<uint8_t>(src[i]);
     dst[k + 0] = hex[val >> 4];
@@ -669,6 +706,11 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 
     case UTF8:
       {
+        // Invalid input is left to V8, which replaces the invalid sequences.
+        MaybeLocal<Value> valid = EncodeValidUtf8(isolate, buf, buflen, error);
+        if (!valid.IsEmpty() || !error->IsEmpty())
+          return valid;
+
         val = String::NewFromUtf8(isolate,
                                   buf,
                                   v8::NewStringType::kNormal,
@@ -764,6 +806,63 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 }
 
 
+MaybeLocal<Value> StringBytes::EncodeValidUtf8(Isolate* isolate,
+                                               const char* buf,
+                                               size_t buflen,
+                                               Local<Value>* error) {
+  CHECK_BUFLEN_IN_RANGE(buflen);
+
+  uint8_t max_byte;
+  if (!simd::ValidateUtf8(buf, buflen, &max_byte))
+    return MaybeLocal<Value>();
+
+  if (max_byte < 0x80)
+    return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
+
+  // Use a one-byte string if all characters fit into Latin-1.
+  if (max_byte < 0xc4) {
+    // Short strings are copied onto the V8 heap, so transcode the ones that
+    // fit on the stack there rather than in a temporary allocation. Anything
+    // larger goes through UncheckedMalloc(), so that running out of memory
+    // is reported instead of aborting.
+    MaybeStackBuffer<char, 1024> stack_dst;
+    if (buflen <= stack_dst.capacity()) {
+      size_t length = simd::Utf8ToLatin1(buf, buflen, *stack_dst);
+      return ExternOneByteString::NewFromCopy(
+          isolate, *stack_dst, length, error);
+    }
+    char* dst = node::UncheckedMalloc(buflen);
+    if (dst == nullptr) {
+      *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
+      return MaybeLocal<Value>();
+    }
+    size_t length = simd::Utf8ToLatin1(buf, buflen, dst);
+    return ExternOneByteString::New(isolate, dst, length, error);
+  }
+
+  // There are never more UTF-16 code units than UTF-8 bytes.
+  MaybeStackBuffer<uint16_t, 512> stack_dst;
+  if (buflen <= stack_dst.capacity()) {
+    size_t length = simd::Utf8ToUtf16(buf, buflen, *stack_dst);
+    return ExternTwoByteString::NewFromCopy(
+        isolate, *stack_dst, length, error);
+  }
+  uint16_t* dst = node::UncheckedMalloc<uint16_t>(buflen);
+  if (dst == nullptr) {
+    *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
+    return MaybeLocal<Value>();
+  }
+  size_t length = simd::Utf8ToUtf16(buf, buflen, dst);
+  if (length >= EXTERN_APEX && length < buflen) {
+    // The buffer is kept by the external string, so do not waste the rest.
+    uint16_t* shrunk = node::UncheckedRealloc(dst, length);
+    if (shrunk != nullptr)
+      dst = shrunk;
+  }
+  return ExternTwoByteString::New(isolate, dst, length, error);
+}
+
+
 MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
                                       const uint16_t* buf,
                                       size_t buflen,
@@ -85,6 +85,14 @@ class StringBytes {
                                           enum encoding encoding,
                                           v8::Local<v8::Value>* error);
 
+  // Like Encode() with UTF8, but only for valid UTF-8. If `buf` is not valid
+  // UTF-8, returns an empty handle without setting `error`.
+  static v8::MaybeLocal<v8::Value> EncodeValidUtf8(
+      v8::Isolate* isolate,
+      const char* buf,
+      size_t buflen,
+      v8::Local<v8::Value>* error);
+
   // Warning: This reverses endianness on BE platforms, even though the
   // signature using uint16_t implies that it should not.
   // However, the brokenness is already public API and can't therefore
@@ -107,6 +115,13 @@ class StringBytes {
   static std::string hex_encode(const char* src, size_t slen);
 
  private:
+  static size_t WriteUtf8(v8::Isolate* isolate,
+                          char* buf,
+                          size_t buflen,
+                          v8::Local<v8::String> str,
+                          int flags,
+                          int* chars_written);
+
   static size_t WriteUCS2(v8::Isolate* isolate,
                           char* buf,
                           size_t buflen,
@@ -28,21 +28,12 @@ MaybeLocal<String> MakeString(Isolate* isolate,
                               size_t length,
                               enum encoding encoding) {
   Local<Value> error;
-  MaybeLocal<Value> ret;
-  if (encoding == UTF8) {
-    return String::NewFromUtf8(
-        isolate,
-        data,
-        v8::NewStringType::kNormal,
-        length);
-  } else {
-    ret = StringBytes::Encode(
-        isolate,
-        data,
-        length,
-        encoding,
-        &error);
-  }
+  MaybeLocal<Value> ret = StringBytes::Encode(
+      isolate,
+      data,
+      length,
+      encoding,
+      &error);
 
   if (ret.IsEmpty()) {
     CHECK(!error.IsEmpty());
@@ -59,15 +50,21 @@ MaybeLocal<String> MakeString(Isolate* isolate,
 MaybeLocal<String> StringDecoder::DecodeData(Isolate* isolate,
                                              const char* data,
                                              size_t* nread_ptr) {
-  Local<String> prepend, body;
+  // The bytes of a character from the previous chunk that this chunk
+  // completes. They are decoded together with the rest of the chunk, so that
+  // only one string needs to be created.
+  char prefix[kIncompleteCharactersEnd];
+  size_t prefix_length = 0;
 
   size_t nread = *nread_ptr;
 
-  if (Encoding() == UTF8 || Encoding() == UCS2 || Encoding() == BASE64) {
+  if (Encoding() == UTF8 ||
+      Encoding() == UCS2 ||
+      Encoding() == BASE64 ||
+      Encoding() == BASE64URL) {
     // See if we want bytes to finish a character from the previous
     // chunk; if so, copy the new bytes to the missing bytes buffer
-    // and create a small string from it that is to be prepended to the
-    // main body.
+    // and set the finished character aside to be prepended to the main body.
     if (MissingBytes() > 0) {
       // There are never more bytes missing than the pre-calculated maximum.
       CHECK_LE(MissingBytes() + BufferedBytes(),
@@ -105,14 +102,10 @@ MaybeLocal<String> StringDecoder::DecodeData(Isolate* isolate,
       state_[kBufferedBytes] += found_bytes;
 
       if (LIKELY(MissingBytes() == 0)) {
-        // If no more bytes are missing, create a small string that we
-        // will later prepend.
-        if (!MakeString(isolate,
-                        IncompleteCharacterBuffer(),
-                        BufferedBytes(),
-                        Encoding()).ToLocal(&prepend)) {
-          return MaybeLocal<String>();
-        }
+        // If no more bytes are missing, keep the character that we will
+        // later prepend.
+        prefix_length = BufferedBytes();
+        memcpy(prefix, IncompleteCharacterBuffer(), prefix_length);
 
         *nread_ptr += BufferedBytes();
         // No more buffered bytes.
@@ -123,8 +116,9 @@ MaybeLocal<String> StringDecoder::DecodeData(Isolate* isolate,
     // It could be that trying to finish the previous chunk already
     // consumed all data that we received in this chunk.
     if (UNLIKELY(nread == 0)) {
-      body = !prepend.IsEmpty() ? prepend : String::Empty(isolate);
-      prepend = Local<String>();
+      if (prefix_length == 0)
+        return String::Empty(isolate);
+      return MakeString(isolate, prefix, prefix_length, Encoding());
     } else {
       // If not, that means is no character left to finish at this point.
       DCHECK_EQ(MissingBytes(), 0);
@@ -191,7 +185,7 @@ MaybeLocal<String> StringDecoder::DecodeData(Isolate* isolate,
           state_[kBufferedBytes] = 2;
           state_[kMissingBytes] = 2;
         }
-      } else if (Encoding() == BASE64) {
+      } else if (Encoding() == BASE64 || Encoding() == BASE64URL) {
         state_[kBufferedBytes] = nread % 3;
         if (state_[kBufferedBytes] > 0)
           state_[kMissingBytes] = 3 - BufferedBytes();
@@ -205,17 +199,30 @@ MaybeLocal<String> StringDecoder::DecodeData(Isolate* isolate,
         memcpy(IncompleteCharacterBuffer(), data + nread, BufferedBytes());
       }
 
-      if (nread > 0) {
-        if (!MakeString(isolate, data, nread, Encoding()).ToLocal(&body))
-          return MaybeLocal<String>();
-      } else {
-        body = String::Empty(isolate);
+      if (prefix_length == 0) {
+        if (nread == 0)
+          return String::Empty(isolate);
+        return MakeString(isolate, data, nread, Encoding());
       }
-    }
 
-    if (prepend.IsEmpty()) {
-      return body;
-    } else {
+      // Decoding the finished character along with the body gives the same
+      // result as decoding them one after the other: in all of these
+      // encodings, the character ends where the body's first one starts.
+      // That spares a second string and the cons string that joins them.
+      MaybeStackBuffer<char, 1024> joined;
+      if (prefix_length + nread <= joined.capacity()) {
+        memcpy(*joined, prefix, prefix_length);
+        memcpy(*joined + prefix_length, data, nread);
+        return MakeString(isolate, *joined, prefix_length + nread, Encoding());
+      }
+
+      // Copying a larger body would cost more than the strings it spares.
+      Local<String> prepend, body;
+      if (!MakeString(isolate, prefix, prefix_length, Encoding())
+               .ToLocal(&prepend) ||
+          !MakeString(isolate, data, nread, Encoding()).ToLocal(&body)) {
+        return MaybeLocal<String>();
+      }
       return String::Concat(isolate, prepend, body);
     }
   } else {
@@ -304,6 +311,7 @@ void InitializeStringDecoder(Local<Object> target,
   ADD_TO_ENCODINGS_ARRAY(ASCII, "ascii");
   ADD_TO_ENCODINGS_ARRAY(UTF8, "utf8");
   ADD_TO_ENCODINGS_ARRAY(BASE64, "base64");
+  ADD_TO_ENCODINGS_ARRAY(BASE64URL, "base64url");
   ADD_TO_ENCODINGS_ARRAY(UCS2, "utf16le");
   ADD_TO_ENCODINGS_ARRAY(HEX, "hex");
   ADD_TO_ENCODINGS_ARRAY(BUFFER, "buffer");
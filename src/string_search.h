@@ -7,6 +7,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "node_simd.h"
 #include "util.h"
 
 #include <cstring>
@@ -598,6 +599,18 @@ size_t SearchString(const Char* haystack,
                     size_t start_index,
                     bool is_forward) {
   if (haystack_length < needle_length) return haystack_length;
+  // Short byte needles are found faster by filtering candidate positions
+  // with vector compares than by the skip tables below.
+  if (sizeof(Char) == 1 && needle_length >= 2 &&
+      needle_length <= simd::kMaxFindNeedleLength &&
+      simd::GetLevel() != simd::Level::kNone) {
+    return simd::Find(reinterpret_cast<const char*>(haystack),
+                      haystack_length,
+                      reinterpret_cast<const char*>(needle),
+                      needle_length,
+                      start_index,
+                      is_forward);
+  }
   // To do a reverse search (lastIndexOf instead of indexOf) without redundant
   // code, create two vectors that are reversed views into the input strings.
   // For example, v_needle[0] would return the *last* character of the needle.
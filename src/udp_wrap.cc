@@ -110,15 +110,18 @@ void UDPWrapBase::AddMethods(Environment* env, Local<FunctionTemplate> t) {
   env->SetProtoMethod(t, "recvStop", RecvStop);
 }
 
-UDPWrap::UDPWrap(Environment* env, Local<Object> object)
+UDPWrap::UDPWrap(Environment* env,
+                 Local<Object> object,
+                 unsigned int flags)
     : HandleWrap(env,
                  object,
                  reinterpret_cast<uv_handle_t*>(&handle_),
-                 AsyncWrap::PROVIDER_UDPWRAP) {
+                 AsyncWrap::PROVIDER_UDPWRAP),
+      recv_batch_((flags & UV_UDP_RECVMMSG) != 0) {
   object->SetAlignedPointerInInternalField(
       UDPWrapBase::kUDPWrapBaseField, static_cast<UDPWrapBase*>(this));
 
-  int r = uv_udp_init(env->event_loop(), &handle_);
+  int r = uv_udp_init_ex(env->event_loop(), &handle_, AF_UNSPEC | flags);
   CHECK_EQ(r, 0);  // can't fail anyway
 
   set_listener(this);
@@ -162,6 +165,8 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "connect6", Connect6);
   env->SetProtoMethod(t, "send6", Send6);
+  env->SetProtoMethod(t, "sendBatch", SendBatch);
+  env->SetProtoMethod(t, "sendBatch6", SendBatch6);
   env->SetProtoMethod(t, "disconnect", Disconnect);
   env->SetProtoMethod(t, "getpeername",
                       GetSockOrPeerName<UDPWrap, uv_udp_getpeername>);
@@ -202,6 +207,7 @@ void UDPWrap::Initialize(Local<Object> target,
   Local<Object> constants = Object::New(env->isolate());
   NODE_DEFINE_CONSTANT(constants, UV_UDP_IPV6ONLY);
   NODE_DEFINE_CONSTANT(constants, UV_UDP_REUSEADDR);
+  NODE_DEFINE_CONSTANT(constants, UV_UDP_RECVMMSG);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -211,7 +217,10 @@ void UDPWrap::Initialize(Local<Object> target,
 void UDPWrap::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
   Environment* env = Environment::GetCurrent(args);
-  new UDPWrap(env, args.This());
+  unsigned int flags = 0;
+  if (args[0]->IsUint32())
+    flags = args[0].As<Uint32>()->Value() & UV_UDP_RECVMMSG;
+  new UDPWrap(env, args.This(), flags);
 }
 
 
@@ -551,6 +560,87 @@ void UDPWrap::DoSend(const FunctionCallbackInfo<Value>& args, int family) {
   args.GetReturnValue().Set(err);
 }
 
+// Sends every element of `list` as a datagram of its own, with as few
+// sendmmsg() calls as possible. Returns the number of datagrams that went out
+// synchronously; the JS side queues the rest through send().
+void UDPWrap::DoSendBatch(const FunctionCallbackInfo<Value>& args,
+                          int family) {
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  CHECK(args.Length() == 2 || args.Length() == 4);
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsUint32());
+
+  bool sendto = args.Length() == 4;
+  if (sendto) {
+    // sendBatch(list, list.length, port, address)
+    CHECK(args[2]->IsUint32());
+    CHECK(args[3]->IsString());
+  }
+
+  if (wrap->IsHandleClosing())
+    return args.GetReturnValue().Set(UV_EBADF);
+
+  Local<Array> datagrams = args[0].As<Array>();
+  size_t count = args[1].As<Uint32>()->Value();
+
+  if (count == 0 || UNLIKELY(env->options()->test_udp_no_try_send))
+    return args.GetReturnValue().Set(0);
+
+  struct sockaddr_storage addr_storage;
+  sockaddr* addr = nullptr;
+  if (sendto) {
+    const unsigned short port = args[2].As<Uint32>()->Value();
+    node::Utf8Value address(env->isolate(), args[3]);
+    int err = sockaddr_for_family(family, address.out(), port, &addr_storage);
+    if (err != 0)
+      return args.GetReturnValue().Set(err);
+    addr = reinterpret_cast<sockaddr*>(&addr_storage);
+  }
+
+  MaybeStackBuffer<uv_buf_t, 32> bufs(count);
+  MaybeStackBuffer<uv_buf_t*, 32> buf_ptrs(count);
+  MaybeStackBuffer<unsigned int, 32> nbufs(count);
+  MaybeStackBuffer<sockaddr*, 32> addrs(count);
+
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> datagram;
+    if (!datagrams->Get(env->context(), i).ToLocal(&datagram)) return;
+
+    bufs[i] = uv_buf_init(Buffer::Data(datagram), Buffer::Length(datagram));
+    buf_ptrs[i] = &bufs[i];
+    nbufs[i] = 1;
+    addrs[i] = addr;
+  }
+
+  size_t sent = 0;
+  while (sent < count) {
+    int err = uv_udp_try_send2(&wrap->handle_,
+                               count - sent,
+                               buf_ptrs.out() + sent,
+                               nbufs.out() + sent,
+                               addrs.out() + sent,
+                               0);
+    if (err == UV_ENOSYS || err == UV_EAGAIN)
+      break;
+    if (err < 0) {
+      // Only report the error if nothing went out yet; otherwise the
+      // datagram that failed is retried, and fails again, through send().
+      if (sent == 0)
+        return args.GetReturnValue().Set(err);
+      break;
+    }
+    sent += err;
+  }
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(sent));
+}
+
 ssize_t UDPWrap::Send(uv_buf_t* bufs_ptr,
                       size_t count,
                       const sockaddr* addr) {
@@ -628,6 +718,16 @@ void UDPWrap::Send6(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void UDPWrap::SendBatch(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET);
+}
+
+
+void UDPWrap::SendBatch6(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET6);
+}
+
+
 AsyncWrap* UDPWrap::GetAsyncWrap() {
   return this;
 }
@@ -691,6 +791,14 @@ void UDPWrap::OnAlloc(uv_handle_t* handle,
 }
 
 uv_buf_t UDPWrap::OnAlloc(size_t suggested_size) {
+  if (recv_batch_) {
+    // The slab is only handed out again once the previous batch has been
+    // copied out of it in FlushRecvBatch(), so a single one is enough.
+    constexpr size_t kSlabSize = kRecvBatchWidth * kMaxDatagramSize;
+    if (!recv_slab_)
+      recv_slab_.reset(new char[kSlabSize]);
+    return uv_buf_init(recv_slab_.get(), kSlabSize);
+  }
   return AllocatedBuffer::AllocateManaged(env(), suggested_size).release();
 }
 
@@ -707,6 +815,11 @@ void UDPWrap::OnRecv(ssize_t nread,
                      const uv_buf_t& buf_,
                      const sockaddr* addr,
                      unsigned int flags) {
+  if (recv_batch_) {
+    OnRecvBatch(nread, buf_, addr, flags);
+    return;
+  }
+
   Environment* env = this->env();
   AllocatedBuffer buf(env, buf_);
   if (nread == 0 && addr == nullptr) {
@@ -734,6 +847,86 @@ void UDPWrap::OnRecv(ssize_t nread,
   MakeCallback(env->onmessage_string(), arraysize(argv), argv);
 }
 
+// With UV_UDP_RECVMMSG, libuv reports every datagram of a recvmmsg() call
+// with UV_UDP_MMSG_CHUNK and then makes one more call with UV_UDP_MMSG_FREE.
+// Datagrams are collected until then and passed to JS in a single call.
+// Platforms without recvmmsg() report plain datagrams, which form a batch of
+// one.
+void UDPWrap::OnRecvBatch(ssize_t nread,
+                          const uv_buf_t& buf,
+                          const sockaddr* addr,
+                          unsigned int flags) {
+  if (nread < 0) {
+    Environment* env = this->env();
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    Local<Value> argv[] = {
+      Integer::New(env->isolate(), nread),
+      object(),
+      Undefined(env->isolate()),
+      Undefined(env->isolate())
+    };
+    MakeCallback(env->onmessage_string(), arraysize(argv), argv);
+    return;
+  }
+
+  if (addr != nullptr) {
+    BatchedDatagram datagram;
+    datagram.offset = buf.base - recv_slab_.get();
+    datagram.length = nread;
+    memcpy(&datagram.addr, addr, SocketAddress::GetLength(addr));
+    recv_batch_queue_.push_back(datagram);
+    if (flags & UV_UDP_MMSG_CHUNK)
+      return;
+  }
+
+  FlushRecvBatch();
+}
+
+void UDPWrap::FlushRecvBatch() {
+  if (recv_batch_queue_.empty())
+    return;
+
+  Environment* env = this->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  size_t count = recv_batch_queue_.size();
+  size_t total = 0;
+  for (const BatchedDatagram& datagram : recv_batch_queue_)
+    total += datagram.length;
+
+  // All datagrams share one buffer; rinfo.size tells JS where to split it.
+  AllocatedBuffer buf = AllocatedBuffer::AllocateManaged(env, total);
+  MaybeStackBuffer<Local<Value>, kRecvBatchWidth> rinfos(count);
+  size_t offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    const BatchedDatagram& datagram = recv_batch_queue_[i];
+    memcpy(buf.data() + offset,
+           recv_slab_.get() + datagram.offset,
+           datagram.length);
+    offset += datagram.length;
+
+    Local<Object> rinfo = AddressToJS(
+        env, reinterpret_cast<const sockaddr*>(&datagram.addr));
+    rinfo->Set(env->context(),
+               env->size_string(),
+               Integer::NewFromUnsigned(env->isolate(), datagram.length))
+        .Check();
+    rinfos[i] = rinfo;
+  }
+  recv_batch_queue_.clear();
+
+  Local<Value> argv[] = {
+    Integer::New(env->isolate(), count),
+    object(),
+    buf.ToBuffer().ToLocalChecked(),
+    Array::New(env->isolate(), rinfos.out(), count)
+  };
+  MakeCallback(env->onmessage_string(), arraysize(argv), argv);
+}
+
 MaybeLocal<Object> UDPWrap::Instantiate(Environment* env,
                                         AsyncWrap* parent,
                                         UDPWrap::SocketType type) {
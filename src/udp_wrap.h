@@ -30,6 +30,9 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <memory>
+#include <vector>
+
 namespace node {
 
 class UDPWrapBase;
@@ -135,6 +138,8 @@ class UDPWrap final : public HandleWrap,
   static void Bind6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Connect6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Send6(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Disconnect(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DropMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -186,7 +191,9 @@ class UDPWrap final : public HandleWrap,
             int (*F)(const typename T::HandleType*, sockaddr*, int*)>
   friend void GetSockOrPeerName(const v8::FunctionCallbackInfo<v8::Value>&);
 
-  UDPWrap(Environment* env, v8::Local<v8::Object> object);
+  UDPWrap(Environment* env,
+          v8::Local<v8::Object> object,
+          unsigned int flags = 0);
 
   static void DoBind(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
@@ -194,6 +201,8 @@ class UDPWrap final : public HandleWrap,
                      int family);
   static void DoSend(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
+  static void DoSendBatch(const v8::FunctionCallbackInfo<v8::Value>& args,
+                          int family);
   static void SetMembership(const v8::FunctionCallbackInfo<v8::Value>& args,
                             uv_membership membership);
   static void SetSourceMembership(
@@ -209,8 +218,28 @@ class UDPWrap final : public HandleWrap,
                      const struct sockaddr* addr,
                      unsigned int flags);
 
+  void OnRecvBatch(ssize_t nread,
+                   const uv_buf_t& buf,
+                   const sockaddr* addr,
+                   unsigned int flags);
+  void FlushRecvBatch();
+
   uv_udp_t handle_;
 
+  // Set when the handle was created with UV_UDP_RECVMMSG. libuv then reads
+  // up to kRecvBatchWidth datagrams per recvmmsg() call into recv_slab_,
+  // one kMaxDatagramSize chunk each, and they are handed to JS together.
+  static constexpr size_t kRecvBatchWidth = 20;
+  static constexpr size_t kMaxDatagramSize = 64 * 1024;
+  struct BatchedDatagram {
+    size_t offset;
+    size_t length;
+    sockaddr_storage addr;
+  };
+  bool recv_batch_ = false;
+  std::unique_ptr<char[]> recv_slab_;
+  std::vector<BatchedDatagram> recv_batch_queue_;
+
   bool current_send_has_callback_;
   v8::Local<v8::Object> current_send_req_wrap_;
 };
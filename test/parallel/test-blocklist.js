@@ -135,3 +135,59 @@ const assert = require('assert');
   assert(blockList.check('8592:757c:efaf:1fff:ffff:ffff:ffff:ffff', 'ipv6'));
   assert(!blockList.check('8592:757c:efaf:2fff:ffff:ffff:ffff:ffff', 'ipv6'));
 }
+
+{
+  // IPv4 addresses are ordered numerically, across octet boundaries.
+  const blockList = new BlockList();
+  blockList.addRange('10.0.0.255', '10.0.1.0');
+  blockList.addRange('9.255.255.0', '10.0.0.0');
+
+  assert(blockList.check('10.0.0.255'));
+  assert(blockList.check('10.0.1.0'));
+  assert(blockList.check('10.0.0.0'));
+  assert(blockList.check('9.255.255.128'));
+  assert(!blockList.check('10.0.0.1'));
+  assert(!blockList.check('10.0.1.1'));
+  assert(!blockList.check('9.255.254.255'));
+}
+
+{
+  // Full-width and empty prefixes.
+  const blockList = new BlockList();
+  blockList.addSubnet('192.168.1.1', 32);
+  assert(blockList.check('192.168.1.1'));
+  assert(blockList.check('::ffff:192.168.1.1', 'ipv6'));
+  assert(!blockList.check('192.168.1.2'));
+
+  blockList.addSubnet('0.0.0.0', 0);
+  assert(blockList.check('1.2.3.4'));
+  assert(blockList.check('255.255.255.255'));
+  assert(!blockList.check('2001:db8::1', 'ipv6'));
+}
+
+{
+  // IPv6 ranges within the IPv4-mapped space also match IPv4 addresses.
+  const blockList = new BlockList();
+  blockList.addRange('::ffff:10.0.0.1', '::ffff:10.0.0.10', 'ipv6');
+  blockList.addRange('::ffff:20.0.0.1', '2001:db8::', 'ipv6');
+  assert(blockList.check('10.0.0.5'));
+  assert(blockList.check('::ffff:10.0.0.5', 'ipv6'));
+  assert(!blockList.check('10.0.0.11'));
+  assert(blockList.check('::ffff:20.0.0.5', 'ipv6'));
+  assert(blockList.check('2001:db7::1', 'ipv6'));
+  assert(!blockList.check('20.0.0.5'));
+}
+
+{
+  // Removing one address keeps overlapping rules in place.
+  const blockList = new BlockList();
+  for (let n = 0; n < 256; n++)
+    blockList.addAddress(`10.0.${n}.1`);
+  blockList.addSubnet('10.0.16.0', 20);
+  blockList.removeAddress('10.0.17.1');
+  blockList.removeAddress('10.0.1.1');
+  assert(blockList.check('10.0.17.1'));
+  assert(!blockList.check('10.0.1.1'));
+  assert(blockList.check('10.0.2.1'));
+  assert(!blockList.check('10.0.2.2'));
+}
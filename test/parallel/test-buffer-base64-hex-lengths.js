@@ -0,0 +1,107 @@
+'use strict';
+
+// Base64, base64url and hex are encoded and decoded in blocks where the CPU
+// allows it, with scalar code for the rest. Check inputs of all lengths
+// around the block sizes, and invalid characters at every position.
+
+require('../common');
+const assert = require('assert');
+const { StringDecoder } = require('string_decoder');
+
+const alphabet =
+  'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
+
+function base64(buf, url) {
+  let str = '';
+  for (let i = 0; i < buf.length; i += 3) {
+    const n = (buf[i] << 16) | (buf[i + 1] << 8) | buf[i + 2];
+    const chars = Math.min(buf.length - i, 3) + 1;
+    for (let j = 0; j < 4; j++) {
+      if (j < chars)
+        str += alphabet[(n >> (18 - j * 6)) & 63];
+      else if (!url)
+        str += '=';
+    }
+  }
+  return url ? str.replace(/\+/g, '-').replace(/\//g, '_') : str;
+}
+
+function hex(buf) {
+  let str = '';
+  for (const byte of buf)
+    str += byte.toString(16).padStart(2, '0');
+  return str;
+}
+
+const data = Buffer.alloc(300);
+for (let i = 0; i < data.length; i++)
+  data[i] = (i * 151 + 17) & 0xff;
+
+for (let len = 0; len <= data.length; len++) {
+  const buf = data.subarray(0, len);
+
+  const b64 = base64(buf, false);
+  const b64url = base64(buf, true);
+  assert.strictEqual(buf.toString('base64'), b64);
+  assert.strictEqual(buf.toString('base64url'), b64url);
+  assert.deepStrictEqual(Buffer.from(b64, 'base64'), buf);
+  assert.deepStrictEqual(Buffer.from(b64url, 'base64url'), buf);
+  // Both alphabets are accepted for decoding.
+  assert.deepStrictEqual(Buffer.from(b64url, 'base64'), buf);
+  assert.deepStrictEqual(Buffer.from(b64, 'base64url'), buf);
+
+  const hexStr = hex(buf);
+  assert.strictEqual(buf.toString('hex'), hexStr);
+  assert.deepStrictEqual(Buffer.from(hexStr, 'hex'), buf);
+  assert.deepStrictEqual(Buffer.from(hexStr.toUpperCase(), 'hex'), buf);
+}
+
+{
+  // Hex decoding stops at the first invalid character.
+  const hexStr = data.toString('hex');
+  for (let i = 0; i < 200; i++) {
+    for (const c of ['g', 'G', '/', ':', '@', '`', ' ', 'à']) {
+      const str = hexStr.slice(0, i) + c + hexStr.slice(i + 1);
+      assert.deepStrictEqual(Buffer.from(str, 'hex'),
+                             data.subarray(0, i >> 1));
+    }
+  }
+}
+
+{
+  // Whitespace is skipped, and padding ends base64 decoding.
+  const b64 = data.toString('base64');
+  for (let i = 1; i < 200; i++) {
+    const spaced = b64.slice(0, i) + '\n ' + b64.slice(i);
+    assert.deepStrictEqual(Buffer.from(spaced, 'base64'), data);
+  }
+  for (let i = 4; i < 200; i += 4) {
+    const padded = `${b64.slice(0, i - 1)}=${b64.slice(i)}`;
+    const decoded = Buffer.from(padded, 'base64');
+    assert.deepStrictEqual(decoded.subarray(0, i / 4 * 3 - 1),
+                           data.subarray(0, i / 4 * 3 - 1));
+    assert.strictEqual(decoded.length, i / 4 * 3 - 1);
+  }
+}
+
+{
+  // Large inputs, written to offsets of an existing buffer.
+  const big = Buffer.alloc(1024 * 1024 + 7);
+  for (let i = 0; i < big.length; i++)
+    big[i] = (i * 7919) & 0xff;
+  const target = Buffer.alloc(big.length + 5);
+  for (const encoding of ['base64', 'base64url', 'hex']) {
+    const str = big.toString(encoding);
+    assert.strictEqual(Buffer.byteLength(str, encoding), big.length);
+    assert.strictEqual(target.write(str, 5, encoding), big.length);
+    assert.deepStrictEqual(target.subarray(5), big);
+    assert.strictEqual(target.write(str, 5, 1000, encoding), 1000);
+  }
+}
+
+{
+  const decoder = new StringDecoder('base64url');
+  assert.strictEqual(decoder.write(Buffer.from([0xfb])), '');
+  assert.strictEqual(decoder.write(Buffer.from([0xff, 0xbf, 0x01])), '-_-_');
+  assert.strictEqual(decoder.end(), 'AQ');
+}
@@ -621,3 +621,39 @@ assert.strictEqual(reallyLong.lastIndexOf(pattern), 0);
              'Received an instance of lastIndexOf'
   });
 }
+
+// Short needles are matched a block of positions at a time, so check every
+// needle length around the block sizes, at every offset, in both directions.
+{
+  function naiveIndexOf(haystack, needle, from, forward) {
+    const last = haystack.length - needle.length;
+    const matches = (i) =>
+      haystack.slice(i, i + needle.length).equals(needle);
+    if (forward) {
+      for (let i = from; i <= last; i++)
+        if (matches(i)) return i;
+    } else {
+      for (let i = Math.min(from, last); i >= 0; i--)
+        if (matches(i)) return i;
+    }
+    return -1;
+  }
+
+  const haystack = Buffer.alloc(150);
+  for (let i = 0; i < haystack.length; i++)
+    haystack[i] = 0x61 + (i * 7 + (i >> 3)) % 3;
+
+  for (const length of [2, 3, 15, 16, 17, 31, 32, 33, 64, 65]) {
+    for (const at of [0, 1, 15, 16, 31, 32, 33, 63, 150 - length]) {
+      const needle = Buffer.from(haystack.slice(at, at + length));
+      for (const from of [0, at, at + 1, 149]) {
+        assert.strictEqual(haystack.indexOf(needle, from),
+                           naiveIndexOf(haystack, needle, from, true));
+        assert.strictEqual(haystack.lastIndexOf(needle, from),
+                           naiveIndexOf(haystack, needle, from, false));
+        assert.strictEqual(haystack.includes(needle.toString('latin1'), from),
+                           naiveIndexOf(haystack, needle, from, true) !== -1);
+      }
+    }
+  }
+}
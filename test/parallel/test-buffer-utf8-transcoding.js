@@ -0,0 +1,98 @@
+'use strict';
+
+require('../common');
+
+// UTF-8 is validated and transcoded in blocks, so check inputs of many
+// lengths with every kind of character at every position of a block, and
+// compare against the results of the plain per-character code paths.
+
+const assert = require('assert');
+const { StringDecoder } = require('string_decoder');
+
+const samples = ['a', '\x7f', '\x80', '\xe9', '\xff', '\u0100', '\u07ff',
+                 '\u0800', '\ud7ff', '\ue000', '\uffff', '\u{10000}',
+                 '\u{10ffff}'];
+
+function encode(str) {
+  const bytes = [];
+  for (const ch of str) {
+    const cp = ch.codePointAt(0);
+    if (cp < 0x80) {
+      bytes.push(cp);
+    } else if (cp < 0x800) {
+      bytes.push(0xc0 | cp >> 6, 0x80 | cp & 0x3f);
+    } else if (cp < 0x10000) {
+      bytes.push(0xe0 | cp >> 12, 0x80 | cp >> 6 & 0x3f, 0x80 | cp & 0x3f);
+    } else {
+      bytes.push(0xf0 | cp >> 18, 0x80 | cp >> 12 & 0x3f,
+                 0x80 | cp >> 6 & 0x3f, 0x80 | cp & 0x3f);
+    }
+  }
+  return Buffer.from(bytes);
+}
+
+const encoder = new TextEncoder();
+const fatal = new TextDecoder('utf-8', { fatal: true });
+
+for (const len of [1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000]) {
+  for (const sample of samples) {
+    for (const pos of [0, len >> 1, len - 1]) {
+      const str = 'x'.repeat(pos) + sample + 'y'.repeat(len - pos - 1);
+      const buf = encode(str);
+
+      assert.strictEqual(buf.toString(), str);
+      assert.deepStrictEqual(Buffer.from(str), buf);
+      assert.deepStrictEqual(Buffer.from(encoder.encode(str)), buf);
+      assert.strictEqual(fatal.decode(buf), str);
+      assert.strictEqual(new StringDecoder('utf8').end(buf), str);
+
+      // Partial writes never split a character.
+      const small = Buffer.alloc(buf.length - 1, 0);
+      const written = small.write(str);
+      assert.deepStrictEqual(small.slice(0, written),
+                             buf.slice(0, written));
+      assert.strictEqual(small.slice(0, written).toString(),
+                         buf.slice(0, written).toString());
+      assert.ok(!small.slice(0, written).toString().includes('\ufffd'));
+
+      // Corrupt the first byte of the sample, and cut it short.
+      const start = Buffer.byteLength(str.slice(0, pos));
+      for (const bad of [0x80, 0xc0, 0xc1, 0xf5, 0xff]) {
+        const invalid = Buffer.from(buf);
+        invalid[start] = bad;
+        assert.strictEqual(invalid.toString(),
+                           new TextDecoder().decode(invalid));
+        assert.throws(() => fatal.decode(invalid), {
+          code: 'ERR_ENCODING_INVALID_ENCODED_DATA'
+        });
+      }
+      const sampleLen = Buffer.byteLength(sample);
+      if (sampleLen > 1) {
+        const truncated = Buffer.concat([buf.slice(0, start + 1),
+                                         buf.slice(start + sampleLen)]);
+        assert.strictEqual(truncated.toString(),
+                           str.slice(0, pos) + '\ufffd' +
+                           str.slice(pos + sample.length));
+        assert.throws(() => fatal.decode(truncated), {
+          code: 'ERR_ENCODING_INVALID_ENCODED_DATA'
+        });
+      }
+    }
+  }
+}
+
+// Overlong encodings, surrogates and code points above U+10FFFF.
+for (const bytes of [[0xc0, 0x80], [0xe0, 0x80, 0x80], [0xed, 0xa0, 0x80],
+                     [0xf0, 0x80, 0x80, 0x80], [0xf4, 0x90, 0x80, 0x80]]) {
+  const invalid = Buffer.concat([Buffer.alloc(40, 'a'), Buffer.from(bytes)]);
+  assert.ok(invalid.toString().endsWith('\ufffd'));
+  assert.throws(() => fatal.decode(invalid), {
+    code: 'ERR_ENCODING_INVALID_ENCODED_DATA'
+  });
+}
+
+// The byte order mark is only skipped when asked to.
+const bom = Buffer.from([0xef, 0xbb, 0xbf, 0x61]);
+assert.strictEqual(new TextDecoder().decode(bom), 'a');
+assert.strictEqual(new TextDecoder('utf-8', { ignoreBOM: true }).decode(bom),
+                   '\ufeffa');
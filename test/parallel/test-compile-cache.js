@@ -0,0 +1,89 @@
+'use strict';
+
+// Tests the on-disk compile cache that NODE_COMPILE_CACHE enables.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const cacheDir = path.join(tmpdir.path, 'cache');
+
+fs.writeFileSync(path.join(tmpdir.path, 'lib.js'), `
+module.exports = function square(x) { return x * x; };
+`);
+fs.writeFileSync(path.join(tmpdir.path, 'lib.mjs'), `
+export function cube(x) { return x * x * x; }
+`);
+const main = path.join(tmpdir.path, 'main.js');
+fs.writeFileSync(main, `
+const square = require('./lib.js');
+import('./lib.mjs').then(({ cube }) => {
+  console.log(square(3), cube(3));
+});
+`);
+
+function run() {
+  const child = spawnSync(process.execPath, [main], {
+    env: { ...process.env, NODE_COMPILE_CACHE: cacheDir },
+  });
+  assert.strictEqual(child.stderr.toString(), '');
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(child.stdout.toString(), '9 27\n');
+}
+
+function listCache() {
+  const [options, ...rest] = fs.readdirSync(cacheDir);
+  assert.deepStrictEqual(rest, []);
+  const dir = path.join(cacheDir, options);
+  return fs.readdirSync(dir).sort().map((file) => path.join(dir, file));
+}
+
+// The first run writes the cache when it exits.
+run();
+const files = listCache();
+assert.deepStrictEqual(files.map((file) => path.extname(file)).sort(),
+                       ['.cjs', '.cjs', '.mjs']);
+for (const file of files)
+  assert(fs.statSync(file).size > 0);
+
+// Later runs use it, and leave it alone.
+const mtimes = files.map((file) => fs.statSync(file).mtimeMs);
+run();
+assert.deepStrictEqual(listCache(), files);
+assert.deepStrictEqual(files.map((file) => fs.statSync(file).mtimeMs),
+                       mtimes);
+
+// Cache data that V8 rejects is replaced.
+for (const file of files)
+  fs.writeFileSync(file, 'not cache data');
+run();
+assert.deepStrictEqual(listCache(), files);
+for (const file of files)
+  assert.notStrictEqual(fs.readFileSync(file, 'latin1'), 'not cache data');
+
+// Entries are named after the SHA-256 digest of their source, and record it.
+function checkHeaders() {
+  for (const file of files) {
+    const hash = path.basename(file, path.extname(file));
+    assert.match(hash, /^[0-9a-f]{64}$/);
+    assert(fs.readFileSync(file, 'latin1').startsWith(`${hash} `));
+  }
+}
+checkHeaders();
+
+// An entry that was created for a different source, as if the digests had
+// collided, is not used but replaced.
+const cjsFiles = files.filter((file) => path.extname(file) === '.cjs');
+fs.copyFileSync(cjsFiles[0], cjsFiles[1]);
+run();
+assert.deepStrictEqual(listCache(), files);
+checkHeaders();
+
+// A changed module gets a new entry.
+fs.appendFileSync(path.join(tmpdir.path, 'lib.js'), '\n// changed\n');
+run();
+assert.strictEqual(listCache().length, files.length + 1);
@@ -0,0 +1,179 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+// Encrypts a message as crypto.aeadEncryptBatch() should, with the tag
+// appended to the ciphertext.
+function encrypt(algorithm, key, { iv, aad, plaintext }, authTagLength) {
+  const cipher = crypto.createCipheriv(algorithm, key, iv, { authTagLength });
+  if (aad !== undefined)
+    cipher.setAAD(Buffer.from(aad));
+  return Buffer.concat([
+    cipher.update(plaintext),
+    cipher.final(),
+    cipher.getAuthTag(),
+  ]);
+}
+
+function makeMessages(count, size, ivLength) {
+  const messages = [];
+  for (let i = 0; i < count; i++) {
+    const message = {
+      iv: crypto.randomBytes(ivLength),
+      plaintext: crypto.randomBytes((i * 37) % (size + 1)),
+    };
+    if (i % 3 !== 0)
+      message.aad = crypto.randomBytes(i % 20);
+    messages.push(message);
+  }
+  return messages;
+}
+
+const ciphers = [
+  ['aes-128-gcm', 16, [12, 16, 8]],
+  ['aes-256-gcm', 32, [12]],
+  ['chacha20-poly1305', 32, [12]],
+];
+
+for (const [algorithm, keyLength, ivLengths] of ciphers) {
+  const rawKey = crypto.randomBytes(keyLength);
+  for (const key of [rawKey, crypto.createSecretKey(rawKey)]) {
+    for (const ivLength of ivLengths) {
+      // Small batches run on the main thread, large ones in the threadpool.
+      for (const [count, size] of [[20, 100], [300, 1000]]) {
+        const messages = makeMessages(count, size, ivLength);
+        const expected = Buffer.concat(
+          messages.map((message) => encrypt(algorithm, rawKey, message, 16)));
+        const output = Buffer.alloc(expected.length + 10);
+
+        crypto.aeadEncryptBatch(
+          algorithm, key, messages, output, { outputOffset: 10 },
+          common.mustSucceed((bytesWritten) => {
+            assert.strictEqual(bytesWritten, expected.length);
+            assert.deepStrictEqual(output.slice(10), expected);
+
+            // Decrypt the messages again.
+            let offset = 10;
+            const encrypted = messages.map(({ iv, aad, plaintext }) => {
+              const length = plaintext.length + 16;
+              const ciphertext = output.slice(offset, offset += length);
+              return { iv, aad, ciphertext };
+            });
+            const decrypted = new Uint8Array(bytesWritten - 16 * count);
+            crypto.aeadDecryptBatch(
+              algorithm, key, encrypted, decrypted,
+              common.mustSucceed((bytesWritten) => {
+                assert.strictEqual(bytesWritten, decrypted.length);
+                assert.deepStrictEqual(
+                  Buffer.from(decrypted),
+                  Buffer.concat(messages.map((m) => m.plaintext)));
+              }));
+
+            // A changed byte in one of the messages is detected.
+            const tampered = encrypted.map((message) => ({ ...message }));
+            const ciphertext = Buffer.from(tampered[count >> 1].ciphertext);
+            ciphertext[0] ^= 1;
+            tampered[count >> 1].ciphertext = ciphertext;
+            const unauthenticated =
+              new Uint8Array(decrypted.length).fill(0xff);
+            crypto.aeadDecryptBatch(
+              algorithm, key, tampered, unauthenticated,
+              common.mustCall((err, bytesWritten) => {
+                assert.strictEqual(err.message,
+                                   'Unsupported state or unable to ' +
+                                   'authenticate data');
+                assert.strictEqual(err.index, count >> 1);
+                assert.strictEqual(bytesWritten, undefined);
+
+                // The plaintext written up to and including the failed
+                // message is cleared, and nothing after it is touched.
+                const written = messages.slice(0, (count >> 1) + 1)
+                  .reduce((sum, { plaintext }) => sum + plaintext.length, 0);
+                assert(unauthenticated.subarray(0, written)
+                  .every((byte) => byte === 0));
+                assert(unauthenticated.subarray(written)
+                  .every((byte) => byte === 0xff));
+              }));
+          }));
+      }
+    }
+  }
+}
+
+{
+  // Shorter authentication tags.
+  const key = crypto.randomBytes(32);
+  const messages = makeMessages(5, 50, 12);
+  for (const [algorithm, authTagLength] of [
+    ['aes-256-gcm', 4],
+    ['aes-256-gcm', 12],
+    ['chacha20-poly1305', 8],
+  ]) {
+    const expected = Buffer.concat(messages.map(
+      (message) => encrypt(algorithm, key, message, authTagLength)));
+    const output = Buffer.alloc(expected.length);
+    crypto.aeadEncryptBatch(
+      algorithm, key, messages, output, { authTagLength },
+      common.mustSucceed((bytesWritten) => {
+        assert.strictEqual(bytesWritten, expected.length);
+        assert.deepStrictEqual(output, expected);
+      }));
+  }
+}
+
+{
+  // The callback is always called asynchronously, even for empty batches.
+  let sync = true;
+  crypto.aeadEncryptBatch(
+    'aes-128-gcm', Buffer.alloc(16), [], Buffer.alloc(0),
+    common.mustSucceed((bytesWritten) => {
+      assert.strictEqual(sync, false);
+      assert.strictEqual(bytesWritten, 0);
+    }));
+  sync = false;
+}
+
+{
+  const key = Buffer.alloc(32);
+  const messages = [{ iv: Buffer.alloc(12), plaintext: 'hello' }];
+  const output = Buffer.alloc(21);
+
+  assert.throws(
+    () => crypto.aeadEncryptBatch('aes-256-cbc', key, messages, output,
+                                  common.mustNotCall()),
+    { code: 'ERR_CRYPTO_UNSUPPORTED_OPERATION' });
+  assert.throws(
+    () => crypto.aeadEncryptBatch('aes-128-gcm', key, messages, output,
+                                  common.mustNotCall()),
+    { code: 'ERR_CRYPTO_INVALID_KEYLEN' });
+  assert.throws(
+    () => crypto.aeadEncryptBatch('chacha20-poly1305', key,
+                                  [{ iv: Buffer.alloc(16), plaintext: '' }],
+                                  output, common.mustNotCall()),
+    { code: 'ERR_CRYPTO_INVALID_IV' });
+  assert.throws(
+    () => crypto.aeadEncryptBatch('aes-256-gcm', key, messages, output,
+                                  { authTagLength: 5 }, common.mustNotCall()),
+    { code: 'ERR_CRYPTO_INVALID_AUTH_TAG' });
+  assert.throws(
+    () => crypto.aeadEncryptBatch('aes-256-gcm', key, messages,
+                                  Buffer.alloc(20), common.mustNotCall()),
+    { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(
+    () => crypto.aeadDecryptBatch('aes-256-gcm', key,
+                                  [{ iv: Buffer.alloc(12), ciphertext: 'x' }],
+                                  output, common.mustNotCall()),
+    { code: 'ERR_INVALID_ARG_VALUE' });
+  assert.throws(
+    () => crypto.aeadEncryptBatch('aes-256-gcm', key, messages, output),
+    { code: 'ERR_INVALID_CALLBACK' });
+  assert.throws(
+    () => crypto.aeadEncryptBatch('aes-256-gcm', key, 'messages', output,
+                                  common.mustNotCall()),
+    { code: 'ERR_INVALID_ARG_TYPE' });
+}
@@ -0,0 +1,98 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const inputs = [
+  '',
+  'a',
+  'Hello, world!',
+  Buffer.alloc(1000, 'x'),
+  new Uint8Array([1, 2, 3]),
+  new DataView(new ArrayBuffer(16)),
+  new ArrayBuffer(64),
+  'é\u{1f600}',
+];
+
+function expected(algorithm, options = {}) {
+  return Buffer.concat(inputs.map((input) => {
+    if (input instanceof ArrayBuffer)
+      input = Buffer.from(input);
+    else if (ArrayBuffer.isView(input) && !(input instanceof Uint8Array))
+      input = Buffer.from(input.buffer, input.byteOffset, input.byteLength);
+    const hash = options.key !== undefined ?
+      crypto.createHmac(algorithm, options.key) :
+      crypto.createHash(algorithm, options);
+    return hash.update(input).digest();
+  }));
+}
+
+const cases = [
+  ['sha256'],
+  ['sha1'],
+  ['md5'],
+  ['sha512'],
+  ['sha256', { key: 'secret' }],
+  ['sha512', { key: Buffer.alloc(200, 'k') }],
+  ['sha256', { key: crypto.createSecretKey(Buffer.from('key')) }],
+  ['sha256', { key: '' }],
+  ['shake256', { outputLength: 10 }],
+];
+
+for (const [algorithm, options] of cases) {
+  assert.deepStrictEqual(crypto.hashBatchSync(algorithm, inputs, options),
+                         expected(algorithm, options));
+
+  crypto.hashBatch(algorithm, inputs, options,
+                   common.mustSucceed((digests) => {
+                     assert.deepStrictEqual(digests,
+                                            expected(algorithm, options));
+                   }));
+}
+
+assert.deepStrictEqual(crypto.hashBatchSync('sha256', []), Buffer.alloc(0));
+crypto.hashBatch('sha256', [], common.mustSucceed((digests) => {
+  assert.deepStrictEqual(digests, Buffer.alloc(0));
+}));
+
+// The inputs are copied for asynchronous jobs.
+{
+  const input = Buffer.from('abc');
+  const digest = crypto.createHash('sha256').update(input).digest();
+  crypto.hashBatch('sha256', [input], common.mustSucceed((digests) => {
+    assert.deepStrictEqual(digests, digest);
+  }));
+  input.fill(0);
+}
+
+assert.throws(() => crypto.hashBatchSync('sha256', 'abc'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => crypto.hashBatchSync('sha256', ['a', 1]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /inputs\[1\]/
+});
+assert.throws(() => crypto.hashBatchSync(1, []), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => crypto.hashBatchSync('sha256', [], null), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => crypto.hashBatchSync('nope', ['a']), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST'
+});
+assert.throws(() => crypto.hashBatchSync('sha256', ['a'],
+                                         { outputLength: 10 }), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST'
+});
+assert.throws(() => crypto.hashBatchSync('shake256', ['a'],
+                                         { key: 'k', outputLength: 10 }), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST'
+});
+assert.throws(() => crypto.hashBatch('sha256', []), {
+  code: 'ERR_INVALID_CALLBACK'
+});
@@ -0,0 +1,46 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+const data = [];
+for (let i = 0; i < 50; i++)
+  data.push(`datagram ${i}`);
+data.push(Buffer.alloc(0));
+data.push(new Uint8Array([1, 2, 3]));
+
+const expected = data.map((msg) => Buffer.from(msg));
+const received = [];
+
+const server = dgram.createSocket({ type: 'udp4', recvBatch: true });
+const client = dgram.createSocket('udp4');
+
+server.on('message', common.mustNotCall());
+
+server.on('messages', common.mustCallAtLeast((msgs, rinfos) => {
+  assert.strictEqual(msgs.length, rinfos.length);
+  for (let i = 0; i < msgs.length; i++) {
+    assert.strictEqual(rinfos[i].size, msgs[i].length);
+    assert.strictEqual(rinfos[i].port, client.address().port);
+    received.push(msgs[i]);
+  }
+
+  if (received.length === expected.length) {
+    assert.deepStrictEqual(received, expected);
+    server.close();
+    client.close();
+  }
+}));
+
+server.bind(0, common.mustCall(() => {
+  const { port } = server.address();
+
+  assert.throws(() => client.sendBatch('foo', port, 'localhost'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => client.sendBatch([{}], port, 'localhost'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+
+  client.sendBatch(data, port, 'localhost', common.mustSucceed());
+}));
@@ -0,0 +1,83 @@
+'use strict';
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+
+// Unpiping or destroying a file stream while it is being sent natively into
+// a socket must leave the stream in the same state as the regular path does.
+
+tmpdir.refresh();
+const file = path.join(tmpdir.path, 'pipe-socket-unpipe.bin');
+// Large enough not to fit into the socket buffers while the client is paused.
+const expected = Buffer.alloc(32 * 1024 * 1024);
+for (let i = 0; i < expected.length; i += 4096)
+  expected.writeUInt32BE(i, i);
+fs.writeFileSync(file, expected);
+
+function waitForProgress(stream, callback) {
+  if (stream.getBytesRead() > 0)
+    callback();
+  else
+    setTimeout(waitForProgress, 10, stream, callback);
+}
+
+function pipeAndThen(action, onClientEnd) {
+  const server = net.createServer(common.mustCall((socket) => {
+    const stream = fs.createReadStream(file);
+    stream.pipe(socket);
+    waitForProgress(stream, () => action(stream, socket, client));
+  }));
+
+  let client;
+  server.listen(0, common.mustCall(() => {
+    const chunks = [];
+    client = net.connect(server.address().port);
+    client.pause();
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.on('close', common.mustCall(() => {
+      onClientEnd(Buffer.concat(chunks));
+      server.close();
+    }));
+  }));
+}
+
+// Unpiping stops the transfer, and piping again sends the rest of the file.
+pipeAndThen(common.mustCall((stream, socket, client) => {
+  stream.unpipe(socket);
+  assert.strictEqual(stream.isPaused(), true);
+  setImmediate(common.mustCall(() => {
+    // bytesRead is caught up once the native transfer has stopped.
+    const bytesRead = stream.bytesRead;
+    assert(bytesRead > 0);
+    assert.strictEqual(stream.getBytesRead(), bytesRead);
+    setTimeout(common.mustCall(() => {
+      assert.strictEqual(stream.bytesRead, bytesRead);
+      stream.on('end', common.mustCall(() => {
+        assert.strictEqual(stream.bytesRead, expected.length);
+      }));
+      stream.pipe(socket);
+      client.resume();
+    }), 50);
+  }));
+}), common.mustCall((data) => {
+  assert.strictEqual(data.length, expected.length);
+  assert(data.equals(expected));
+}));
+
+// Destroying the stream stops the transfer and closes the file.
+pipeAndThen(common.mustCall((stream, socket, client) => {
+  stream.on('end', common.mustNotCall());
+  stream.on('close', common.mustCall(() => {
+    assert(stream.bytesRead > 0);
+    assert(stream.bytesRead <= expected.length);
+    socket.end();
+    client.resume();
+  }));
+  stream.destroy();
+}), common.mustCall((data) => {
+  assert(data.length <= expected.length);
+  assert(data.equals(expected.slice(0, data.length)));
+}));
@@ -0,0 +1,40 @@
+'use strict';
+const common = require('../common');
+const fixtures = require('../common/fixtures');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+
+// Piping a file stream into a TCP socket takes a native path. Make sure the
+// peer gets exactly the requested bytes and both streams finish normally.
+
+const file = fixtures.path('sample.png');
+const expected = fs.readFileSync(file);
+
+function pipeFile(options, expectedData) {
+  const server = net.createServer(common.mustCall((socket) => {
+    const stream = fs.createReadStream(file, options);
+    stream.on('end', common.mustCall(() => {
+      assert.strictEqual(stream.bytesRead, expectedData.length);
+    }));
+    stream.on('close', common.mustCall());
+    assert.strictEqual(stream.pipe(socket), socket);
+    socket.on('close', common.mustCall(() => {
+      assert.strictEqual(socket.bytesWritten, expectedData.length);
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const chunks = [];
+    const client = net.connect(server.address().port);
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), expectedData);
+      server.close();
+    }));
+  }));
+}
+
+pipeFile(undefined, expected);
+pipeFile({ start: 100, end: 999 }, expected.slice(100, 1000));
+pipeFile({ start: 0, end: 0 }, expected.slice(0, 1));
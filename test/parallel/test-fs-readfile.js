@@ -75,3 +75,25 @@ for (const e of fileInfo) {
   }));
   process.nextTick(() => controller.abort());
 }
+{
+  // Test decoding, for both plain ASCII and multi-byte UTF-8 contents.
+  const ascii = path.join(tmpdir.path, `${prefix}-ascii.txt`);
+  const utf8 = path.join(tmpdir.path, `${prefix}-utf8.txt`);
+  fs.writeFileSync(ascii, 'hello world');
+  fs.writeFileSync(utf8, 'héllo wörld \u{1F600}');
+  fs.readFile(ascii, 'utf8', common.mustSucceed((str) => {
+    assert.strictEqual(str, 'hello world');
+  }));
+  fs.readFile(utf8, 'utf8', common.mustSucceed((str) => {
+    assert.strictEqual(str, 'héllo wörld \u{1F600}');
+  }));
+  fs.readFile(ascii, 'hex', common.mustSucceed((str) => {
+    assert.strictEqual(str, Buffer.from('hello world').toString('hex'));
+  }));
+}
+if (common.isLinux) {
+  // Test files that report a size of zero but aren't empty.
+  fs.readFile('/proc/self/status', 'utf8', common.mustSucceed((str) => {
+    assert.match(str, /^Name:/);
+  }));
+}
@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// Header values that are passed from the parser as raw bytes must come out
+// the same as eagerly created ones, whichever of headers, rawHeaders and the
+// internal single-header lookups is used first.
+
+const request = 'GET / HTTP/1.1\r\n' +
+                'Host: localhost\r\n' +
+                'X-Custom: a value  \t\r\n' +
+                'x-custom: second\r\n' +
+                'Cookie: a=1\r\n' +
+                'cookie: b=2\r\n' +
+                'Empty:\r\n' +
+                'Latin1: \xe9t\xe9\r\n' +
+                'Expect: 100-continue\r\n' +
+                'Connection: close\r\n' +
+                '\r\n';
+
+const server = http.createServer(common.mustNotCall());
+
+server.on('checkContinue', common.mustCall((req, res) => {
+  assert.deepStrictEqual(req.rawHeaders, [
+    'Host', 'localhost',
+    'X-Custom', 'a value',
+    'x-custom', 'second',
+    'Cookie', 'a=1',
+    'cookie', 'b=2',
+    'Empty', '',
+    'Latin1', '\xe9t\xe9',
+    'Expect', '100-continue',
+    'Connection', 'close',
+  ]);
+  assert.strictEqual(req.headers['x-custom'], 'a value, second');
+  assert.strictEqual(req.headers.cookie, 'a=1; b=2');
+  assert.strictEqual(req.headers.empty, '');
+  assert.strictEqual(req.headers.latin1, '\xe9t\xe9');
+  res.end();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port);
+  socket.end(request, 'latin1');
+  socket.resume();
+  socket.on('close', common.mustCall(() => {
+    server.close();
+    testClient();
+  }));
+}));
+
+function testClient() {
+  const server = http.createServer((req, res) => {
+    res.setHeader('X-Reply', ['one', 'two']);
+    res.end();
+  });
+
+  server.listen(0, common.mustCall(() => {
+    http.get({ port: server.address().port }, common.mustCall((res) => {
+      // Read headers before rawHeaders this time.
+      assert.strictEqual(res.headers['x-reply'], 'one, two');
+      const replies = res.rawHeaders.filter((value, i) => {
+        return i % 2 === 1 && res.rawHeaders[i - 1] === 'X-Reply';
+      });
+      assert.deepStrictEqual(replies, ['one', 'two']);
+      res.resume();
+      res.on('end', common.mustCall(() => server.close()));
+    }));
+  }));
+}
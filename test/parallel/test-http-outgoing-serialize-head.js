@@ -0,0 +1,54 @@
+'use strict';
+
+const common = require('../common');
+
+// Message heads are serialized natively. Check that the result is still
+// exposed as a string, reaches the peer unchanged, and that invalid header
+// names and values are still rejected with the usual errors.
+
+const assert = require('assert');
+const http = require('http');
+
+const server = http.createServer(common.mustCall((req, res) => {
+  assert.throws(() => res.writeHead(200, { 'bad name': 'x' }), {
+    code: 'ERR_INVALID_HTTP_TOKEN',
+  });
+  assert.throws(() => res.writeHead(200, { 'x-bad': 'a\nb' }), {
+    code: 'ERR_INVALID_CHAR',
+  });
+  assert.strictEqual(res.headersSent, false);
+
+  res.setHeader('X-Set', 'set');
+  res.writeHead(200, { 'X-Array': ['a', 'b'], 'X-Number': 42 });
+  assert.strictEqual(typeof res._header, 'string');
+  assert.match(res._header, /^HTTP\/1\.1 200 OK\r\n/);
+  assert.match(res._header, /\r\nX-Array: a\r\nX-Array: b\r\n/);
+  assert.match(res._header, /\r\n\r\n$/);
+  res.end('hello');
+}, 2));
+
+server.listen(0, common.mustCall(() => {
+  const { port } = server.address();
+  let pending = 2;
+  const done = () => { if (--pending === 0) server.close(); };
+
+  http.get({ port, headers: { 'X-Req': 'req' } }, common.mustCall((res) => {
+    assert.strictEqual(res.headers['x-set'], 'set');
+    assert.strictEqual(res.headers['x-array'], 'a, b');
+    assert.strictEqual(res.headers['x-number'], '42');
+    res.setEncoding('utf8');
+    let body = '';
+    res.on('data', (chunk) => body += chunk);
+    res.on('end', common.mustCall(() => {
+      assert.strictEqual(body, 'hello');
+      done();
+    }));
+  }));
+
+  // Latin-1 values take the string path and must still work.
+  http.get({ port, headers: { 'X-Latin': 'café' } },
+           common.mustCall((res) => {
+             res.resume();
+             res.on('end', common.mustCall(done));
+           }));
+}));
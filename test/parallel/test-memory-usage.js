@@ -44,3 +44,20 @@ if (r.arrayBuffers > 0) {
   assert.strictEqual(after.arrayBuffers - r.arrayBuffers, size,
                      `${after.arrayBuffers} - ${r.arrayBuffers} === ${size}`);
 }
+
+// Allocations are not served from the pool while recording or replaying.
+if (!process.isRecordingOrReplaying()) {
+  const { arrayBufferPool } = process.memoryUsage();
+  assert.strictEqual(typeof arrayBufferPool.cached, 'number');
+  assert.strictEqual(typeof arrayBufferPool.hits, 'number');
+  assert.strictEqual(typeof arrayBufferPool.misses, 'number');
+
+  // Only sizes in the range of the size classes go through the pool. Other
+  // allocations, e.g. from other threads, may be counted as well.
+  // eslint-disable-next-line no-unused-vars
+  const buffers = [1, 16 * 1024, 100 * 1024, 1024 * 1024, 1024 * 1024 + 1]
+    .map((size) => Buffer.allocUnsafeSlow(size));
+  const after = process.memoryUsage().arrayBufferPool;
+  assert(after.hits + after.misses >=
+         arrayBufferPool.hits + arrayBufferPool.misses + 3);
+}
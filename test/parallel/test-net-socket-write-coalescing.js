@@ -0,0 +1,44 @@
+'use strict';
+
+const common = require('../common');
+
+// Writes on a socket with write coalescing enabled must arrive complete and
+// in order, and every write callback must still be called.
+
+const assert = require('assert');
+const net = require('net');
+
+const count = 1000;
+const expected = [];
+for (let i = 0; i < count; i++)
+  expected.push(`message ${i}\n`);
+
+const server = net.createServer(common.mustCall((socket) => {
+  assert.strictEqual(socket.setWriteCoalescing(), socket);
+
+  let completed = 0;
+  for (let i = 0; i < count; i++) {
+    const chunk = i % 2 ? expected[i] : Buffer.from(expected[i]);
+    socket.write(chunk, common.mustSucceed(() => {
+      assert.strictEqual(completed++, i);
+    }));
+  }
+
+  // Turning coalescing off must not let new writes overtake held back ones.
+  socket.setWriteCoalescing(false);
+  socket.end('end\n');
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port);
+  // Setting the mode before the connection exists must not throw.
+  client.setWriteCoalescing(true);
+  client.setEncoding('utf8');
+
+  let received = '';
+  client.on('data', (data) => received += data);
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(received, expected.join('') + 'end\n');
+    server.close();
+  }));
+}));
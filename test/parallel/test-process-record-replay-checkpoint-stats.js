@@ -0,0 +1,79 @@
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+const stats = process.recordReplayCheckpointStats();
+for (const key of ['minProgress', 'minIntervalMs', 'candidates', 'created',
+                   'progress']) {
+  assert(Number.isInteger(stats[key]) && stats[key] >= 0, key);
+}
+assert(stats.created <= stats.candidates);
+if (!process.isRecordingOrReplaying()) {
+  assert.strictEqual(stats.candidates, 0);
+  assert.strictEqual(stats.created, 0);
+  assert.strictEqual(stats.progress, 0);
+}
+
+function childStats(args, env) {
+  const child = spawnSync(process.execPath, [
+    ...args,
+    '-p',
+    'JSON.stringify(process.recordReplayCheckpointStats())',
+  ], {
+    env: {
+      ...process.env,
+      RECORD_REPLAY_CHECKPOINT_PROGRESS: '',
+      RECORD_REPLAY_CHECKPOINT_INTERVAL_MS: '',
+      ...env,
+    },
+    encoding: 'utf8',
+  });
+  assert.strictEqual(child.status, 0, child.stderr);
+  return JSON.parse(child.stdout);
+}
+
+// The policy is configured from the command line.
+{
+  const { minProgress, minIntervalMs } = childStats([
+    '--record-replay-checkpoint-progress=1000',
+    '--record-replay-checkpoint-interval=50',
+  ]);
+  assert.strictEqual(minProgress, 1000);
+  assert.strictEqual(minIntervalMs, 50);
+}
+
+// Or from NODE_OPTIONS.
+{
+  const { minProgress, minIntervalMs } = childStats([], {
+    NODE_OPTIONS: '--record-replay-checkpoint-interval=20',
+  });
+  assert.strictEqual(minProgress, 0);
+  assert.strictEqual(minIntervalMs, 20);
+}
+
+// The environment variables are used unless the options are given.
+{
+  const env = {
+    RECORD_REPLAY_CHECKPOINT_PROGRESS: '500',
+    RECORD_REPLAY_CHECKPOINT_INTERVAL_MS: '30',
+  };
+  let { minProgress, minIntervalMs } = childStats([], env);
+  assert.strictEqual(minProgress, 500);
+  assert.strictEqual(minIntervalMs, 30);
+
+  ({ minProgress, minIntervalMs } = childStats([
+    '--record-replay-checkpoint-progress=0',
+  ], env));
+  assert.strictEqual(minProgress, 0);
+  assert.strictEqual(minIntervalMs, 30);
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--record-replay-checkpoint-progress=-5', '-e', '',
+  ], { encoding: 'utf8' });
+  assert.notStrictEqual(child.status, 0);
+  assert.match(child.stderr, /checkpoint options must not be negative/);
+}
@@ -0,0 +1,56 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+
+function checkQueue(queue) {
+  for (const key of ['queued', 'running', 'completed', 'waitTime', 'runTime'])
+    assert(Number.isInteger(queue[key]) && queue[key] >= 0, key);
+}
+
+if (process.argv[2] === 'child') {
+  // Occupy the single initial thread so that the pool has to grow.
+  const jobs = 4;
+  let done = 0;
+  for (let i = 0; i < jobs; i++) {
+    require('crypto').pbkdf2('secret', 'salt', 2e5, 64, 'sha512',
+                             common.mustSucceed(() => {
+                               if (++done === jobs)
+                                 console.log(JSON.stringify(usage));
+                             }));
+  }
+  const usage = process.threadpoolUsage();
+  return;
+}
+
+const usage = process.threadpoolUsage();
+assert(usage.threads >= usage.minThreads);
+assert(usage.threads <= usage.maxThreads);
+assert(usage.idleThreads <= usage.threads);
+checkQueue(usage.cpu);
+checkQueue(usage.fastIO);
+checkQueue(usage.slowIO);
+
+// Unlike fs.stat(), fs.readdir() is never submitted through io_uring, so it
+// always runs in the threadpool.
+fs.readdir(__dirname, common.mustSucceed(() => {
+  const after = process.threadpoolUsage();
+  assert(after.fastIO.completed > usage.fastIO.completed);
+}));
+
+const child = spawnSync(process.execPath, [__filename, 'child'], {
+  env: {
+    ...process.env,
+    UV_THREADPOOL_SIZE: '1',
+    UV_THREADPOOL_MAX_SIZE: '4',
+  },
+  encoding: 'utf8',
+});
+assert.strictEqual(child.status, 0, child.stderr);
+const childUsage = JSON.parse(child.stdout);
+assert.strictEqual(childUsage.minThreads, 1);
+assert.strictEqual(childUsage.maxThreads, 4);
+assert.strictEqual(childUsage.threads, 4);
+assert.strictEqual(childUsage.cpu.running + childUsage.cpu.queued, 4);
@@ -173,6 +173,39 @@ assert.strictEqual(decoder.write(Buffer.from('f4', 'hex')), '');
 assert.strictEqual(decoder.write(Buffer.from('bde5', 'hex')), '\ufffd\ufffd');
 assert.strictEqual(decoder.end(), '\ufffd');
 
+// A character finished by the next chunk is decoded along with that chunk,
+// or on its own if the chunk is large. Either way, invalid and truncated
+// characters must give the same replacement characters as in one piece.
+for (const body of ['A', 'A'.repeat(2000)]) {
+  for (const [prefix, suffix, expected] of [
+    ['E2', '82AC', '\u20ac'],
+    ['E2', '82', '\ufffd'],
+    ['E282', '', '\ufffd'],
+    ['F0', '9F', '\ufffd'],
+    ['EDA0', '80', '\ufffd\ufffd\ufffd'],
+    ['C0', '80', '\ufffd\ufffd'],
+    ['F4', '90', '\ufffd\ufffd'],
+  ]) {
+    const input = Buffer.from(prefix + suffix, 'hex');
+    const expectedOutput = expected + body;
+    assert.strictEqual(Buffer.concat([input, Buffer.from(body)]).toString(),
+                       expectedOutput);
+    decoder = new StringDecoder('utf8');
+    let output = decoder.write(Buffer.from(prefix, 'hex'));
+    output += decoder.write(Buffer.from(suffix + Buffer.from(body)
+      .toString('hex'), 'hex'));
+    output += decoder.end();
+    assert.strictEqual(output, expectedOutput);
+  }
+}
+
+decoder = new StringDecoder('utf16le');
+assert.strictEqual(decoder.write(Buffer.from('3DD84D', 'hex')), '\ud83d');
+assert.strictEqual(
+  decoder.write(Buffer.from('DC' + '4100'.repeat(1000), 'hex')),
+  '\udc4d' + 'A'.repeat(1000));
+assert.strictEqual(decoder.end(), '');
+
 assert.throws(
   () => new StringDecoder(1),
   {
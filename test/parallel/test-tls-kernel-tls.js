@@ -0,0 +1,82 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Connections that ask for kernel TLS must carry data unchanged in both
+// directions, and fall back to OpenSSL for protocols and ciphers the kernel
+// cannot take over.
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const pem = (n) => fixtures.readKey(`${n}.pem`);
+
+assert.throws(() => tls.connect({ port: 0, kernelTLS: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+const payload = Buffer.alloc(1024 * 1024);
+for (let i = 0; i < payload.length; i++)
+  payload[i] = i % 251;
+
+// `active` is whether both sides must have switched to kernel TLS. The first
+// config tells whether the kernel supports it at all; which of the other
+// AEAD ciphers it supports depends on its version.
+const configs = [
+  { maxVersion: 'TLSv1.2', ciphers: 'ECDHE-RSA-AES128-GCM-SHA256',
+    active: true },
+  { maxVersion: 'TLSv1.2', ciphers: 'ECDHE-RSA-AES256-GCM-SHA384' },
+  { maxVersion: 'TLSv1.2', ciphers: 'ECDHE-RSA-CHACHA20-POLY1305' },
+  { maxVersion: 'TLSv1.2', ciphers: 'ECDHE-RSA-AES128-SHA256',
+    active: false },
+  { maxVersion: 'TLSv1.3', active: false },
+];
+
+function test({ active, ...config }, cb) {
+  let serverActive;
+  const server = tls.createServer({
+    key: pem('agent1-key'),
+    cert: pem('agent1-cert'),
+    kernelTLS: true,
+    ...config,
+  }, common.mustCall((socket) => {
+    // Echo everything back and half-close after the client did.
+    socket.pipe(socket);
+    socket.on('end', common.mustCall(() => {
+      serverActive = socket.isKernelTLSActive();
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+      kernelTLS: true,
+      ...config,
+    }, common.mustCall(() => {
+      client.end(payload);
+    }));
+
+    const chunks = [];
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), payload);
+      const clientActive = client.isKernelTLSActive();
+      if (active === true && !clientActive && !serverActive)
+        common.skip('kernel TLS is not supported');
+      if (active !== undefined) {
+        assert.strictEqual(clientActive, active);
+        assert.strictEqual(serverActive, active);
+      }
+      server.close(cb);
+    }));
+  }));
+}
+
+(function next(i) {
+  if (i < configs.length)
+    test(configs[i], () => next(i + 1));
+})(0);
@@ -0,0 +1,156 @@
+'use strict';
+// Tests compression with the `parallelism` option, which cuts the input into
+// blocks and compresses them on several threads.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// Several blocks of 128 KiB, plus a partial one, of text with some noise.
+function makeInput(len) {
+  const words = ['alpha ', 'beta ', 'gamma ', 'delta\n', '<p>', '</p>'];
+  const buf = Buffer.alloc(len);
+  let offset = 0;
+  let seed = 42;
+  while (offset < len) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    if (seed % 11 === 0)
+      buf[offset++] = seed & 0xff;
+    else
+      offset += buf.write(words[seed % words.length], offset);
+  }
+  return buf;
+}
+
+const input = makeInput(700 * 1024 + 123);
+
+const formats = [
+  ['gzip', 'gunzip'],
+  ['deflate', 'inflate'],
+  ['deflateRaw', 'inflateRaw'],
+];
+
+for (const [compress, decompress] of formats) {
+  const compressed = zlib[`${compress}Sync`](input, { parallelism: 4 });
+  assert.deepStrictEqual(zlib[`${decompress}Sync`](compressed), input);
+
+  // The output only depends on where the input is cut.
+  assert.deepStrictEqual(
+    zlib[`${compress}Sync`](input, { parallelism: 2 }), compressed);
+
+  zlib[compress](input, { parallelism: 4 }, common.mustSucceed((result) => {
+    assert.deepStrictEqual(result, compressed);
+  }));
+
+  // Small output chunks and levels other than the default.
+  for (const level of [0, 1, 9]) {
+    const result = zlib[`${compress}Sync`](input, {
+      parallelism: 3, level, chunkSize: 1024
+    });
+    assert.deepStrictEqual(zlib[`${decompress}Sync`](result), input);
+  }
+
+  assert.deepStrictEqual(
+    zlib[`${decompress}Sync`](
+      zlib[`${compress}Sync`](Buffer.alloc(0), { parallelism: 4 })),
+    Buffer.alloc(0));
+}
+
+{
+  // An input that ends with a full batch of blocks still ends the same way
+  // for any number of threads, whether the end comes with the last data or
+  // after it.
+  const input = makeInput(512 * 1024);
+  for (const [compress, decompress] of formats) {
+    const compressed = zlib[`${compress}Sync`](input, { parallelism: 2 });
+    assert.deepStrictEqual(zlib[`${decompress}Sync`](compressed), input);
+    assert.deepStrictEqual(
+      zlib[`${compress}Sync`](input, { parallelism: 4 }), compressed);
+
+    for (const parallelism of [2, 4]) {
+      const stream = zlib[`create${compress[0].toUpperCase()}` +
+                          compress.slice(1)]({ parallelism });
+      const chunks = [];
+      stream.on('data', (chunk) => chunks.push(chunk));
+      stream.on('end', common.mustCall(() => {
+        assert.deepStrictEqual(Buffer.concat(chunks), compressed);
+      }));
+      stream.write(input);
+      setImmediate(() => stream.end());
+    }
+  }
+}
+
+{
+  // The header is the one zlib writes itself.
+  const parallel = zlib.gzipSync(input, { parallelism: 4 });
+  const serial = zlib.gzipSync(input);
+  assert.deepStrictEqual(parallel.slice(0, 10), serial.slice(0, 10));
+  assert.deepStrictEqual(parallel.slice(-8), serial.slice(-8));
+  assert.deepStrictEqual(
+    zlib.deflateSync(input, { parallelism: 4 }).slice(0, 2),
+    zlib.deflateSync(input).slice(0, 2));
+}
+
+{
+  // Preset dictionaries prime the first block.
+  const dictionary = input.slice(0, 1000);
+  for (const [compress, decompress] of formats.slice(1)) {
+    const compressed = zlib[`${compress}Sync`](input, {
+      parallelism: 4, dictionary
+    });
+    assert.deepStrictEqual(
+      zlib[`${decompress}Sync`](compressed, { dictionary }), input);
+  }
+}
+
+{
+  // Streaming with small writes and a flush in the middle.
+  const gzip = zlib.createGzip({ parallelism: 4 });
+  const half = input.length >> 1;
+  for (let i = 0; i < half; i += 10000)
+    gzip.write(input.slice(i, Math.min(i + 10000, half)));
+  gzip.flush(common.mustCall(() => {
+    const chunks = [];
+    let chunk;
+    while ((chunk = gzip.read()) !== null)
+      chunks.push(chunk);
+
+    // Everything written so far can be decompressed.
+    const flushed = zlib.inflateRawSync(Buffer.concat(chunks).slice(10), {
+      finishFlush: zlib.constants.Z_SYNC_FLUSH
+    });
+    assert.deepStrictEqual(flushed, input.slice(0, half));
+
+    gzip.on('data', (chunk) => chunks.push(chunk));
+    gzip.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(zlib.gunzipSync(Buffer.concat(chunks)), input);
+    }));
+    gzip.end(input.slice(half));
+  }));
+}
+
+{
+  const input = makeInput(2.5 * 1024 * 1024);
+  const params = { [zlib.constants.BROTLI_PARAM_QUALITY]: 4 };
+  const compressed = zlib.brotliCompressSync(input, {
+    parallelism: 3, params
+  });
+  assert.deepStrictEqual(zlib.brotliDecompressSync(compressed), input);
+
+  zlib.brotliCompress(input, { parallelism: 3, params },
+                      common.mustSucceed((result) => {
+                        assert.deepStrictEqual(result, compressed);
+                        assert.deepStrictEqual(
+                          zlib.brotliDecompressSync(result), input);
+                      }));
+}
+
+for (const parallelism of [0, -1, 1025, Infinity]) {
+  assert.throws(() => zlib.gzipSync(input, { parallelism }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+assert.throws(() => zlib.createBrotliCompress({ parallelism: '4' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
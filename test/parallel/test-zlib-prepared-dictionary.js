@@ -0,0 +1,109 @@
+'use strict';
+// Tests dictionaries from zlib.prepareDictionary(), which produce the same
+// output as the plain dictionary they were prepared from.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const plain = Buffer.from('{"id":,"name":"","email":"","tags":[""]}');
+const dictionary = zlib.prepareDictionary(plain);
+
+const input = Buffer.from(
+  '{"id":1,"name":"Ada","email":"ada@example.com","tags":["admin"]}');
+
+for (const [compress, decompress] of [
+  ['deflateSync', 'inflateSync'],
+  ['deflateRawSync', 'inflateRawSync'],
+]) {
+  // More sets of parameters than the prepared state is kept for.
+  for (const level of [1, 6, 9]) {
+    for (const windowBits of [9, 15]) {
+      const options = { level, windowBits };
+      const expected = zlib[compress](input, { ...options, dictionary: plain });
+      for (let i = 0; i < 2; i++) {
+        const compressed = zlib[compress](input, { ...options, dictionary });
+        assert.deepStrictEqual(compressed, expected);
+        assert.deepStrictEqual(
+          zlib[decompress](compressed, { dictionary }), input);
+        assert.deepStrictEqual(
+          zlib[decompress](compressed, { dictionary: plain }), input);
+      }
+    }
+  }
+}
+
+// Unzip picks up the dictionary from the zlib header.
+assert.deepStrictEqual(
+  zlib.unzipSync(zlib.deflateSync(input, { dictionary }), { dictionary }),
+  input);
+
+// gzip does not support dictionaries, and ignores them.
+assert.deepStrictEqual(zlib.gzipSync(input, { dictionary }),
+                       zlib.gzipSync(input));
+
+zlib.deflate(input, { dictionary }, common.mustSucceed((compressed) => {
+  zlib.inflate(compressed, { dictionary }, common.mustSucceed((result) => {
+    assert.deepStrictEqual(result, input);
+  }));
+}));
+
+{
+  // reset() starts over from the prepared state.
+  const deflate = zlib.createDeflate({ dictionary });
+  deflate.write(input.slice(0, 10));
+  deflate.flush(common.mustCall(() => {
+    // Discard the output so far.
+    deflate.read();
+    deflate.reset();
+
+    const chunks = [];
+    deflate.on('data', (chunk) => chunks.push(chunk));
+    deflate.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks),
+                             zlib.deflateSync(input, { dictionary: plain }));
+    }));
+    deflate.end(input);
+  }));
+}
+
+for (const dict of [dictionary, plain]) {
+  // reset() keeps the parameters from params(), with either kind of
+  // dictionary.
+  const deflate = zlib.createDeflate({ level: 1, dictionary: dict });
+  deflate.params(9, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+    // Discard the output so far.
+    deflate.read();
+    deflate.reset();
+
+    const chunks = [];
+    deflate.on('data', (chunk) => chunks.push(chunk));
+    deflate.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(
+        Buffer.concat(chunks),
+        zlib.deflateSync(input, { level: 9, dictionary: plain }));
+    }));
+    deflate.end(input);
+  }));
+}
+
+{
+  const compressed = zlib.deflateSync(input, { dictionary });
+  assert.throws(() => zlib.inflateSync(compressed), {
+    code: 'Z_NEED_DICT'
+  });
+}
+
+for (const value of ['dictionary', 42, null, {}]) {
+  assert.throws(() => zlib.prepareDictionary(value), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
+
+{
+  // Inheriting from a prepared dictionary does not make one.
+  const fake = Object.create(Object.getPrototypeOf(dictionary));
+  assert.throws(() => zlib.deflateSync(input, { dictionary: fake }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
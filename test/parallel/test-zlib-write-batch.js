@@ -0,0 +1,98 @@
+'use strict';
+// Tests that chunks queued while a write is in progress are processed as one
+// batch, with the same results as writing them one at a time.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+function countBatches(stream) {
+  const handle = stream._handle;
+  const writeBatch = handle.writeBatch;
+  const counts = { batches: 0 };
+  handle.writeBatch = function(...args) {
+    counts.batches++;
+    return writeBatch.apply(this, args);
+  };
+  return counts;
+}
+
+function writeInPieces(stream, data, size) {
+  for (let i = 0; i < data.length; i += size)
+    stream.write(data.slice(i, i + size));
+  stream.end();
+}
+
+function collect(stream, callback) {
+  const chunks = [];
+  stream.on('data', (chunk) => {
+    assert(chunk.length <= stream._chunkSize);
+    chunks.push(chunk);
+  });
+  stream.on('end', common.mustCall(() => callback(Buffer.concat(chunks))));
+}
+
+const text = Buffer.from('a test of writing in batches\n'.repeat(1e4));
+
+for (const [compress, decompress] of [
+  ['createGzip', 'createGunzip'],
+  ['createDeflate', 'createInflate'],
+  ['createDeflateRaw', 'createInflateRaw'],
+  ['createBrotliCompress', 'createBrotliDecompress'],
+]) {
+  const compressor = zlib[compress]();
+  const compressorCounts = countBatches(compressor);
+  collect(compressor, common.mustCall((compressed) => {
+    assert(compressorCounts.batches > 0);
+    assert.strictEqual(compressor.bytesWritten, text.length);
+
+    const decompressor = zlib[decompress]();
+    const decompressorCounts = countBatches(decompressor);
+    collect(decompressor, common.mustCall((result) => {
+      assert(decompressorCounts.batches > 0);
+      assert.strictEqual(decompressor.bytesWritten, compressed.length);
+      assert.deepStrictEqual(result, text);
+    }));
+    writeInPieces(decompressor, compressed, 100);
+  }));
+  writeInPieces(compressor, text, 1000);
+}
+
+{
+  // Highly compressed input produces more output than a single batch holds.
+  const zeros = Buffer.alloc(8 * 1024 * 1024);
+  const compressed = zlib.gzipSync(zeros);
+  const gunzip = zlib.createGunzip({ chunkSize: 64 * 1024 });
+  const counts = countBatches(gunzip);
+  collect(gunzip, common.mustCall((result) => {
+    assert(counts.batches > 1);
+    assert.strictEqual(result.length, zeros.length);
+    assert(result.equals(zeros));
+  }));
+  writeInPieces(gunzip, compressed, 16);
+}
+
+{
+  // Data after the end of the compressed stream is ignored.
+  const compressed = Buffer.concat([
+    zlib.deflateSync(text),
+    Buffer.from('trailing garbage'),
+  ]);
+  const inflate = zlib.createInflate();
+  collect(inflate, common.mustCall((result) => {
+    assert.deepStrictEqual(result, text);
+  }));
+  writeInPieces(inflate, compressed, 64);
+}
+
+{
+  // Errors in the middle of a batch are reported.
+  const compressed = zlib.gzipSync(text);
+  compressed[compressed.length >> 1] ^= 0xff;
+  const gunzip = zlib.createGunzip();
+  gunzip.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'Z_DATA_ERROR');
+  }));
+  gunzip.resume();
+  writeInPieces(gunzip, compressed, 50);
+}